@@ -27,24 +27,58 @@
 
 const char *gengetopt_args_info_purpose = "Merge multiple clusterings (resolution/hierarchy levels) outputting only the\nunique clusters with the optional their filtering by the size and nodes\nfiltering by the specified base.";
 
-const char *gengetopt_args_info_usage = "Usage: resmerge [OPTIONS] clusterings...\n\n  clusterings...  - clusterings specified by the given files and directories\n(non-recursive traversing)";
+const char *gengetopt_args_info_usage = "Usage: resmerge [OPTIONS] clusterings...\n\n  clusterings...  - clusterings specified by the given files, directories\n(non-recursive traversing) and tar archives (.tar[.gz|.bz2|.xz|.zst]), which\nare streamed without the extraction";
 
 const char *gengetopt_args_info_versiontext = "";
 
 const char *gengetopt_args_info_description = "";
 
 const char *gengetopt_args_info_help[] = {
-  "  -h, --help              Print help and exit",
-  "  -V, --version           Print version and exit",
-  "  -o, --output=STRING     output file name. If a single directory <dirname> is\n                            specified then the default output file name is\n                            <dirname>.cnl.\n                            NOTE: the number of nodes is written to the output\n                            file only if the node base synchronization is\n                            applied, otherwise 0 is set\n                            (default=`clusters.cnl')",
-  "  -r, --rewrite           rewrite already existing resulting file or skip the\n                            processing  (default=off)",
-  "  -b, --btm-size=LONG     bottom margin of the cluster size to process\n                            (default=`0')",
-  "  -t, --top-size=LONG     top margin of the cluster size to process\n                            (default=`0')",
-  "  -m, --membership=FLOAT  average expected membership of the nodes in the\n                            clusters, > 0, typically >= 1  (default=`1')",
+  "  -h, --help                     Print help and exit",
+  "  -V, --version                  Print version and exit",
+  "  -o, --output=STRING            output file name. If a single directory or\n                                   archive <dirname> is specified then the\n                                   default output file name is  <dirname>.cnl.\n                                   NOTE: the number of nodes is written to the\n                                   output file only if the node base\n                                   synchronization is applied, otherwise 0 is\n                                   set  (default=`clusters.cnl')",
+  "  -r, --rewrite                  rewrite already existing resulting file or\n                                   skip the processing  (default=off)",
+  "  -b, --btm-size=LONG            bottom margin of the cluster size to process\n                                   (default=`0')",
+  "  -t, --top-size=LONG            top margin of the cluster size to process\n                                   (default=`0')",
+  "  -m, --membership=FLOAT         average expected membership of the nodes in\n                                   the clusters, > 0, typically >= 1\n                                   (default=`1')",
+  "  -j, --threads=LONG             the number of worker threads for the parallel\n                                   processing, 0 means the number of CPUs\n                                   (default=`0')",
+  "  -c, --cache=STRING             cache directory of the results to reuse them\n                                   on the repeated processing of the same\n                                   inputs with the same options. The results\n                                   are reflinked, hardlinked or copied from the\n                                   cache, so they should not be modified in\n                                   place",
+  "  -l, --cache-limit=LONG         max size of the cache in MB, the least\n                                   recently used results are evicted, 0 means\n                                   unlimited  (default=`4096')",
+  "  -C, --cache-content            include CRC32C checksums of the inputs content\n                                   into the cache key in addition to their\n                                   paths, sizes and modification times\n                                   (default=off)",
+  "  -x, --index=STRING             output the fingerprint index of the merged\n                                   clusters to the specified file to lookup the\n                                   clusters without touching the CNL (see\n                                   --lookup). The caching is not applied in\n                                   this case",
+  "  -p, --postings=STRING          output the posting (node -> clusters) index of\n                                   the merged clusters to the specified file to\n                                   find the best matches of the clusters (see\n                                   --match). The caching is not applied in this\n                                   case",
+  "  -a, --arrow=STRING             output the merged clusters also to the\n                                   specified Apache Arrow IPC (Feather v2) file\n                                   having the members column (list<uint32>) to\n                                   load them by the analytics tools without\n                                   parsing. The caching is not applied in this\n                                   case",
+  "  -A, --arrow-meta               output also the id (0-based position), source\n                                   (input file) and size columns of the\n                                   clusters to the Arrow IPC file\n                                   (default=off)",
+  "  -d, --delta=STRING             output also the hierarchical delta of the\n                                   merged clusters to the specified CNL file,\n                                   where each level (input) lists only its new\n                                   clusters and the references to the clusters\n                                   stored at the preceding levels by their\n                                   0-based ordinals. Not applicable with the\n                                   min support > 1. The caching is not applied\n                                   in this case",
+  "  -u, --min-support=LONG         min number of the inputs (files or archive\n                                   entries) containing the cluster to output\n                                   it, >= 1. The clusters recurring in fewer\n                                   inputs are dropped  (default=`1')",
+  "  -U, --dedup-members            remove the repeated members of each cluster\n                                   retaining their first occurrences, so the\n                                   cluster is deduplicated with its clean\n                                   twins. The clean clusters are only verified\n                                   (default=off)",
+  "  -g, --mem-stats                output the memory consumption per subsystem\n                                   (live and peak bytes, the number of\n                                   allocations) to the stderr on completion.\n                                   The report is output also on SIGUSR1 during\n                                   the processing  (default=off)",
+  "  -L, --labels                   the members are arbitrary string labels (e.g.\n                                   URLs) rather than the numeric ids, which are\n                                   interned into the dense ids and written back\n                                   on the output. Each member token is a label\n                                   as a whole (shares are not separated).\n                                   Applicable to the merging, synchronization\n                                   and node base extraction without the indices\n                                   and the Arrow output  (default=off)",
+  "  -T, --trace-out=STRING         record the timeline of the processing stages\n                                   (opening, header parsing, parsing of the\n                                   files and chunks, output flushes) per thread\n                                   and save it on completion to the specified\n                                   file in the Chrome trace-event format\n                                   viewable in Perfetto (ui.perfetto.dev) or\n                                   chrome://tracing",
   "\n Mode: sync\n  Synchronize the node base of the merged clustering",
-  "  -s, --sync-base=STRING  synchronize node base with the specified collection",
+  "  -s, --sync-base=STRING         synchronize node base with the specified\n                                   collection",
+  "  -n, --net-base                 the node base is specified by the network\n                                   (edge/arc list, the weights are omitted)\n                                   rather than by the collection, which is the\n                                   default for the .nse/.nsa/.ncol files\n                                   (default=off)",
+  "  -v, --min-base-coverage=FLOAT  min ratio of the cluster members present in\n                                   the node base to retain the cluster, [0, 1].\n                                   The clusters having lower coverage are\n                                   dropped  (default=`0')",
+  "  -i, --intact                   retain the covered clusters intact (including\n                                   the non-base members) instead of trimming\n                                   them to the node base  (default=off)",
+  "\n Mode: lookup\n  Lookup the query clusters in the merged clustering by its fingerprint index",
+  "  -q, --lookup=STRING            lookup the query clusterings in the merged\n                                   clustering by the specified fingerprint\n                                   index (see --index) outputting <file>:<line>\n                                   <position> <offset> tab-separated per query\n                                   cluster, where the position is a 0-based\n                                   index of the cluster and the offset is the\n                                   byte offset of its line in the merged\n                                   clustering, or '-' if the cluster is absent.\n                                   The default output file name has .lkp\n                                   extension",
+  "\n Mode: match\n  Find the best matches of the query clusters in the merged clustering by its posting index",
+  "  -M, --match=STRING             find the best matches of the query clusterings\n                                   in the merged clustering by the specified\n                                   posting index (see --postings) outputting\n                                   <file>:<line> followed by the tab-separated\n                                   <position> <offset> <score> of the matches\n                                   per query cluster, where the position is a\n                                   0-based index of the cluster and the offset\n                                   is the byte offset of its line in the merged\n                                   clustering. The default output file name has\n                                   .mch extension",
+  "  -k, --top-matches=LONG         the number of top matches of each query\n                                   cluster  (default=`1')",
+  "  -F, --f1                       score the matches by F1 instead of the Jaccard\n                                   index  (default=off)",
+  "\n Mode: check\n  Validate the CNL files without the merging",
+  "  -K, --check                    validate the input clusterings reporting the\n                                   issues as <file>:<line>:<column>: <issue>\n                                   (invalid node ids and shares, ids overflow,\n                                   empty clusters, header values and counts\n                                   mismatching the content) to the stdout. No\n                                   output file is created, the exit code is\n                                   non-zero if any issue is found\n                                   (default=off)",
+  "\n Mode: annotate\n  Annotate the CNL files by the exact header",
+  "  -H, --annotate                 write the header with the exact numbers of\n                                   clusters and unique nodes into the input\n                                   clusterings (replacing the existing header\n                                   if any), so their subsequent loading\n                                   preallocates the containers exactly. The\n                                   files are replaced atomically, the archives\n                                   are skipped  (default=off)",
+  "\n Mode: info\n  Inspect the CNL files",
+  "  -I, --info                     output the table of the numbers of clusters,\n                                   members, min and max cluster sizes and the\n                                   number of nodes specified in the header of\n                                   each input clustering followed by the totals\n                                   to the stdout. The files are scanned in\n                                   parallel without the parsing of the members\n                                   (default=off)",
+  "\n Mode: profile\n  Profile the workload shape of the CNL files",
+  "  -P, --profile-shape            output the anonymized statistical profile of\n                                   the input clusterings without the node ids:\n                                   the distribution of the cluster sizes by\n                                   log2 bins, the range and density of the node\n                                   ids, the membership (overlap) of the nodes\n                                   per level (input), the number of the\n                                   clusters duplicated in the preceding inputs\n                                   and the line format of each input. The\n                                   default output file name has .shp extension\n                                   (default=off)",
+  "\n Mode: generate\n  Generate the synthetic CNL files by the shape profile",
+  "  -G, --generate                 generate the synthetic clusterings\n                                   statistically similar to the profiled ones\n                                   (see --profile-shape) by the input shape\n                                   profile into the output directory, a file\n                                   per profiled input. The default output\n                                   directory is named after the profile\n                                   (default=off)",
+  "  -S, --seed=LONG                seed of the random generator, the same profile\n                                   and seed yield the same clusterings\n                                   (default=`0')",
   "\n Mode: exrtact\n  Extract the node base from the specified clustering(s)",
-  "  -e, --extract-base      extract the node base from the clusterings instead of\n                            merging the clusterings  (default=off)",
+  "  -e, --extract-base             extract the node base from the clusterings\n                                   instead of merging the clusterings\n                                   (default=off)",
     0
 };
 
@@ -78,9 +112,43 @@ void clear_given (struct gengetopt_args_info *args_info)
   args_info->btm_size_given = 0 ;
   args_info->top_size_given = 0 ;
   args_info->membership_given = 0 ;
+  args_info->threads_given = 0 ;
+  args_info->cache_given = 0 ;
+  args_info->cache_limit_given = 0 ;
+  args_info->cache_content_given = 0 ;
+  args_info->index_given = 0 ;
+  args_info->postings_given = 0 ;
+  args_info->arrow_given = 0 ;
+  args_info->arrow_meta_given = 0 ;
+  args_info->delta_given = 0 ;
+  args_info->min_support_given = 0 ;
+  args_info->dedup_members_given = 0 ;
+  args_info->mem_stats_given = 0 ;
+  args_info->labels_given = 0 ;
+  args_info->trace_out_given = 0 ;
   args_info->sync_base_given = 0 ;
+  args_info->net_base_given = 0 ;
+  args_info->min_base_coverage_given = 0 ;
+  args_info->intact_given = 0 ;
+  args_info->lookup_given = 0 ;
+  args_info->match_given = 0 ;
+  args_info->top_matches_given = 0 ;
+  args_info->f1_given = 0 ;
+  args_info->check_given = 0 ;
+  args_info->annotate_given = 0 ;
+  args_info->info_given = 0 ;
+  args_info->profile_shape_given = 0 ;
+  args_info->generate_given = 0 ;
+  args_info->seed_given = 0 ;
   args_info->extract_base_given = 0 ;
+  args_info->annotate_mode_counter = 0 ;
+  args_info->check_mode_counter = 0 ;
   args_info->exrtact_mode_counter = 0 ;
+  args_info->generate_mode_counter = 0 ;
+  args_info->info_mode_counter = 0 ;
+  args_info->lookup_mode_counter = 0 ;
+  args_info->match_mode_counter = 0 ;
+  args_info->profile_mode_counter = 0 ;
   args_info->sync_mode_counter = 0 ;
 }
 
@@ -97,8 +165,49 @@ void clear_args (struct gengetopt_args_info *args_info)
   args_info->top_size_orig = NULL;
   args_info->membership_arg = 1;
   args_info->membership_orig = NULL;
+  args_info->threads_arg = 0;
+  args_info->threads_orig = NULL;
+  args_info->cache_arg = NULL;
+  args_info->cache_orig = NULL;
+  args_info->cache_limit_arg = 4096;
+  args_info->cache_limit_orig = NULL;
+  args_info->cache_content_flag = 0;
+  args_info->index_arg = NULL;
+  args_info->index_orig = NULL;
+  args_info->postings_arg = NULL;
+  args_info->postings_orig = NULL;
+  args_info->arrow_arg = NULL;
+  args_info->arrow_orig = NULL;
+  args_info->arrow_meta_flag = 0;
+  args_info->delta_arg = NULL;
+  args_info->delta_orig = NULL;
+  args_info->min_support_arg = 1;
+  args_info->min_support_orig = NULL;
+  args_info->dedup_members_flag = 0;
+  args_info->mem_stats_flag = 0;
+  args_info->labels_flag = 0;
+  args_info->trace_out_arg = NULL;
+  args_info->trace_out_orig = NULL;
   args_info->sync_base_arg = NULL;
   args_info->sync_base_orig = NULL;
+  args_info->net_base_flag = 0;
+  args_info->min_base_coverage_arg = 0;
+  args_info->min_base_coverage_orig = NULL;
+  args_info->intact_flag = 0;
+  args_info->lookup_arg = NULL;
+  args_info->lookup_orig = NULL;
+  args_info->match_arg = NULL;
+  args_info->match_orig = NULL;
+  args_info->top_matches_arg = 1;
+  args_info->top_matches_orig = NULL;
+  args_info->f1_flag = 0;
+  args_info->check_flag = 0;
+  args_info->annotate_flag = 0;
+  args_info->info_flag = 0;
+  args_info->profile_shape_flag = 0;
+  args_info->generate_flag = 0;
+  args_info->seed_arg = 0;
+  args_info->seed_orig = NULL;
   args_info->extract_base_flag = 0;
   
 }
@@ -115,8 +224,35 @@ void init_args_info(struct gengetopt_args_info *args_info)
   args_info->btm_size_help = gengetopt_args_info_help[4] ;
   args_info->top_size_help = gengetopt_args_info_help[5] ;
   args_info->membership_help = gengetopt_args_info_help[6] ;
-  args_info->sync_base_help = gengetopt_args_info_help[8] ;
-  args_info->extract_base_help = gengetopt_args_info_help[10] ;
+  args_info->threads_help = gengetopt_args_info_help[7] ;
+  args_info->cache_help = gengetopt_args_info_help[8] ;
+  args_info->cache_limit_help = gengetopt_args_info_help[9] ;
+  args_info->cache_content_help = gengetopt_args_info_help[10] ;
+  args_info->index_help = gengetopt_args_info_help[11] ;
+  args_info->postings_help = gengetopt_args_info_help[12] ;
+  args_info->arrow_help = gengetopt_args_info_help[13] ;
+  args_info->arrow_meta_help = gengetopt_args_info_help[14] ;
+  args_info->delta_help = gengetopt_args_info_help[15] ;
+  args_info->min_support_help = gengetopt_args_info_help[16] ;
+  args_info->dedup_members_help = gengetopt_args_info_help[17] ;
+  args_info->mem_stats_help = gengetopt_args_info_help[18] ;
+  args_info->labels_help = gengetopt_args_info_help[19] ;
+  args_info->trace_out_help = gengetopt_args_info_help[20] ;
+  args_info->sync_base_help = gengetopt_args_info_help[22] ;
+  args_info->net_base_help = gengetopt_args_info_help[23] ;
+  args_info->min_base_coverage_help = gengetopt_args_info_help[24] ;
+  args_info->intact_help = gengetopt_args_info_help[25] ;
+  args_info->lookup_help = gengetopt_args_info_help[27] ;
+  args_info->match_help = gengetopt_args_info_help[29] ;
+  args_info->top_matches_help = gengetopt_args_info_help[30] ;
+  args_info->f1_help = gengetopt_args_info_help[31] ;
+  args_info->check_help = gengetopt_args_info_help[33] ;
+  args_info->annotate_help = gengetopt_args_info_help[35] ;
+  args_info->info_help = gengetopt_args_info_help[37] ;
+  args_info->profile_shape_help = gengetopt_args_info_help[39] ;
+  args_info->generate_help = gengetopt_args_info_help[41] ;
+  args_info->seed_help = gengetopt_args_info_help[42] ;
+  args_info->extract_base_help = gengetopt_args_info_help[44] ;
   
 }
 
@@ -214,8 +350,30 @@ cmdline_parser_release (struct gengetopt_args_info *args_info)
   free_string_field (&(args_info->btm_size_orig));
   free_string_field (&(args_info->top_size_orig));
   free_string_field (&(args_info->membership_orig));
+  free_string_field (&(args_info->threads_orig));
+  free_string_field (&(args_info->cache_arg));
+  free_string_field (&(args_info->cache_orig));
+  free_string_field (&(args_info->cache_limit_orig));
+  free_string_field (&(args_info->index_arg));
+  free_string_field (&(args_info->index_orig));
+  free_string_field (&(args_info->postings_arg));
+  free_string_field (&(args_info->postings_orig));
+  free_string_field (&(args_info->arrow_arg));
+  free_string_field (&(args_info->arrow_orig));
+  free_string_field (&(args_info->delta_arg));
+  free_string_field (&(args_info->delta_orig));
+  free_string_field (&(args_info->min_support_orig));
+  free_string_field (&(args_info->trace_out_arg));
+  free_string_field (&(args_info->trace_out_orig));
   free_string_field (&(args_info->sync_base_arg));
   free_string_field (&(args_info->sync_base_orig));
+  free_string_field (&(args_info->min_base_coverage_orig));
+  free_string_field (&(args_info->lookup_arg));
+  free_string_field (&(args_info->lookup_orig));
+  free_string_field (&(args_info->match_arg));
+  free_string_field (&(args_info->match_orig));
+  free_string_field (&(args_info->top_matches_orig));
+  free_string_field (&(args_info->seed_orig));
   
   
   for (i = 0; i < args_info->inputs_num; ++i)
@@ -265,8 +423,62 @@ cmdline_parser_dump(FILE *outfile, struct gengetopt_args_info *args_info)
     write_into_file(outfile, "top-size", args_info->top_size_orig, 0);
   if (args_info->membership_given)
     write_into_file(outfile, "membership", args_info->membership_orig, 0);
+  if (args_info->threads_given)
+    write_into_file(outfile, "threads", args_info->threads_orig, 0);
+  if (args_info->cache_given)
+    write_into_file(outfile, "cache", args_info->cache_orig, 0);
+  if (args_info->cache_limit_given)
+    write_into_file(outfile, "cache-limit", args_info->cache_limit_orig, 0);
+  if (args_info->cache_content_given)
+    write_into_file(outfile, "cache-content", 0, 0 );
+  if (args_info->index_given)
+    write_into_file(outfile, "index", args_info->index_orig, 0);
+  if (args_info->postings_given)
+    write_into_file(outfile, "postings", args_info->postings_orig, 0);
+  if (args_info->arrow_given)
+    write_into_file(outfile, "arrow", args_info->arrow_orig, 0);
+  if (args_info->arrow_meta_given)
+    write_into_file(outfile, "arrow-meta", 0, 0 );
+  if (args_info->delta_given)
+    write_into_file(outfile, "delta", args_info->delta_orig, 0);
+  if (args_info->min_support_given)
+    write_into_file(outfile, "min-support", args_info->min_support_orig, 0);
+  if (args_info->dedup_members_given)
+    write_into_file(outfile, "dedup-members", 0, 0 );
+  if (args_info->mem_stats_given)
+    write_into_file(outfile, "mem-stats", 0, 0 );
+  if (args_info->labels_given)
+    write_into_file(outfile, "labels", 0, 0 );
+  if (args_info->trace_out_given)
+    write_into_file(outfile, "trace-out", args_info->trace_out_orig, 0);
   if (args_info->sync_base_given)
     write_into_file(outfile, "sync-base", args_info->sync_base_orig, 0);
+  if (args_info->net_base_given)
+    write_into_file(outfile, "net-base", 0, 0 );
+  if (args_info->min_base_coverage_given)
+    write_into_file(outfile, "min-base-coverage", args_info->min_base_coverage_orig, 0);
+  if (args_info->intact_given)
+    write_into_file(outfile, "intact", 0, 0 );
+  if (args_info->lookup_given)
+    write_into_file(outfile, "lookup", args_info->lookup_orig, 0);
+  if (args_info->match_given)
+    write_into_file(outfile, "match", args_info->match_orig, 0);
+  if (args_info->top_matches_given)
+    write_into_file(outfile, "top-matches", args_info->top_matches_orig, 0);
+  if (args_info->f1_given)
+    write_into_file(outfile, "f1", 0, 0 );
+  if (args_info->check_given)
+    write_into_file(outfile, "check", 0, 0 );
+  if (args_info->annotate_given)
+    write_into_file(outfile, "annotate", 0, 0 );
+  if (args_info->info_given)
+    write_into_file(outfile, "info", 0, 0 );
+  if (args_info->profile_shape_given)
+    write_into_file(outfile, "profile-shape", 0, 0 );
+  if (args_info->generate_given)
+    write_into_file(outfile, "generate", 0, 0 );
+  if (args_info->seed_given)
+    write_into_file(outfile, "seed", args_info->seed_orig, 0);
   if (args_info->extract_base_given)
     write_into_file(outfile, "extract-base", 0, 0 );
   
@@ -563,12 +775,39 @@ cmdline_parser_internal (
         { "btm-size",	1, NULL, 'b' },
         { "top-size",	1, NULL, 't' },
         { "membership",	1, NULL, 'm' },
+        { "threads",	1, NULL, 'j' },
+        { "cache",	1, NULL, 'c' },
+        { "cache-limit",	1, NULL, 'l' },
+        { "cache-content",	0, NULL, 'C' },
+        { "index",	1, NULL, 'x' },
+        { "postings",	1, NULL, 'p' },
+        { "arrow",	1, NULL, 'a' },
+        { "arrow-meta",	0, NULL, 'A' },
+        { "delta",	1, NULL, 'd' },
+        { "min-support",	1, NULL, 'u' },
+        { "dedup-members",	0, NULL, 'U' },
+        { "mem-stats",	0, NULL, 'g' },
+        { "labels",	0, NULL, 'L' },
+        { "trace-out",	1, NULL, 'T' },
         { "sync-base",	1, NULL, 's' },
+        { "net-base",	0, NULL, 'n' },
+        { "min-base-coverage",	1, NULL, 'v' },
+        { "intact",	0, NULL, 'i' },
+        { "lookup",	1, NULL, 'q' },
+        { "match",	1, NULL, 'M' },
+        { "top-matches",	1, NULL, 'k' },
+        { "f1",	0, NULL, 'F' },
+        { "check",	0, NULL, 'K' },
+        { "annotate",	0, NULL, 'H' },
+        { "info",	0, NULL, 'I' },
+        { "profile-shape",	0, NULL, 'P' },
+        { "generate",	0, NULL, 'G' },
+        { "seed",	1, NULL, 'S' },
         { "extract-base",	0, NULL, 'e' },
         { 0,  0, 0, 0 }
       };
 
-      c = getopt_long (argc, argv, "hVo:rb:t:m:s:e", long_options, &option_index);
+      c = getopt_long (argc, argv, "hVo:rb:t:m:j:c:l:Cx:p:a:Ad:u:UgLT:s:nv:iq:M:k:FKHIPGS:e", long_options, &option_index);
 
       if (c == -1) break;	/* Exit from `while (1)' loop.  */
 
@@ -584,7 +823,7 @@ cmdline_parser_internal (
           cmdline_parser_free (&local_args_info);
           exit (EXIT_SUCCESS);
 
-        case 'o':	/* output file name. If a single directory <dirname> is specified then the default output file name is  <dirname>.cnl.
+        case 'o':	/* output file name. If a single directory or archive <dirname> is specified then the default output file name is  <dirname>.cnl.
         NOTE: the number of nodes is written to the output file only if the node base synchronization is applied, otherwise 0 is set.  */
         
         
@@ -642,6 +881,164 @@ cmdline_parser_internal (
               additional_error))
             goto failure;
         
+          break;
+        case 'j':	/* the number of worker threads for the parallel processing, 0 means the number of CPUs.  */
+        
+        
+          if (update_arg( (void *)&(args_info->threads_arg), 
+               &(args_info->threads_orig), &(args_info->threads_given),
+              &(local_args_info.threads_given), optarg, 0, "0", ARG_LONG,
+              check_ambiguity, override, 0, 0,
+              "threads", 'j',
+              additional_error))
+            goto failure;
+        
+          break;
+        case 'c':	/* cache directory of the results to reuse them on the repeated processing of the same inputs with the same options. The results are reflinked, hardlinked or copied from the cache, so they should not be modified in place.  */
+        
+        
+          if (update_arg( (void *)&(args_info->cache_arg), 
+               &(args_info->cache_orig), &(args_info->cache_given),
+              &(local_args_info.cache_given), optarg, 0, 0, ARG_STRING,
+              check_ambiguity, override, 0, 0,
+              "cache", 'c',
+              additional_error))
+            goto failure;
+        
+          break;
+        case 'l':	/* max size of the cache in MB, the least recently used results are evicted, 0 means unlimited.  */
+        
+        
+          if (update_arg( (void *)&(args_info->cache_limit_arg), 
+               &(args_info->cache_limit_orig), &(args_info->cache_limit_given),
+              &(local_args_info.cache_limit_given), optarg, 0, "4096", ARG_LONG,
+              check_ambiguity, override, 0, 0,
+              "cache-limit", 'l',
+              additional_error))
+            goto failure;
+        
+          break;
+        case 'C':	/* include CRC32C checksums of the inputs content into the cache key in addition to their paths, sizes and modification times.  */
+        
+        
+          if (update_arg((void *)&(args_info->cache_content_flag), 0, &(args_info->cache_content_given),
+              &(local_args_info.cache_content_given), optarg, 0, 0, ARG_FLAG,
+              check_ambiguity, override, 1, 0, "cache-content", 'C',
+              additional_error))
+            goto failure;
+        
+          break;
+        case 'x':	/* output the fingerprint index of the merged clusters to the specified file to lookup the clusters without touching the CNL (see --lookup). The caching is not applied in this case.  */
+        
+        
+          if (update_arg( (void *)&(args_info->index_arg), 
+               &(args_info->index_orig), &(args_info->index_given),
+              &(local_args_info.index_given), optarg, 0, 0, ARG_STRING,
+              check_ambiguity, override, 0, 0,
+              "index", 'x',
+              additional_error))
+            goto failure;
+        
+          break;
+        case 'p':	/* output the posting (node -> clusters) index of the merged clusters to the specified file to find the best matches of the clusters (see --match). The caching is not applied in this case.  */
+        
+        
+          if (update_arg( (void *)&(args_info->postings_arg), 
+               &(args_info->postings_orig), &(args_info->postings_given),
+              &(local_args_info.postings_given), optarg, 0, 0, ARG_STRING,
+              check_ambiguity, override, 0, 0,
+              "postings", 'p',
+              additional_error))
+            goto failure;
+        
+          break;
+        case 'a':	/* output the merged clusters also to the specified Apache Arrow IPC (Feather v2) file having the members column (list<uint32>) to load them by the analytics tools without parsing. The caching is not applied in this case.  */
+        
+        
+          if (update_arg( (void *)&(args_info->arrow_arg), 
+               &(args_info->arrow_orig), &(args_info->arrow_given),
+              &(local_args_info.arrow_given), optarg, 0, 0, ARG_STRING,
+              check_ambiguity, override, 0, 0,
+              "arrow", 'a',
+              additional_error))
+            goto failure;
+        
+          break;
+        case 'A':	/* output also the id (0-based position), source (input file) and size columns of the clusters to the Arrow IPC file.  */
+        
+        
+          if (update_arg((void *)&(args_info->arrow_meta_flag), 0, &(args_info->arrow_meta_given),
+              &(local_args_info.arrow_meta_given), optarg, 0, 0, ARG_FLAG,
+              check_ambiguity, override, 1, 0, "arrow-meta", 'A',
+              additional_error))
+            goto failure;
+        
+          break;
+        case 'd':	/* output also the hierarchical delta of the merged clusters to the specified CNL file, where each level (input) lists only its new clusters and the references to the clusters stored at the preceding levels by their 0-based ordinals. Not applicable with the min support > 1. The caching is not applied in this case.  */
+        
+        
+          if (update_arg( (void *)&(args_info->delta_arg), 
+               &(args_info->delta_orig), &(args_info->delta_given),
+              &(local_args_info.delta_given), optarg, 0, 0, ARG_STRING,
+              check_ambiguity, override, 0, 0,
+              "delta", 'd',
+              additional_error))
+            goto failure;
+        
+          break;
+        case 'u':	/* min number of the inputs (files or archive entries) containing the cluster to output it, >= 1. The clusters recurring in fewer inputs are dropped.  */
+        
+        
+          if (update_arg( (void *)&(args_info->min_support_arg), 
+               &(args_info->min_support_orig), &(args_info->min_support_given),
+              &(local_args_info.min_support_given), optarg, 0, "1", ARG_LONG,
+              check_ambiguity, override, 0, 0,
+              "min-support", 'u',
+              additional_error))
+            goto failure;
+        
+          break;
+        case 'U':	/* remove the repeated members of each cluster retaining their first occurrences, so the cluster is deduplicated with its clean twins. The clean clusters are only verified.  */
+        
+        
+          if (update_arg((void *)&(args_info->dedup_members_flag), 0, &(args_info->dedup_members_given),
+              &(local_args_info.dedup_members_given), optarg, 0, 0, ARG_FLAG,
+              check_ambiguity, override, 1, 0, "dedup-members", 'U',
+              additional_error))
+            goto failure;
+        
+          break;
+        case 'g':	/* output the memory consumption per subsystem (live and peak bytes, the number of allocations) to the stderr on completion. The report is output also on SIGUSR1 during the processing.  */
+        
+        
+          if (update_arg((void *)&(args_info->mem_stats_flag), 0, &(args_info->mem_stats_given),
+              &(local_args_info.mem_stats_given), optarg, 0, 0, ARG_FLAG,
+              check_ambiguity, override, 1, 0, "mem-stats", 'g',
+              additional_error))
+            goto failure;
+        
+          break;
+        case 'L':	/* the members are arbitrary string labels (e.g. URLs) rather than the numeric ids, which are interned into the dense ids and written back on the output. Each member token is a label as a whole (shares are not separated). Applicable to the merging, synchronization and node base extraction without the indices and the Arrow output.  */
+        
+        
+          if (update_arg((void *)&(args_info->labels_flag), 0, &(args_info->labels_given),
+              &(local_args_info.labels_given), optarg, 0, 0, ARG_FLAG,
+              check_ambiguity, override, 1, 0, "labels", 'L',
+              additional_error))
+            goto failure;
+        
+          break;
+        case 'T':	/* record the timeline of the processing stages (opening, header parsing, parsing of the files and chunks, output flushes) per thread and save it on completion to the specified file in the Chrome trace-event format viewable in Perfetto (ui.perfetto.dev) or chrome://tracing.  */
+        
+        
+          if (update_arg( (void *)&(args_info->trace_out_arg), 
+               &(args_info->trace_out_orig), &(args_info->trace_out_given),
+              &(local_args_info.trace_out_given), optarg, 0, 0, ARG_STRING,
+              check_ambiguity, override, 0, 0,
+              "trace-out", 'T',
+              additional_error))
+            goto failure;
+        
           break;
         case 's':	/* synchronize node base with the specified collection.  */
           args_info->sync_mode_counter += 1;
@@ -655,6 +1052,159 @@ cmdline_parser_internal (
               additional_error))
             goto failure;
         
+          break;
+        case 'n':	/* the node base is specified by the network (edge/arc list, the weights are omitted) rather than by the collection, which is the default for the .nse/.nsa/.ncol files.  */
+          args_info->sync_mode_counter += 1;
+        
+        
+          if (update_arg((void *)&(args_info->net_base_flag), 0, &(args_info->net_base_given),
+              &(local_args_info.net_base_given), optarg, 0, 0, ARG_FLAG,
+              check_ambiguity, override, 1, 0, "net-base", 'n',
+              additional_error))
+            goto failure;
+        
+          break;
+        case 'v':	/* min ratio of the cluster members present in the node base to retain the cluster, [0, 1]. The clusters having lower coverage are dropped.  */
+          args_info->sync_mode_counter += 1;
+        
+        
+          if (update_arg( (void *)&(args_info->min_base_coverage_arg), 
+               &(args_info->min_base_coverage_orig), &(args_info->min_base_coverage_given),
+              &(local_args_info.min_base_coverage_given), optarg, 0, "0", ARG_FLOAT,
+              check_ambiguity, override, 0, 0,
+              "min-base-coverage", 'v',
+              additional_error))
+            goto failure;
+        
+          break;
+        case 'i':	/* retain the covered clusters intact (including the non-base members) instead of trimming them to the node base.  */
+          args_info->sync_mode_counter += 1;
+        
+        
+          if (update_arg((void *)&(args_info->intact_flag), 0, &(args_info->intact_given),
+              &(local_args_info.intact_given), optarg, 0, 0, ARG_FLAG,
+              check_ambiguity, override, 1, 0, "intact", 'i',
+              additional_error))
+            goto failure;
+        
+          break;
+        case 'q':	/* lookup the query clusterings in the merged clustering by the specified fingerprint index (see --index) outputting <file>:<line> <position> <offset> tab-separated per query cluster, where the position is a 0-based index of the cluster and the offset is the byte offset of its line in the merged clustering, or '-' if the cluster is absent. The default output file name has .lkp extension.  */
+          args_info->lookup_mode_counter += 1;
+        
+        
+          if (update_arg( (void *)&(args_info->lookup_arg), 
+               &(args_info->lookup_orig), &(args_info->lookup_given),
+              &(local_args_info.lookup_given), optarg, 0, 0, ARG_STRING,
+              check_ambiguity, override, 0, 0,
+              "lookup", 'q',
+              additional_error))
+            goto failure;
+        
+          break;
+        case 'M':	/* find the best matches of the query clusterings in the merged clustering by the specified posting index (see --postings) outputting <file>:<line> followed by the tab-separated <position> <offset> <score> of the matches per query cluster, where the position is a 0-based index of the cluster and the offset is the byte offset of its line in the merged clustering. The default output file name has .mch extension.  */
+          args_info->match_mode_counter += 1;
+        
+        
+          if (update_arg( (void *)&(args_info->match_arg), 
+               &(args_info->match_orig), &(args_info->match_given),
+              &(local_args_info.match_given), optarg, 0, 0, ARG_STRING,
+              check_ambiguity, override, 0, 0,
+              "match", 'M',
+              additional_error))
+            goto failure;
+        
+          break;
+        case 'k':	/* the number of top matches of each query cluster.  */
+          args_info->match_mode_counter += 1;
+        
+        
+          if (update_arg( (void *)&(args_info->top_matches_arg), 
+               &(args_info->top_matches_orig), &(args_info->top_matches_given),
+              &(local_args_info.top_matches_given), optarg, 0, "1", ARG_LONG,
+              check_ambiguity, override, 0, 0,
+              "top-matches", 'k',
+              additional_error))
+            goto failure;
+        
+          break;
+        case 'F':	/* score the matches by F1 instead of the Jaccard index.  */
+          args_info->match_mode_counter += 1;
+        
+        
+          if (update_arg((void *)&(args_info->f1_flag), 0, &(args_info->f1_given),
+              &(local_args_info.f1_given), optarg, 0, 0, ARG_FLAG,
+              check_ambiguity, override, 1, 0, "f1", 'F',
+              additional_error))
+            goto failure;
+        
+          break;
+        case 'K':	/* validate the input clusterings reporting the issues as <file>:<line>:<column>: <issue> (invalid node ids and shares, ids overflow, empty clusters, header values and counts mismatching the content) to the stdout. No output file is created, the exit code is non-zero if any issue is found.  */
+          args_info->check_mode_counter += 1;
+        
+        
+          if (update_arg((void *)&(args_info->check_flag), 0, &(args_info->check_given),
+              &(local_args_info.check_given), optarg, 0, 0, ARG_FLAG,
+              check_ambiguity, override, 1, 0, "check", 'K',
+              additional_error))
+            goto failure;
+        
+          break;
+        case 'H':	/* write the header with the exact numbers of clusters and unique nodes into the input clusterings (replacing the existing header if any), so their subsequent loading preallocates the containers exactly. The files are replaced atomically, the archives are skipped.  */
+          args_info->annotate_mode_counter += 1;
+        
+        
+          if (update_arg((void *)&(args_info->annotate_flag), 0, &(args_info->annotate_given),
+              &(local_args_info.annotate_given), optarg, 0, 0, ARG_FLAG,
+              check_ambiguity, override, 1, 0, "annotate", 'H',
+              additional_error))
+            goto failure;
+        
+          break;
+        case 'I':	/* output the table of the numbers of clusters, members, min and max cluster sizes and the number of nodes specified in the header of each input clustering followed by the totals to the stdout. The files are scanned in parallel without the parsing of the members.  */
+          args_info->info_mode_counter += 1;
+        
+        
+          if (update_arg((void *)&(args_info->info_flag), 0, &(args_info->info_given),
+              &(local_args_info.info_given), optarg, 0, 0, ARG_FLAG,
+              check_ambiguity, override, 1, 0, "info", 'I',
+              additional_error))
+            goto failure;
+        
+          break;
+        case 'P':	/* output the anonymized statistical profile of the input clusterings without the node ids: the distribution of the cluster sizes by log2 bins, the range and density of the node ids, the membership (overlap) of the nodes per level (input), the number of the clusters duplicated in the preceding inputs and the line format of each input. The default output file name has .shp extension.  */
+          args_info->profile_mode_counter += 1;
+        
+        
+          if (update_arg((void *)&(args_info->profile_shape_flag), 0, &(args_info->profile_shape_given),
+              &(local_args_info.profile_shape_given), optarg, 0, 0, ARG_FLAG,
+              check_ambiguity, override, 1, 0, "profile-shape", 'P',
+              additional_error))
+            goto failure;
+        
+          break;
+        case 'G':	/* generate the synthetic clusterings statistically similar to the profiled ones (see --profile-shape) by the input shape profile into the output directory, a file per profiled input. The default output directory is named after the profile.  */
+          args_info->generate_mode_counter += 1;
+        
+        
+          if (update_arg((void *)&(args_info->generate_flag), 0, &(args_info->generate_given),
+              &(local_args_info.generate_given), optarg, 0, 0, ARG_FLAG,
+              check_ambiguity, override, 1, 0, "generate", 'G',
+              additional_error))
+            goto failure;
+        
+          break;
+        case 'S':	/* seed of the random generator, the same profile and seed yield the same clusterings.  */
+          args_info->generate_mode_counter += 1;
+        
+        
+          if (update_arg( (void *)&(args_info->seed_arg), 
+               &(args_info->seed_orig), &(args_info->seed_given),
+              &(local_args_info.seed_given), optarg, 0, "0", ARG_LONG,
+              check_ambiguity, override, 0, 0,
+              "seed", 'S',
+              additional_error))
+            goto failure;
+        
           break;
         case 'e':	/* extract the node base from the clusterings instead of merging the clusterings.  */
           args_info->exrtact_mode_counter += 1;
@@ -681,13 +1231,258 @@ cmdline_parser_internal (
 
 
 
+  if (args_info->annotate_mode_counter && args_info->check_mode_counter) {
+    int annotate_given[] = {args_info->annotate_given,  -1};
+    const char *annotate_desc[] = {"--annotate",  0};
+    int check_given[] = {args_info->check_given,  -1};
+    const char *check_desc[] = {"--check",  0};
+    error_occurred += check_modes(annotate_given, annotate_desc, check_given, check_desc);
+  }
+  if (args_info->annotate_mode_counter && args_info->exrtact_mode_counter) {
+    int annotate_given[] = {args_info->annotate_given,  -1};
+    const char *annotate_desc[] = {"--annotate",  0};
+    int exrtact_given[] = {args_info->extract_base_given,  -1};
+    const char *exrtact_desc[] = {"--extract-base",  0};
+    error_occurred += check_modes(annotate_given, annotate_desc, exrtact_given, exrtact_desc);
+  }
+  if (args_info->annotate_mode_counter && args_info->generate_mode_counter) {
+    int annotate_given[] = {args_info->annotate_given,  -1};
+    const char *annotate_desc[] = {"--annotate",  0};
+    int generate_given[] = {args_info->generate_given, args_info->seed_given,  -1};
+    const char *generate_desc[] = {"--generate", "--seed",  0};
+    error_occurred += check_modes(annotate_given, annotate_desc, generate_given, generate_desc);
+  }
+  if (args_info->annotate_mode_counter && args_info->info_mode_counter) {
+    int annotate_given[] = {args_info->annotate_given,  -1};
+    const char *annotate_desc[] = {"--annotate",  0};
+    int info_given[] = {args_info->info_given,  -1};
+    const char *info_desc[] = {"--info",  0};
+    error_occurred += check_modes(annotate_given, annotate_desc, info_given, info_desc);
+  }
+  if (args_info->annotate_mode_counter && args_info->lookup_mode_counter) {
+    int annotate_given[] = {args_info->annotate_given,  -1};
+    const char *annotate_desc[] = {"--annotate",  0};
+    int lookup_given[] = {args_info->lookup_given,  -1};
+    const char *lookup_desc[] = {"--lookup",  0};
+    error_occurred += check_modes(annotate_given, annotate_desc, lookup_given, lookup_desc);
+  }
+  if (args_info->annotate_mode_counter && args_info->match_mode_counter) {
+    int annotate_given[] = {args_info->annotate_given,  -1};
+    const char *annotate_desc[] = {"--annotate",  0};
+    int match_given[] = {args_info->match_given, args_info->top_matches_given, args_info->f1_given,  -1};
+    const char *match_desc[] = {"--match", "--top-matches", "--f1",  0};
+    error_occurred += check_modes(annotate_given, annotate_desc, match_given, match_desc);
+  }
+  if (args_info->annotate_mode_counter && args_info->profile_mode_counter) {
+    int annotate_given[] = {args_info->annotate_given,  -1};
+    const char *annotate_desc[] = {"--annotate",  0};
+    int profile_given[] = {args_info->profile_shape_given,  -1};
+    const char *profile_desc[] = {"--profile-shape",  0};
+    error_occurred += check_modes(annotate_given, annotate_desc, profile_given, profile_desc);
+  }
+  if (args_info->annotate_mode_counter && args_info->sync_mode_counter) {
+    int annotate_given[] = {args_info->annotate_given,  -1};
+    const char *annotate_desc[] = {"--annotate",  0};
+    int sync_given[] = {args_info->sync_base_given, args_info->net_base_given, args_info->min_base_coverage_given, args_info->intact_given,  -1};
+    const char *sync_desc[] = {"--sync-base", "--net-base", "--min-base-coverage", "--intact",  0};
+    error_occurred += check_modes(annotate_given, annotate_desc, sync_given, sync_desc);
+  }
+  if (args_info->check_mode_counter && args_info->exrtact_mode_counter) {
+    int check_given[] = {args_info->check_given,  -1};
+    const char *check_desc[] = {"--check",  0};
+    int exrtact_given[] = {args_info->extract_base_given,  -1};
+    const char *exrtact_desc[] = {"--extract-base",  0};
+    error_occurred += check_modes(check_given, check_desc, exrtact_given, exrtact_desc);
+  }
+  if (args_info->check_mode_counter && args_info->generate_mode_counter) {
+    int check_given[] = {args_info->check_given,  -1};
+    const char *check_desc[] = {"--check",  0};
+    int generate_given[] = {args_info->generate_given, args_info->seed_given,  -1};
+    const char *generate_desc[] = {"--generate", "--seed",  0};
+    error_occurred += check_modes(check_given, check_desc, generate_given, generate_desc);
+  }
+  if (args_info->check_mode_counter && args_info->info_mode_counter) {
+    int check_given[] = {args_info->check_given,  -1};
+    const char *check_desc[] = {"--check",  0};
+    int info_given[] = {args_info->info_given,  -1};
+    const char *info_desc[] = {"--info",  0};
+    error_occurred += check_modes(check_given, check_desc, info_given, info_desc);
+  }
+  if (args_info->check_mode_counter && args_info->lookup_mode_counter) {
+    int check_given[] = {args_info->check_given,  -1};
+    const char *check_desc[] = {"--check",  0};
+    int lookup_given[] = {args_info->lookup_given,  -1};
+    const char *lookup_desc[] = {"--lookup",  0};
+    error_occurred += check_modes(check_given, check_desc, lookup_given, lookup_desc);
+  }
+  if (args_info->check_mode_counter && args_info->match_mode_counter) {
+    int check_given[] = {args_info->check_given,  -1};
+    const char *check_desc[] = {"--check",  0};
+    int match_given[] = {args_info->match_given, args_info->top_matches_given, args_info->f1_given,  -1};
+    const char *match_desc[] = {"--match", "--top-matches", "--f1",  0};
+    error_occurred += check_modes(check_given, check_desc, match_given, match_desc);
+  }
+  if (args_info->check_mode_counter && args_info->profile_mode_counter) {
+    int check_given[] = {args_info->check_given,  -1};
+    const char *check_desc[] = {"--check",  0};
+    int profile_given[] = {args_info->profile_shape_given,  -1};
+    const char *profile_desc[] = {"--profile-shape",  0};
+    error_occurred += check_modes(check_given, check_desc, profile_given, profile_desc);
+  }
+  if (args_info->check_mode_counter && args_info->sync_mode_counter) {
+    int check_given[] = {args_info->check_given,  -1};
+    const char *check_desc[] = {"--check",  0};
+    int sync_given[] = {args_info->sync_base_given, args_info->net_base_given, args_info->min_base_coverage_given, args_info->intact_given,  -1};
+    const char *sync_desc[] = {"--sync-base", "--net-base", "--min-base-coverage", "--intact",  0};
+    error_occurred += check_modes(check_given, check_desc, sync_given, sync_desc);
+  }
+  if (args_info->exrtact_mode_counter && args_info->generate_mode_counter) {
+    int exrtact_given[] = {args_info->extract_base_given,  -1};
+    const char *exrtact_desc[] = {"--extract-base",  0};
+    int generate_given[] = {args_info->generate_given, args_info->seed_given,  -1};
+    const char *generate_desc[] = {"--generate", "--seed",  0};
+    error_occurred += check_modes(exrtact_given, exrtact_desc, generate_given, generate_desc);
+  }
+  if (args_info->exrtact_mode_counter && args_info->info_mode_counter) {
+    int exrtact_given[] = {args_info->extract_base_given,  -1};
+    const char *exrtact_desc[] = {"--extract-base",  0};
+    int info_given[] = {args_info->info_given,  -1};
+    const char *info_desc[] = {"--info",  0};
+    error_occurred += check_modes(exrtact_given, exrtact_desc, info_given, info_desc);
+  }
+  if (args_info->exrtact_mode_counter && args_info->lookup_mode_counter) {
+    int exrtact_given[] = {args_info->extract_base_given,  -1};
+    const char *exrtact_desc[] = {"--extract-base",  0};
+    int lookup_given[] = {args_info->lookup_given,  -1};
+    const char *lookup_desc[] = {"--lookup",  0};
+    error_occurred += check_modes(exrtact_given, exrtact_desc, lookup_given, lookup_desc);
+  }
+  if (args_info->exrtact_mode_counter && args_info->match_mode_counter) {
+    int exrtact_given[] = {args_info->extract_base_given,  -1};
+    const char *exrtact_desc[] = {"--extract-base",  0};
+    int match_given[] = {args_info->match_given, args_info->top_matches_given, args_info->f1_given,  -1};
+    const char *match_desc[] = {"--match", "--top-matches", "--f1",  0};
+    error_occurred += check_modes(exrtact_given, exrtact_desc, match_given, match_desc);
+  }
+  if (args_info->exrtact_mode_counter && args_info->profile_mode_counter) {
+    int exrtact_given[] = {args_info->extract_base_given,  -1};
+    const char *exrtact_desc[] = {"--extract-base",  0};
+    int profile_given[] = {args_info->profile_shape_given,  -1};
+    const char *profile_desc[] = {"--profile-shape",  0};
+    error_occurred += check_modes(exrtact_given, exrtact_desc, profile_given, profile_desc);
+  }
   if (args_info->exrtact_mode_counter && args_info->sync_mode_counter) {
     int exrtact_given[] = {args_info->extract_base_given,  -1};
     const char *exrtact_desc[] = {"--extract-base",  0};
-    int sync_given[] = {args_info->sync_base_given,  -1};
-    const char *sync_desc[] = {"--sync-base",  0};
+    int sync_given[] = {args_info->sync_base_given, args_info->net_base_given, args_info->min_base_coverage_given, args_info->intact_given,  -1};
+    const char *sync_desc[] = {"--sync-base", "--net-base", "--min-base-coverage", "--intact",  0};
     error_occurred += check_modes(exrtact_given, exrtact_desc, sync_given, sync_desc);
   }
+  if (args_info->generate_mode_counter && args_info->info_mode_counter) {
+    int generate_given[] = {args_info->generate_given, args_info->seed_given,  -1};
+    const char *generate_desc[] = {"--generate", "--seed",  0};
+    int info_given[] = {args_info->info_given,  -1};
+    const char *info_desc[] = {"--info",  0};
+    error_occurred += check_modes(generate_given, generate_desc, info_given, info_desc);
+  }
+  if (args_info->generate_mode_counter && args_info->lookup_mode_counter) {
+    int generate_given[] = {args_info->generate_given, args_info->seed_given,  -1};
+    const char *generate_desc[] = {"--generate", "--seed",  0};
+    int lookup_given[] = {args_info->lookup_given,  -1};
+    const char *lookup_desc[] = {"--lookup",  0};
+    error_occurred += check_modes(generate_given, generate_desc, lookup_given, lookup_desc);
+  }
+  if (args_info->generate_mode_counter && args_info->match_mode_counter) {
+    int generate_given[] = {args_info->generate_given, args_info->seed_given,  -1};
+    const char *generate_desc[] = {"--generate", "--seed",  0};
+    int match_given[] = {args_info->match_given, args_info->top_matches_given, args_info->f1_given,  -1};
+    const char *match_desc[] = {"--match", "--top-matches", "--f1",  0};
+    error_occurred += check_modes(generate_given, generate_desc, match_given, match_desc);
+  }
+  if (args_info->generate_mode_counter && args_info->profile_mode_counter) {
+    int generate_given[] = {args_info->generate_given, args_info->seed_given,  -1};
+    const char *generate_desc[] = {"--generate", "--seed",  0};
+    int profile_given[] = {args_info->profile_shape_given,  -1};
+    const char *profile_desc[] = {"--profile-shape",  0};
+    error_occurred += check_modes(generate_given, generate_desc, profile_given, profile_desc);
+  }
+  if (args_info->generate_mode_counter && args_info->sync_mode_counter) {
+    int generate_given[] = {args_info->generate_given, args_info->seed_given,  -1};
+    const char *generate_desc[] = {"--generate", "--seed",  0};
+    int sync_given[] = {args_info->sync_base_given, args_info->net_base_given, args_info->min_base_coverage_given, args_info->intact_given,  -1};
+    const char *sync_desc[] = {"--sync-base", "--net-base", "--min-base-coverage", "--intact",  0};
+    error_occurred += check_modes(generate_given, generate_desc, sync_given, sync_desc);
+  }
+  if (args_info->info_mode_counter && args_info->lookup_mode_counter) {
+    int info_given[] = {args_info->info_given,  -1};
+    const char *info_desc[] = {"--info",  0};
+    int lookup_given[] = {args_info->lookup_given,  -1};
+    const char *lookup_desc[] = {"--lookup",  0};
+    error_occurred += check_modes(info_given, info_desc, lookup_given, lookup_desc);
+  }
+  if (args_info->info_mode_counter && args_info->match_mode_counter) {
+    int info_given[] = {args_info->info_given,  -1};
+    const char *info_desc[] = {"--info",  0};
+    int match_given[] = {args_info->match_given, args_info->top_matches_given, args_info->f1_given,  -1};
+    const char *match_desc[] = {"--match", "--top-matches", "--f1",  0};
+    error_occurred += check_modes(info_given, info_desc, match_given, match_desc);
+  }
+  if (args_info->info_mode_counter && args_info->profile_mode_counter) {
+    int info_given[] = {args_info->info_given,  -1};
+    const char *info_desc[] = {"--info",  0};
+    int profile_given[] = {args_info->profile_shape_given,  -1};
+    const char *profile_desc[] = {"--profile-shape",  0};
+    error_occurred += check_modes(info_given, info_desc, profile_given, profile_desc);
+  }
+  if (args_info->info_mode_counter && args_info->sync_mode_counter) {
+    int info_given[] = {args_info->info_given,  -1};
+    const char *info_desc[] = {"--info",  0};
+    int sync_given[] = {args_info->sync_base_given, args_info->net_base_given, args_info->min_base_coverage_given, args_info->intact_given,  -1};
+    const char *sync_desc[] = {"--sync-base", "--net-base", "--min-base-coverage", "--intact",  0};
+    error_occurred += check_modes(info_given, info_desc, sync_given, sync_desc);
+  }
+  if (args_info->lookup_mode_counter && args_info->match_mode_counter) {
+    int lookup_given[] = {args_info->lookup_given,  -1};
+    const char *lookup_desc[] = {"--lookup",  0};
+    int match_given[] = {args_info->match_given, args_info->top_matches_given, args_info->f1_given,  -1};
+    const char *match_desc[] = {"--match", "--top-matches", "--f1",  0};
+    error_occurred += check_modes(lookup_given, lookup_desc, match_given, match_desc);
+  }
+  if (args_info->lookup_mode_counter && args_info->profile_mode_counter) {
+    int lookup_given[] = {args_info->lookup_given,  -1};
+    const char *lookup_desc[] = {"--lookup",  0};
+    int profile_given[] = {args_info->profile_shape_given,  -1};
+    const char *profile_desc[] = {"--profile-shape",  0};
+    error_occurred += check_modes(lookup_given, lookup_desc, profile_given, profile_desc);
+  }
+  if (args_info->lookup_mode_counter && args_info->sync_mode_counter) {
+    int lookup_given[] = {args_info->lookup_given,  -1};
+    const char *lookup_desc[] = {"--lookup",  0};
+    int sync_given[] = {args_info->sync_base_given, args_info->net_base_given, args_info->min_base_coverage_given, args_info->intact_given,  -1};
+    const char *sync_desc[] = {"--sync-base", "--net-base", "--min-base-coverage", "--intact",  0};
+    error_occurred += check_modes(lookup_given, lookup_desc, sync_given, sync_desc);
+  }
+  if (args_info->match_mode_counter && args_info->profile_mode_counter) {
+    int match_given[] = {args_info->match_given, args_info->top_matches_given, args_info->f1_given,  -1};
+    const char *match_desc[] = {"--match", "--top-matches", "--f1",  0};
+    int profile_given[] = {args_info->profile_shape_given,  -1};
+    const char *profile_desc[] = {"--profile-shape",  0};
+    error_occurred += check_modes(match_given, match_desc, profile_given, profile_desc);
+  }
+  if (args_info->match_mode_counter && args_info->sync_mode_counter) {
+    int match_given[] = {args_info->match_given, args_info->top_matches_given, args_info->f1_given,  -1};
+    const char *match_desc[] = {"--match", "--top-matches", "--f1",  0};
+    int sync_given[] = {args_info->sync_base_given, args_info->net_base_given, args_info->min_base_coverage_given, args_info->intact_given,  -1};
+    const char *sync_desc[] = {"--sync-base", "--net-base", "--min-base-coverage", "--intact",  0};
+    error_occurred += check_modes(match_given, match_desc, sync_given, sync_desc);
+  }
+  if (args_info->profile_mode_counter && args_info->sync_mode_counter) {
+    int profile_given[] = {args_info->profile_shape_given,  -1};
+    const char *profile_desc[] = {"--profile-shape",  0};
+    int sync_given[] = {args_info->sync_base_given, args_info->net_base_given, args_info->min_base_coverage_given, args_info->intact_given,  -1};
+    const char *sync_desc[] = {"--sync-base", "--net-base", "--min-base-coverage", "--intact",  0};
+    error_occurred += check_modes(profile_given, profile_desc, sync_given, sync_desc);
+  }
   
 	FIX_UNUSED(check_required);
 
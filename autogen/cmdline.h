@@ -31,7 +31,7 @@ extern "C" {
 
 #ifndef CMDLINE_PARSER_VERSION
 /** @brief the program version */
-#define CMDLINE_PARSER_VERSION "1.2"
+#define CMDLINE_PARSER_VERSION "1.19"
 #endif
 
 /** @brief Where the command line options are stored */
@@ -39,11 +39,11 @@ struct gengetopt_args_info
 {
   const char *help_help; /**< @brief Print help and exit help description.  */
   const char *version_help; /**< @brief Print version and exit help description.  */
-  char * output_arg;	/**< @brief output file name. If a single directory <dirname> is specified then the default output file name is  <dirname>.cnl.
+  char * output_arg;	/**< @brief output file name. If a single directory or archive <dirname> is specified then the default output file name is  <dirname>.cnl.
   NOTE: the number of nodes is written to the output file only if the node base synchronization is applied, otherwise 0 is set (default='clusters.cnl').  */
-  char * output_orig;	/**< @brief output file name. If a single directory <dirname> is specified then the default output file name is  <dirname>.cnl.
+  char * output_orig;	/**< @brief output file name. If a single directory or archive <dirname> is specified then the default output file name is  <dirname>.cnl.
   NOTE: the number of nodes is written to the output file only if the node base synchronization is applied, otherwise 0 is set original value given at command line.  */
-  const char *output_help; /**< @brief output file name. If a single directory <dirname> is specified then the default output file name is  <dirname>.cnl.
+  const char *output_help; /**< @brief output file name. If a single directory or archive <dirname> is specified then the default output file name is  <dirname>.cnl.
   NOTE: the number of nodes is written to the output file only if the node base synchronization is applied, otherwise 0 is set help description.  */
   int rewrite_flag;	/**< @brief rewrite already existing resulting file or skip the processing (default=off).  */
   const char *rewrite_help; /**< @brief rewrite already existing resulting file or skip the processing help description.  */
@@ -56,9 +56,77 @@ struct gengetopt_args_info
   float membership_arg;	/**< @brief average expected membership of the nodes in the clusters, > 0, typically >= 1 (default='1').  */
   char * membership_orig;	/**< @brief average expected membership of the nodes in the clusters, > 0, typically >= 1 original value given at command line.  */
   const char *membership_help; /**< @brief average expected membership of the nodes in the clusters, > 0, typically >= 1 help description.  */
+  long threads_arg;	/**< @brief the number of worker threads for the parallel processing, 0 means the number of CPUs (default='0').  */
+  char * threads_orig;	/**< @brief the number of worker threads for the parallel processing, 0 means the number of CPUs original value given at command line.  */
+  const char *threads_help; /**< @brief the number of worker threads for the parallel processing, 0 means the number of CPUs help description.  */
+  char * cache_arg;	/**< @brief cache directory of the results to reuse them on the repeated processing of the same inputs with the same options. The results are reflinked, hardlinked or copied from the cache, so they should not be modified in place.  */
+  char * cache_orig;	/**< @brief cache directory of the results to reuse them on the repeated processing of the same inputs with the same options. The results are reflinked, hardlinked or copied from the cache, so they should not be modified in place original value given at command line.  */
+  const char *cache_help; /**< @brief cache directory of the results to reuse them on the repeated processing of the same inputs with the same options. The results are reflinked, hardlinked or copied from the cache, so they should not be modified in place help description.  */
+  long cache_limit_arg;	/**< @brief max size of the cache in MB, the least recently used results are evicted, 0 means unlimited (default='4096').  */
+  char * cache_limit_orig;	/**< @brief max size of the cache in MB, the least recently used results are evicted, 0 means unlimited original value given at command line.  */
+  const char *cache_limit_help; /**< @brief max size of the cache in MB, the least recently used results are evicted, 0 means unlimited help description.  */
+  int cache_content_flag;	/**< @brief include CRC32C checksums of the inputs content into the cache key in addition to their paths, sizes and modification times (default=off).  */
+  const char *cache_content_help; /**< @brief include CRC32C checksums of the inputs content into the cache key in addition to their paths, sizes and modification times help description.  */
+  char * index_arg;	/**< @brief output the fingerprint index of the merged clusters to the specified file to lookup the clusters without touching the CNL (see --lookup). The caching is not applied in this case.  */
+  char * index_orig;	/**< @brief output the fingerprint index of the merged clusters to the specified file to lookup the clusters without touching the CNL (see --lookup). The caching is not applied in this case original value given at command line.  */
+  const char *index_help; /**< @brief output the fingerprint index of the merged clusters to the specified file to lookup the clusters without touching the CNL (see --lookup). The caching is not applied in this case help description.  */
+  char * postings_arg;	/**< @brief output the posting (node -> clusters) index of the merged clusters to the specified file to find the best matches of the clusters (see --match). The caching is not applied in this case.  */
+  char * postings_orig;	/**< @brief output the posting (node -> clusters) index of the merged clusters to the specified file to find the best matches of the clusters (see --match). The caching is not applied in this case original value given at command line.  */
+  const char *postings_help; /**< @brief output the posting (node -> clusters) index of the merged clusters to the specified file to find the best matches of the clusters (see --match). The caching is not applied in this case help description.  */
+  char * arrow_arg;	/**< @brief output the merged clusters also to the specified Apache Arrow IPC (Feather v2) file having the members column (list<uint32>) to load them by the analytics tools without parsing. The caching is not applied in this case.  */
+  char * arrow_orig;	/**< @brief output the merged clusters also to the specified Apache Arrow IPC (Feather v2) file having the members column (list<uint32>) to load them by the analytics tools without parsing. The caching is not applied in this case original value given at command line.  */
+  const char *arrow_help; /**< @brief output the merged clusters also to the specified Apache Arrow IPC (Feather v2) file having the members column (list<uint32>) to load them by the analytics tools without parsing. The caching is not applied in this case help description.  */
+  int arrow_meta_flag;	/**< @brief output also the id (0-based position), source (input file) and size columns of the clusters to the Arrow IPC file (default=off).  */
+  const char *arrow_meta_help; /**< @brief output also the id (0-based position), source (input file) and size columns of the clusters to the Arrow IPC file help description.  */
+  char * delta_arg;	/**< @brief output also the hierarchical delta of the merged clusters to the specified CNL file, where each level (input) lists only its new clusters and the references to the clusters stored at the preceding levels by their 0-based ordinals. Not applicable with the min support > 1. The caching is not applied in this case.  */
+  char * delta_orig;	/**< @brief output also the hierarchical delta of the merged clusters to the specified CNL file, where each level (input) lists only its new clusters and the references to the clusters stored at the preceding levels by their 0-based ordinals. Not applicable with the min support > 1. The caching is not applied in this case original value given at command line.  */
+  const char *delta_help; /**< @brief output also the hierarchical delta of the merged clusters to the specified CNL file, where each level (input) lists only its new clusters and the references to the clusters stored at the preceding levels by their 0-based ordinals. Not applicable with the min support > 1. The caching is not applied in this case help description.  */
+  long min_support_arg;	/**< @brief min number of the inputs (files or archive entries) containing the cluster to output it, >= 1. The clusters recurring in fewer inputs are dropped (default='1').  */
+  char * min_support_orig;	/**< @brief min number of the inputs (files or archive entries) containing the cluster to output it, >= 1. The clusters recurring in fewer inputs are dropped original value given at command line.  */
+  const char *min_support_help; /**< @brief min number of the inputs (files or archive entries) containing the cluster to output it, >= 1. The clusters recurring in fewer inputs are dropped help description.  */
+  int dedup_members_flag;	/**< @brief remove the repeated members of each cluster retaining their first occurrences, so the cluster is deduplicated with its clean twins. The clean clusters are only verified (default=off).  */
+  const char *dedup_members_help; /**< @brief remove the repeated members of each cluster retaining their first occurrences, so the cluster is deduplicated with its clean twins. The clean clusters are only verified help description.  */
+  int mem_stats_flag;	/**< @brief output the memory consumption per subsystem (live and peak bytes, the number of allocations) to the stderr on completion. The report is output also on SIGUSR1 during the processing (default=off).  */
+  const char *mem_stats_help; /**< @brief output the memory consumption per subsystem (live and peak bytes, the number of allocations) to the stderr on completion. The report is output also on SIGUSR1 during the processing help description.  */
+  int labels_flag;	/**< @brief the members are arbitrary string labels (e.g. URLs) rather than the numeric ids, which are interned into the dense ids and written back on the output. Each member token is a label as a whole (shares are not separated). Applicable to the merging, synchronization and node base extraction without the indices and the Arrow output (default=off).  */
+  const char *labels_help; /**< @brief the members are arbitrary string labels (e.g. URLs) rather than the numeric ids, which are interned into the dense ids and written back on the output. Each member token is a label as a whole (shares are not separated). Applicable to the merging, synchronization and node base extraction without the indices and the Arrow output help description.  */
+  char * trace_out_arg;	/**< @brief record the timeline of the processing stages (opening, header parsing, parsing of the files and chunks, output flushes) per thread and save it on completion to the specified file in the Chrome trace-event format viewable in Perfetto (ui.perfetto.dev) or chrome://tracing.  */
+  char * trace_out_orig;	/**< @brief record the timeline of the processing stages (opening, header parsing, parsing of the files and chunks, output flushes) per thread and save it on completion to the specified file in the Chrome trace-event format viewable in Perfetto (ui.perfetto.dev) or chrome://tracing original value given at command line.  */
+  const char *trace_out_help; /**< @brief record the timeline of the processing stages (opening, header parsing, parsing of the files and chunks, output flushes) per thread and save it on completion to the specified file in the Chrome trace-event format viewable in Perfetto (ui.perfetto.dev) or chrome://tracing help description.  */
   char * sync_base_arg;	/**< @brief synchronize node base with the specified collection.  */
   char * sync_base_orig;	/**< @brief synchronize node base with the specified collection original value given at command line.  */
   const char *sync_base_help; /**< @brief synchronize node base with the specified collection help description.  */
+  int net_base_flag;	/**< @brief the node base is specified by the network (edge/arc list, the weights are omitted) rather than by the collection, which is the default for the .nse/.nsa/.ncol files (default=off).  */
+  const char *net_base_help; /**< @brief the node base is specified by the network (edge/arc list, the weights are omitted) rather than by the collection, which is the default for the .nse/.nsa/.ncol files help description.  */
+  float min_base_coverage_arg;	/**< @brief min ratio of the cluster members present in the node base to retain the cluster, [0, 1]. The clusters having lower coverage are dropped (default='0').  */
+  char * min_base_coverage_orig;	/**< @brief min ratio of the cluster members present in the node base to retain the cluster, [0, 1]. The clusters having lower coverage are dropped original value given at command line.  */
+  const char *min_base_coverage_help; /**< @brief min ratio of the cluster members present in the node base to retain the cluster, [0, 1]. The clusters having lower coverage are dropped help description.  */
+  int intact_flag;	/**< @brief retain the covered clusters intact (including the non-base members) instead of trimming them to the node base (default=off).  */
+  const char *intact_help; /**< @brief retain the covered clusters intact (including the non-base members) instead of trimming them to the node base help description.  */
+  char * lookup_arg;	/**< @brief lookup the query clusterings in the merged clustering by the specified fingerprint index (see --index) outputting <file>:<line> <position> <offset> tab-separated per query cluster, where the position is a 0-based index of the cluster and the offset is the byte offset of its line in the merged clustering, or '-' if the cluster is absent. The default output file name has .lkp extension.  */
+  char * lookup_orig;	/**< @brief lookup the query clusterings in the merged clustering by the specified fingerprint index (see --index) outputting <file>:<line> <position> <offset> tab-separated per query cluster, where the position is a 0-based index of the cluster and the offset is the byte offset of its line in the merged clustering, or '-' if the cluster is absent. The default output file name has .lkp extension original value given at command line.  */
+  const char *lookup_help; /**< @brief lookup the query clusterings in the merged clustering by the specified fingerprint index (see --index) outputting <file>:<line> <position> <offset> tab-separated per query cluster, where the position is a 0-based index of the cluster and the offset is the byte offset of its line in the merged clustering, or '-' if the cluster is absent. The default output file name has .lkp extension help description.  */
+  char * match_arg;	/**< @brief find the best matches of the query clusterings in the merged clustering by the specified posting index (see --postings) outputting <file>:<line> followed by the tab-separated <position> <offset> <score> of the matches per query cluster, where the position is a 0-based index of the cluster and the offset is the byte offset of its line in the merged clustering. The default output file name has .mch extension.  */
+  char * match_orig;	/**< @brief find the best matches of the query clusterings in the merged clustering by the specified posting index (see --postings) outputting <file>:<line> followed by the tab-separated <position> <offset> <score> of the matches per query cluster, where the position is a 0-based index of the cluster and the offset is the byte offset of its line in the merged clustering. The default output file name has .mch extension original value given at command line.  */
+  const char *match_help; /**< @brief find the best matches of the query clusterings in the merged clustering by the specified posting index (see --postings) outputting <file>:<line> followed by the tab-separated <position> <offset> <score> of the matches per query cluster, where the position is a 0-based index of the cluster and the offset is the byte offset of its line in the merged clustering. The default output file name has .mch extension help description.  */
+  long top_matches_arg;	/**< @brief the number of top matches of each query cluster (default='1').  */
+  char * top_matches_orig;	/**< @brief the number of top matches of each query cluster original value given at command line.  */
+  const char *top_matches_help; /**< @brief the number of top matches of each query cluster help description.  */
+  int f1_flag;	/**< @brief score the matches by F1 instead of the Jaccard index (default=off).  */
+  const char *f1_help; /**< @brief score the matches by F1 instead of the Jaccard index help description.  */
+  int check_flag;	/**< @brief validate the input clusterings reporting the issues as <file>:<line>:<column>: <issue> (invalid node ids and shares, ids overflow, empty clusters, header values and counts mismatching the content) to the stdout. No output file is created, the exit code is non-zero if any issue is found (default=off).  */
+  const char *check_help; /**< @brief validate the input clusterings reporting the issues as <file>:<line>:<column>: <issue> (invalid node ids and shares, ids overflow, empty clusters, header values and counts mismatching the content) to the stdout. No output file is created, the exit code is non-zero if any issue is found help description.  */
+  int annotate_flag;	/**< @brief write the header with the exact numbers of clusters and unique nodes into the input clusterings (replacing the existing header if any), so their subsequent loading preallocates the containers exactly. The files are replaced atomically, the archives are skipped (default=off).  */
+  const char *annotate_help; /**< @brief write the header with the exact numbers of clusters and unique nodes into the input clusterings (replacing the existing header if any), so their subsequent loading preallocates the containers exactly. The files are replaced atomically, the archives are skipped help description.  */
+  int info_flag;	/**< @brief output the table of the numbers of clusters, members, min and max cluster sizes and the number of nodes specified in the header of each input clustering followed by the totals to the stdout. The files are scanned in parallel without the parsing of the members (default=off).  */
+  const char *info_help; /**< @brief output the table of the numbers of clusters, members, min and max cluster sizes and the number of nodes specified in the header of each input clustering followed by the totals to the stdout. The files are scanned in parallel without the parsing of the members help description.  */
+  int profile_shape_flag;	/**< @brief output the anonymized statistical profile of the input clusterings without the node ids: the distribution of the cluster sizes by log2 bins, the range and density of the node ids, the membership (overlap) of the nodes per level (input), the number of the clusters duplicated in the preceding inputs and the line format of each input. The default output file name has .shp extension (default=off).  */
+  const char *profile_shape_help; /**< @brief output the anonymized statistical profile of the input clusterings without the node ids: the distribution of the cluster sizes by log2 bins, the range and density of the node ids, the membership (overlap) of the nodes per level (input), the number of the clusters duplicated in the preceding inputs and the line format of each input. The default output file name has .shp extension help description.  */
+  int generate_flag;	/**< @brief generate the synthetic clusterings statistically similar to the profiled ones (see --profile-shape) by the input shape profile into the output directory, a file per profiled input. The default output directory is named after the profile (default=off).  */
+  const char *generate_help; /**< @brief generate the synthetic clusterings statistically similar to the profiled ones (see --profile-shape) by the input shape profile into the output directory, a file per profiled input. The default output directory is named after the profile help description.  */
+  long seed_arg;	/**< @brief seed of the random generator, the same profile and seed yield the same clusterings (default='0').  */
+  char * seed_orig;	/**< @brief seed of the random generator, the same profile and seed yield the same clusterings original value given at command line.  */
+  const char *seed_help; /**< @brief seed of the random generator, the same profile and seed yield the same clusterings help description.  */
   int extract_base_flag;	/**< @brief extract the node base from the clusterings instead of merging the clusterings (default=off).  */
   const char *extract_base_help; /**< @brief extract the node base from the clusterings instead of merging the clusterings help description.  */
   
@@ -69,12 +137,46 @@ struct gengetopt_args_info
   unsigned int btm_size_given ;	/**< @brief Whether btm-size was given.  */
   unsigned int top_size_given ;	/**< @brief Whether top-size was given.  */
   unsigned int membership_given ;	/**< @brief Whether membership was given.  */
+  unsigned int threads_given ;	/**< @brief Whether threads was given.  */
+  unsigned int cache_given ;	/**< @brief Whether cache was given.  */
+  unsigned int cache_limit_given ;	/**< @brief Whether cache-limit was given.  */
+  unsigned int cache_content_given ;	/**< @brief Whether cache-content was given.  */
+  unsigned int index_given ;	/**< @brief Whether index was given.  */
+  unsigned int postings_given ;	/**< @brief Whether postings was given.  */
+  unsigned int arrow_given ;	/**< @brief Whether arrow was given.  */
+  unsigned int arrow_meta_given ;	/**< @brief Whether arrow-meta was given.  */
+  unsigned int delta_given ;	/**< @brief Whether delta was given.  */
+  unsigned int min_support_given ;	/**< @brief Whether min-support was given.  */
+  unsigned int dedup_members_given ;	/**< @brief Whether dedup-members was given.  */
+  unsigned int mem_stats_given ;	/**< @brief Whether mem-stats was given.  */
+  unsigned int labels_given ;	/**< @brief Whether labels was given.  */
+  unsigned int trace_out_given ;	/**< @brief Whether trace-out was given.  */
   unsigned int sync_base_given ;	/**< @brief Whether sync-base was given.  */
+  unsigned int net_base_given ;	/**< @brief Whether net-base was given.  */
+  unsigned int min_base_coverage_given ;	/**< @brief Whether min-base-coverage was given.  */
+  unsigned int intact_given ;	/**< @brief Whether intact was given.  */
+  unsigned int lookup_given ;	/**< @brief Whether lookup was given.  */
+  unsigned int match_given ;	/**< @brief Whether match was given.  */
+  unsigned int top_matches_given ;	/**< @brief Whether top-matches was given.  */
+  unsigned int f1_given ;	/**< @brief Whether f1 was given.  */
+  unsigned int check_given ;	/**< @brief Whether check was given.  */
+  unsigned int annotate_given ;	/**< @brief Whether annotate was given.  */
+  unsigned int info_given ;	/**< @brief Whether info was given.  */
+  unsigned int profile_shape_given ;	/**< @brief Whether profile-shape was given.  */
+  unsigned int generate_given ;	/**< @brief Whether generate was given.  */
+  unsigned int seed_given ;	/**< @brief Whether seed was given.  */
   unsigned int extract_base_given ;	/**< @brief Whether extract-base was given.  */
 
   char **inputs ; /**< @brief unnamed options (options without names) */
   unsigned inputs_num ; /**< @brief unnamed options number */
+  int annotate_mode_counter; /**< @brief Counter for mode annotate */
+  int check_mode_counter; /**< @brief Counter for mode check */
   int exrtact_mode_counter; /**< @brief Counter for mode exrtact */
+  int generate_mode_counter; /**< @brief Counter for mode generate */
+  int info_mode_counter; /**< @brief Counter for mode info */
+  int lookup_mode_counter; /**< @brief Counter for mode lookup */
+  int match_mode_counter; /**< @brief Counter for mode match */
+  int profile_mode_counter; /**< @brief Counter for mode profile */
   int sync_mode_counter; /**< @brief Counter for mode sync */
 } ;
 
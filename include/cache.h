@@ -0,0 +1,79 @@
+//! \brief Memoization of the processing results
+//!
+//! \license Apache License, Version 2.0: http://www.apache.org/licenses/LICENSE-2.0.html
+//! > 	Simple explanation: https://tldrlegal.com/license/apache-license-2.0-(apache-2.0)
+//!
+//! Copyright (c)
+//! \authr Artem Lutov
+//! \email luart@ya.ru
+//! \date 2026-10-18
+
+#ifndef CACHE_H
+#define CACHE_H
+
+#include "interface.h"
+
+
+// Cache Types -----------------------------------------------------------------
+//! \brief Cache of the resulting files keyed by the inputs and processing options
+//! \note Each cached result is stored as <id>.cnl with the <id>.key holding
+//! 	the full key to detect collisions of the ids. Modification time of the key
+//! 	file is the last access time used for the LRU eviction.
+class ResultCache {
+	string  m_dir;  //!< Cache directory, empty if the caching is disabled
+	size_t  m_limit;  //!< Max size of the cache in bytes, 0 means unlimited
+	bool  m_content;  //!< Include checksums of the input files content into the key
+	string  m_key;  //!< Key of the current processing
+	string  m_id;  //!< Id of the current processing (hex digest of the key)
+public:
+    //! \brief Constructor
+    //!
+    //! \param dir const char*  - cache directory, nullptr to disable the caching
+    //! \param limit=0 size_t  - max size of the cache in bytes, 0 means unlimited
+    //! \param content=false bool  - include checksums of the input files content into the key
+	ResultCache(const char* dir, size_t limit=0, bool content=false);
+
+    //! \brief Whether the caching is enabled
+	explicit operator bool() const noexcept  { return !m_dir.empty(); }
+
+    //! \brief Form the key of the processing
+    //!
+    //! \param options const string&  - processing options affecting the results
+    //! \param files const NamedFileWrappers&  - input files
+    //! \param fbase const NamedFileWrapper&  - node base file or an empty wrapper
+    //! \return void
+	void bind(const string& options, const NamedFileWrappers& files, const NamedFileWrapper& fbase);
+
+    //! \brief Fetch the cached results of the bound processing into the output file
+    //! \note The output file is reflinked, hardlinked or copied from the cache
+    //! \pre bind() has been called
+    //!
+    //! \param fout NamedFileWrapper&  - output file, closed on the successful fetching
+    //! \return bool  - whether the results have been fetched
+	bool fetch(NamedFileWrapper& fout);
+
+    //! \brief Store the output file to the cache and evict the least recently
+    //! 	used results exceeding the cache size limit
+    //! \pre bind() has been called
+    //!
+    //! \param fout NamedFileWrapper&  - complete output file, which is flushed
+    //! \return bool  - whether the results have been stored
+	bool store(NamedFileWrapper& fout);
+protected:
+    //! \brief Evict the least recently used results to fit the cache size limit
+    //!
+    //! \return void
+	void evict();
+};
+
+// Cache functions -------------------------------------------------------------
+//! \brief CRC32C (Castagnoli) checksum, the hardware acceleration (SSE 4.2)
+//! 	is applied if supported by the CPU
+//!
+//! \param data const void*  - the data to be hashed
+//! \param size size_t  - the number of bytes in the data
+//! \param crc=0 uint32_t  - initial value (the checksum of the preceding data)
+//! \return uint32_t  - resulting checksum
+uint32_t crc32c(const void* data, size_t size, uint32_t crc=0) noexcept;
+
+#endif // CACHE_H
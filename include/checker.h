@@ -0,0 +1,57 @@
+//! \brief Validation (linting), annotation and inspection of the CNL files
+//!
+//! \license Apache License, Version 2.0: http://www.apache.org/licenses/LICENSE-2.0.html
+//! > 	Simple explanation: https://tldrlegal.com/license/apache-license-2.0-(apache-2.0)
+//!
+//! Copyright (c)
+//! \authr Artem Lutov
+//! \email luart@ya.ru
+//! \date 2026-10-18
+
+#ifndef CHECKER_H
+#define CHECKER_H
+
+#include "interface.h"
+
+
+// Checker functions -----------------------------------------------------------
+//! \brief Validate the CNL files reporting the issues with their positions
+//! \note The content is validated by the line-aligned chunks in parallel, where
+//! 	the lines are prescanned by the SIMD character-class scan, so only the
+//! 	tokens containing chars other than the digits and delimiters are classified
+//! 	per char. The following issues are reported as <file>:<line>:<column>: <issue>
+//! 	to the stdout: invalid chars in the node ids and shares, ids overflowing
+//! 	the Id type, empty clusters, invalid header values and mismatch of the
+//! 	header counts with the actual numbers of clusters and nodes.
+//!
+//! \param files NamedFileWrappers&  - validating collections including the archives
+//! \param threads=0 unsigned  - the number of worker threads, 0 means the number of CPUs
+//! \param issmax=16 size_t  - max number of the reported issues per file, the rest are counted
+//! \return bool  - all files are valid
+bool checkCollections(NamedFileWrappers& files, unsigned threads=0, size_t issmax=16);
+
+//! \brief Annotate the CNL files by the header with the exact numbers of clusters
+//! 	and unique nodes, so the subsequent loading preallocates the containers exactly
+//! \note The counts are evaluated in a single parallel pass with the set of
+//! 	nodes. The header is written to the temporary file with the content, which
+//! 	then replaces the original file. The files having the valid header are
+//! 	retained intact, the archives are skipped.
+//!
+//! \param files NamedFileWrappers&  - annotating collections
+//! \param threads=0 unsigned  - the number of worker threads, 0 means the number of CPUs
+//! \return bool  - all files are annotated (or have valid headers) without the errors
+bool annotateCollections(NamedFileWrappers& files, unsigned threads=0);
+
+//! \brief Inspect the CNL files outputting per-file table of the numbers of
+//! 	clusters, members, cluster size ranges and the number of nodes specified
+//! 	in the header if any, followed by the totals to the stdout
+//! \note The members are counted as tokens without the parsing by the vectorized
+//! 	newline and delimiter counter, where the files are processed by the
+//! 	line-aligned spans in parallel.
+//!
+//! \param files NamedFileWrappers&  - inspecting collections including the archives
+//! \param threads=0 unsigned  - the number of worker threads, 0 means the number of CPUs
+//! \return bool  - the processing is successful
+bool inspectCollections(NamedFileWrappers& files, unsigned threads=0);
+
+#endif // CHECKER_H
@@ -0,0 +1,97 @@
+//! \brief Fingerprint index of the merged clusters for the fast lookup
+//!
+//! \license Apache License, Version 2.0: http://www.apache.org/licenses/LICENSE-2.0.html
+//! > 	Simple explanation: https://tldrlegal.com/license/apache-license-2.0-(apache-2.0)
+//!
+//! Copyright (c)
+//! \authr Artem Lutov
+//! \email luart@ya.ru
+//! \date 2026-10-18
+
+#ifndef FPINDEX_H
+#define FPINDEX_H
+
+#include "interface.h"
+
+
+// Index Types -----------------------------------------------------------------
+//! Fingerprint of the cluster (order invariant aggregation hash of the members)
+using Fingerprint = daoc::AggHash<Id, AccId>;
+
+//! \brief Static index of the cluster fingerprints, which is memory mapped
+//! 	and queried by the binary search without touching the CNL file
+//! \note The index file consists of the header followed by the entries ordered
+//! 	by the fingerprints. The native byte order is used.
+class FingerprintIndex {
+public:
+	//! \brief Indexed cluster
+	struct Entry {
+		Fingerprint  fp;  //!< Fingerprint of the cluster
+		uint64_t  offset;  //!< Offset of the cluster line in the CNL file
+		uint64_t  pos;  //!< Position (0-based index) of the cluster in the CNL file
+	};
+	static_assert(sizeof(Entry) == sizeof(Fingerprint) + 2 * sizeof(uint64_t)
+		, "FingerprintIndex, the entry should not have padding");
+
+	//! Indexed clusters
+	using Entries = vector<Entry, CountingAllocator<Entry, MemUse::INDICES>>;
+
+	//! \brief Header of the index file
+	struct Header {
+		char  magic[8];  //!< Signature of the file format
+		uint32_t  version;  //!< Version of the file format
+		uint32_t  entrysize;  //!< Size of the entry in bytes
+		uint64_t  size;  //!< The number of entries
+		uint64_t  key;  //!< Key of the fingerprints, 0 means unkeyed (the version 1)
+	};
+	constexpr static char  signature[sizeof Header::magic] = "RMFPIDX";  //!< Signature of the file format
+	constexpr static uint32_t  version = 2;  //!< Version of the file format
+private:
+	MappedFile  m_file;  //!< Content of the index file
+	const Entry*  m_entries;  //!< Ordered entries, nullptr if the index is invalid
+	size_t  m_size;  //!< The number of entries
+	AccId  m_key;  //!< Key of the fingerprints
+public:
+    //! \brief Constructor, maps and validates the index file
+    //!
+    //! \param file NamedFileWrapper&  - index file opened for reading
+	FingerprintIndex(NamedFileWrapper& file);
+
+    //! \brief Copy constructor
+	FingerprintIndex(const FingerprintIndex&)=delete;
+
+    //! \brief Copy assignment
+	FingerprintIndex& operator= (const FingerprintIndex&)=delete;
+
+    //! \brief Whether the index has been loaded
+	explicit operator bool() const noexcept  { return m_entries; }
+
+    //! \brief The number of indexed clusters
+	size_t size() const noexcept  { return m_size; }
+
+    //! \brief Key of the indexed fingerprints, which should be used for the queries
+	AccId key() const noexcept  { return m_key; }
+
+    //! \brief Find the cluster by the fingerprint
+    //! \note The fingerprint should be formed with the key of the index. In case
+    //! 	of the exact verification on merging, distinct clusters might have the same
+    //! 	fingerprint, then the first of them is yielded
+    //!
+    //! \param fp const Fingerprint&  - fingerprint of the cluster
+    //! \return const Entry*  - the indexed cluster or nullptr if not found
+	const Entry* find(const Fingerprint& fp) const noexcept;
+
+    //! \brief Save the index of the clusters, which are fingerprinted with
+    //! 	the current key
+    //! \note The index is formed in the temporary file and then renamed to not
+    //! 	expose partially formed index
+    //!
+    //! \param name const string&  - name of the index file
+    //! \param entries Entries&  - indexed clusters, which are ordered in place
+    //! \param group=nullptr daoc::OutputGroup*  - group of the outputs, which
+    //! 	renames the index on its commit rather than immediately
+    //! \return bool  - whether the index has been saved
+	static bool save(const string& name, Entries& entries, daoc::OutputGroup* group=nullptr);
+};
+
+#endif // FPINDEX_H
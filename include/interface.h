@@ -13,6 +13,9 @@
 
 #define INCLUDE_STL_FS
 #include "fileio.hpp"
+#include "tario.hpp"
+#include "dupfilter.hpp"
+#include "finalize.hpp"
 
 
 using namespace daoc;
@@ -29,6 +32,12 @@ using AccId = uint64_t;
 //! Unique ids
 using UniqIds = unordered_set<Id>;
 
+//! Node base, which is dense or sparse (adaptively)
+using NodeBase = IdSet<Id, CountingAllocator<uint64_t, MemUse::NODE_BASE>>;
+
+//! Interning table of the string labels of the nodes
+using Labels = LabelTable<Id>;
+
 ////! Clusters indexed by their hash
 ////! \note Even in case of accidential loss of a few clusters caused by the hash
 ////! collision, it will not make any noticeable impact on th subsequent evaluation
@@ -50,6 +59,86 @@ constexpr char  PATHSEP =
 //! \brief Unordered container of NamedFileWrapper-s
 using NamedFileWrappers = vector<NamedFileWrapper>;
 
+//! \brief Options of the clusterings merging
+struct MergeOptions {
+	Id  cmin = 0;  //!< Min allowed cluster size
+	Id  cmax = 0;  //!< Max allowed cluster size, 0 means any size
+	float  membership = 1.f;  //!< Average membership of the node, > 0, typically ~= 1
+	bool  netbase = false;  //!< The node base is specified by the network (edge/arc list)
+	unsigned  threads = 0;  //!< The number of worker threads, 0 means the number of CPUs
+	//! Min ratio of the cluster members present in the node base to retain the cluster, [0, 1]
+	float  coverage = 0;
+	//! Retain the clusters satisfying the coverage intact (with the non-base members)
+	//! instead of trimming them to the node base
+	bool  intact = false;
+	//! Output file of the fingerprint index of the merged clusters, empty if not required
+	string  index{};
+	//! Output file of the posting (node -> clusters) index of the merged clusters,
+	//! empty if not required
+	string  postings{};
+	//! Output file of the merged clusters in the Arrow IPC (Feather v2) format,
+	//! empty if not required
+	string  arrow{};
+	//! Output also the id, source and size columns to the Arrow IPC file
+	bool  arrowmeta = false;
+	//! Output file of the hierarchical delta of the merged clusters, where each
+	//! level (input) lists only its new clusters and the references to the clusters
+	//! stored at the preceding levels, empty if not required.
+	//! Not applicable in the support mode
+	string  delta{};
+	//! Min number of the inputs (files or archive entries) containing the cluster
+	//! to output it, > 1 means the clusters are output after processing all inputs
+	unsigned  support = 1;
+	//! The members are string labels (e.g. URLs), which are interned into the
+	//! dense ids, including the node base
+	bool  labels = false;
+	//! Remove the repeated members of each cluster retaining their first occurrences,
+	//! so the cluster is deduplicated with its clean twins
+	bool  dedupmbs = false;
+	//! Max expected length of the hashes chain of the clusters and the number of
+	//! the matched fingerprints in it, on exceeding which the matching fingerprints
+	//! of the chain are verified by the exact members
+	size_t  chainmax = 8;
+};
+
+//! Fingerprint index of the merged clusters, see fpindex.h
+class FingerprintIndex;
+//! Posting index of the merged clusters, see postings.h
+class PostingIndex;
+
+// Accessory functions ---------------------------------------------------------
+//! \brief Process each input file expanding the tar archives into their
+//! 	regular entries, which are streamed without the extraction
+//!
+//! \tparam Process  - file processing function: bool (NamedFileWrapper& file)
+//!
+//! \param files NamedFileWrappers&  - input files including the archives
+//! \param process Process  - file processing returning false on the fatal error
+//! \return bool  - all files are processed without the fatal errors, where
+//! 	a corrupted or truncated archive is the fatal error
+template <typename Process>
+bool forEachInput(NamedFileWrappers& files, Process process)
+{
+	for(auto& file: files) {
+		if(!TarReader::isArchive(file.name())) {
+			TraceSpan  span("input", "file", file.name());
+			if(!process(file))
+				return false;
+			continue;
+		}
+		TarReader  archive(file);
+		NamedFileWrapper  entry;
+		while(archive.next(entry)) {
+			TraceSpan  span("input", "file", entry.name());
+			if(!process(entry))
+				return false;
+		}
+		if(!archive.close())
+			return false;
+	}
+	return true;
+}
+
 // Interface functions ---------------------------------------------------------
 //! \brief Create output file if required
 //!
@@ -69,20 +158,24 @@ NamedFileWrappers openFiles(const FileNames& names);
 //! 	and optionally synchronizing with the node base (excluding non-listed nodes).
 //! 	Typically used to flatten a hierarchy or multiple resolutions.
 //! \note Clusters are unique respecting the order-independent members (node ids)
+//! \note The hierarchical delta (see MergeOptions::delta) is a CNL file having
+//! 	the header "# Delta Levels: <levels>, Clusters: <clusters>" and for each
+//! 	level (input) the line "# Level <index>: <input>" followed by the clusters
+//! 	first occurring at this level and the line "#@ <ordinal>..." of the 0-based
+//! 	ordinals (positions in the delta) of its clusters occurred earlier. The
+//! 	references follow the new clusters, so they may refer also to the clusters
+//! 	repeated within the level. The delta is loadable as the merged collection
+//! 	by the regular CNL readers, which skip the comments.
 //! \pre fout should be empty
 //!
 //! \param fout NamedFileWrapper&  - output file for the resulting collection
 //! \param files NamedFileWrappers&  - input collections
 //! \param fbase NamedFileWrapper&  - input node base for the synchronization,
 //! 	or an empty wrapper
-//! \param cmin=0 Id  - min allowed cluster size
-//! \param cmax=0 Id  - max allowed cluster size, 0 means any size
-//! \param membership=1.f float  - average membership of the node,
-//! 	> 0, typically ~= 1
+//! \param opts=MergeOptions() const MergeOptions&  - merging options
 //! \return bool  - the processing is successful
 bool mergeCollections(NamedFileWrapper& fout, NamedFileWrappers& files
-	, NamedFileWrapper& fbase, Id cmin=0, Id cmax=0
-	, float membership=1.f);
+	, NamedFileWrapper& fbase, const MergeOptions& opts=MergeOptions());
 
 //! \brief Extract the node base from the specified collections optionally
 //! 	prefiltering clusters by size
@@ -94,8 +187,42 @@ bool mergeCollections(NamedFileWrapper& fout, NamedFileWrappers& files
 //! \param cmax=0 Id  - max allowed cluster size, 0 means any size
 //! \param membership=1.f float  - average membership of the node,
 //! 	> 0, typically ~= 1
+//! \param threads=0 unsigned  - the number of worker threads, 0 means the number of CPUs
+//! \param labels=false bool  - the members are string labels, which are interned
+//! 	and output in the order of their first occurrence, where the parsing
+//! 	is sequential
 //! \return bool  - the processing is successful
 bool extractBase(NamedFileWrapper& fout, NamedFileWrappers& files
-	, Id cmin=0, Id cmax=0, float membership=1.f);
+	, Id cmin=0, Id cmax=0, float membership=1.f, unsigned threads=0, bool labels=false);
+
+//! \brief Lookup the query clusters in the merged collection by the fingerprint index
+//! \note Each query cluster yields a line: <file>:<line>\t<position>\t<offset>,
+//! 	where position is a 0-based index of the cluster in the merged collection and
+//! 	offset is the byte offset of its line, or "-" if the cluster is not present.
+//! 	The query clusters are matched as they are, i.e. they should be filtered
+//! 	the same way as the merged clusters (e.g. synchronized with the node base).
+//!
+//! \param fout NamedFileWrapper&  - output file for the lookup results
+//! \param files NamedFileWrappers&  - query collections
+//! \param index const FingerprintIndex&  - fingerprint index of the merged collection
+//! \return bool  - the processing is successful
+bool lookupClusters(NamedFileWrapper& fout, NamedFileWrappers& files
+	, const FingerprintIndex& index);
+
+//! \brief Find the best matches of the query clusters in the merged collection
+//! 	by the posting (node -> clusters) index
+//! \note Each query cluster yields a line: <file>:<line>[\t<position> <offset> <score>]...,
+//! 	where position is a 0-based index of the matching cluster in the merged collection,
+//! 	offset is the byte offset of its line and the matches are ordered by the scores.
+//! 	The clusters are considered as sets, i.e. the repeated members are omitted.
+//!
+//! \param fout NamedFileWrapper&  - output file for the matching results
+//! \param files NamedFileWrappers&  - query collections
+//! \param index const PostingIndex&  - posting index of the merged collection
+//! \param topk=1 unsigned  - the number of top matches for each query cluster
+//! \param f1=false bool  - score the matches by F1 instead of Jaccard index
+//! \return bool  - the processing is successful
+bool matchClusters(NamedFileWrapper& fout, NamedFileWrappers& files
+	, const PostingIndex& index, unsigned topk=1, bool f1=false);
 
 #endif // INTERFACE_H
@@ -0,0 +1,153 @@
+//! \brief Posting lists (node -> clusters) index of the merged clusters
+//! 	for the best matches search
+//!
+//! \license Apache License, Version 2.0: http://www.apache.org/licenses/LICENSE-2.0.html
+//! > 	Simple explanation: https://tldrlegal.com/license/apache-license-2.0-(apache-2.0)
+//!
+//! Copyright (c)
+//! \authr Artem Lutov
+//! \email luart@ya.ru
+//! \date 2026-10-18
+
+#ifndef POSTINGS_H
+#define POSTINGS_H
+
+#include "interface.h"
+
+
+// Index Types -----------------------------------------------------------------
+//! \brief Static index of the clusters by their member nodes in the CSR
+//! 	(compressed sparse row) format, which is memory mapped
+//! \note The index file consists of the header followed by the arrays:
+//! 	cluster offsets (uint64_t[clsnum]), node postings bounds (uint64_t[nodesnum + 1]),
+//! 	cluster sizes (Id[clsnum]) and postings (Id[postsnum]), where the postings
+//! 	of each node are cluster positions in the ascending order. The native byte
+//! 	order is used.
+class PostingIndex {
+public:
+	//! \brief Header of the index file
+	struct Header {
+		char  magic[8];  //!< Signature of the file format
+		uint32_t  version;  //!< Version of the file format
+		uint32_t  idsize;  //!< Size of the ids in bytes
+		uint64_t  nodesnum;  //!< The number of nodes (max node id + 1)
+		uint64_t  clsnum;  //!< The number of clusters
+		uint64_t  postsnum;  //!< The number of postings (unique members of all clusters)
+	};
+	constexpr static char  signature[sizeof Header::magic] = "RMPSIDX";  //!< Signature of the file format
+	constexpr static uint32_t  version = 1;  //!< Version of the file format
+
+	//! \brief Indexed clusters being formed
+	struct Clusters {
+		vector<uint64_t, CountingAllocator<uint64_t, MemUse::INDICES>>  offsets;  //!< Offsets of the cluster lines in the CNL file
+		vector<uint64_t, CountingAllocator<uint64_t, MemUse::INDICES>>  bounds;  //!< Bounds of the cluster members, starting from 0
+		vector<Id, CountingAllocator<Id, MemUse::INDICES>>  members;  //!< Unique members of each cluster
+
+		Clusters(): offsets(), bounds(1, 0), members()  {}
+
+	    //! \brief Add the cluster
+	    //!
+	    //! \param nodes const vector<Id>&  - member nodes, which might be repeated
+	    //! \param offset uint64_t  - offset of the cluster line in the CNL file
+	    //! \return void
+		void add(const vector<Id>& nodes, uint64_t offset);
+	};
+private:
+	MappedFile  m_file;  //!< Content of the index file
+	const uint64_t*  m_clsofs;  //!< Offsets of the cluster lines in the CNL file
+	const uint64_t*  m_bounds;  //!< Bounds of the node postings, nullptr if the index is invalid
+	const Id*  m_clsizes;  //!< Sizes of the clusters
+	const Id*  m_posts;  //!< Postings of the nodes
+	size_t  m_nodesnum;  //!< The number of nodes
+	size_t  m_clsnum;  //!< The number of clusters
+public:
+    //! \brief Constructor, maps and validates the index file
+    //!
+    //! \param file NamedFileWrapper&  - index file opened for reading
+	PostingIndex(NamedFileWrapper& file);
+
+    //! \brief Copy constructor
+	PostingIndex(const PostingIndex&)=delete;
+
+    //! \brief Copy assignment
+	PostingIndex& operator= (const PostingIndex&)=delete;
+
+    //! \brief Whether the index has been loaded
+	explicit operator bool() const noexcept  { return m_bounds; }
+
+    //! \brief The number of indexed clusters
+	size_t clusters() const noexcept  { return m_clsnum; }
+
+    //! \brief Offset of the cluster line in the CNL file
+	uint64_t offset(Id cpos) const noexcept  { return m_clsofs[cpos]; }
+
+    //! \brief The number of unique members of the cluster
+	Id size(Id cpos) const noexcept  { return m_clsizes[cpos]; }
+
+    //! \brief Begin of the node postings (ascending cluster positions)
+	const Id* begin(Id nid) const noexcept
+		{ return nid < m_nodesnum ? m_posts + m_bounds[nid] : nullptr; }
+
+    //! \brief End of the node postings
+	const Id* end(Id nid) const noexcept
+		{ return nid < m_nodesnum ? m_posts + m_bounds[nid + 1] : nullptr; }
+
+    //! \brief Save the index of the clusters
+    //! \note The index is formed in the temporary file and then renamed to not
+    //! 	expose partially formed index
+    //!
+    //! \param name const string&  - name of the index file
+    //! \param clusters const Clusters&  - indexed clusters
+    //! \param group=nullptr daoc::OutputGroup*  - group of the outputs, which
+    //! 	renames the index on its commit rather than immediately
+    //! \return bool  - whether the index has been saved
+	static bool save(const string& name, const Clusters& clusters, daoc::OutputGroup* group=nullptr);
+};
+
+//! \brief Best matches search of the query clusters in the posting index
+//! \note The candidate clusters are scored by the postings of the query nodes
+//! 	processed from the shortest lists. As soon as the top matches can't be
+//! 	outperformed by the unseen clusters, the remaining (long) postings are
+//! 	only probed for the remaining promising candidates.
+class ClusterMatcher {
+public:
+	//! \brief Matching cluster
+	struct Match {
+		Id  pos;  //!< Position (0-based index) of the cluster in the CNL file
+		Id  inter;  //!< The number of shared nodes with the query
+		float  score;  //!< Similarity score
+	};
+
+	//! Matching clusters
+	using Matches = vector<Match>;
+private:
+	const PostingIndex&  m_index;  //!< Posting index
+	bool  m_f1;  //!< Use F1 score instead of Jaccard index
+	vector<Id>  m_inters;  //!< Intersections of the candidates with the query by the cluster positions
+	vector<Id>  m_cands;  //!< Candidate clusters
+	vector<float>  m_scores;  //!< Scores of the candidates
+public:
+    //! \brief Constructor
+    //!
+    //! \param index const PostingIndex&  - posting index of the clusters
+    //! \param f1=false bool  - use F1 score instead of Jaccard index
+	ClusterMatcher(const PostingIndex& index, bool f1=false);
+
+    //! \brief Similarity score of the clusters
+    //!
+    //! \param inter Id  - the number of shared nodes
+    //! \param qsize size_t  - the number of unique nodes in the query cluster
+    //! \param csize Id  - the number of unique nodes in the indexed cluster
+    //! \return float  - similarity score, [0, 1]
+	float score(Id inter, size_t qsize, Id csize) const noexcept
+		{ return m_f1 ? 2.f * inter / (qsize + csize) : float(inter) / (qsize + csize - inter); }
+
+    //! \brief Find the top matching clusters
+    //!
+    //! \param nodes vector<Id>&  - nodes of the query cluster, which are reordered and deduplicated
+    //! \param topk unsigned  - the number of top matches, >= 1
+    //! \return Matches  - the top matches in the descending order of scores
+	Matches match(vector<Id>& nodes, unsigned topk);
+};
+
+#endif // POSTINGS_H
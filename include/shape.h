@@ -0,0 +1,49 @@
+//! \brief Workload shape profiling of the CNL files and generation of the
+//! 	look-alike synthetic clusterings by the profile
+//!
+//! \license Apache License, Version 2.0: http://www.apache.org/licenses/LICENSE-2.0.html
+//! > 	Simple explanation: https://tldrlegal.com/license/apache-license-2.0-(apache-2.0)
+//!
+//! Copyright (c)
+//! \authr Artem Lutov
+//! \email luart@ya.ru
+//! \date 2026-10-18
+
+#ifndef SHAPE_H
+#define SHAPE_H
+
+#include "interface.h"
+
+
+// Shape functions -------------------------------------------------------------
+//! \brief Profile the shape of the input clusterings outputting the anonymized
+//! 	statistics, which do not contain any node ids
+//! \note Each input (file or archive entry) is a level of the profile having:
+//! 	the numbers of clusters, members and unique nodes (so the membership or
+//! 	overlap of the nodes), the range of the node ids, the number of the clusters
+//! 	present in the preceding inputs (duplicates), the distribution of the
+//! 	cluster sizes by log2 bins and the line format. The corpus has the range
+//! 	and the number of the unique node ids (density).
+//!
+//! \param fout NamedFileWrapper&  - output file for the shape profile
+//! \param files NamedFileWrappers&  - profiling collections including the archives
+//! \return bool  - the processing is successful
+bool profileShape(NamedFileWrapper& fout, NamedFileWrappers& files);
+
+//! \brief Generate the synthetic clusterings statistically similar to the
+//! 	profiled ones, a file per level of the profile
+//! \note The node ids are spread uniformly over the profiled range with the
+//! 	profiled density. The members of each level are drawn from its nodes
+//! 	without repetition until all of them are used, so the membership of the
+//! 	nodes follows the profile. The duplicates are copied from the preceding
+//! 	level. The generation is deterministic for the same profile and seed.
+//!
+//! \param fprofile NamedFileWrapper&  - shape profile, see profileShape()
+//! \param outdir const string&  - output directory
+//! \param seed=0 uint64_t  - seed of the random generator
+//! \param rewrite=false bool  - whether to rewrite the existing files
+//! \return bool  - the processing is successful
+bool generateCorpus(NamedFileWrapper& fprofile, const string& outdir, uint64_t seed=0
+	, bool rewrite=false);
+
+#endif // SHAPE_H
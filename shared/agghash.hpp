@@ -16,7 +16,7 @@
 #include <string>  // uintX_t
 #include <functional>  // hash
 //#include <cstring>  // memcmp
-#include <type_traits>  // is_integral
+#include <type_traits>  // is_integral, make_unsigned
 #include <limits>  // numeric_limits
 #include <stdexcept> // numeric_limits
 
@@ -50,9 +50,20 @@ class AggHash {
 	AccId  m_size;  //!< Size of the container
 	AccId  m_idsum;  //!< Sum of the member ids
 	AccId  m_id2sum;  //!< Sum of the squared member ids
+
+	//! Key of the ids mixing shared by all aggregations, 0 means the plain ids
+	static AccId  s_key;
 protected:
 	//! Id correction to prevent collisions
 	constexpr static Id  idcor = sqrt(numeric_limits<Id>::max());
+
+	//! \brief Keyed bijective mixing of the id
+	//! \note Distinct ids remain distinct, but the collisions of the aggregations
+	//! 	become unpredictable without the key
+	//!
+	//! \param id Id  - id to be mixed
+	//! \return AccId  - the mixed id in the range of the Id type
+	static AccId mix(Id id) noexcept;
 public:
 	// Export the template parameter types
 	using IdT = Id;  //!< Type of the member ids
@@ -62,9 +73,24 @@ public:
 	AggHash() noexcept
 	: m_size(0), m_idsum(0), m_id2sum(0) {}
 
+	//! \brief Key of the ids mixing
+	//!
+	//! \return AccId  - the key, 0 means the plain ids
+	static AccId key() noexcept  { return s_key; }
+
+	//! \brief Set the key of the ids mixing
+	//! \pre The aggregations being compared should be formed with the same key,
+	//! 	so the key is set before the aggregations are formed
+	//!
+	//! \param key AccId  - the key, 0 means the plain ids (unkeyed aggregations)
+	//! \return void
+	static void key(AccId key) noexcept  { s_key = key; }
+
 	//! \brief Add id to the aggregation
 	//! \note In case correction is used and id becomes out of range (initial id > IDMAX - IDCORR)
-	//! 	then an exception is thrown, which crashes the whole application, which is OK
+	//! 	then an exception is thrown, which crashes the whole application, which is OK.
+	//! 	The keyed aggregation mixes the id and accumulates it modulo the AccId range
+	//! 	without the overflow checking.
 	//!
 	//! \param id Id  - id to be included into the hash
 	//! \return void
@@ -75,6 +101,14 @@ public:
 	//! \return void
 	void clear() noexcept;
 
+	//! \brief Combine with the aggregation of the disjoint part of ids
+	//! \note The aggregation is associative and commutative, so the parts of
+	//! 	a container can be hashed independently (e.g. in parallel) and combined
+	//!
+	//! \param ah const AggHash&  - the aggregation to be included
+	//! \return AggHash&  - self
+	inline AggHash& operator +=(const AggHash& ah) noexcept;
+
 	//! \brief Number of the aggregated ids
 	//!
 	//! \return size_t  - number of the aggregated ids
@@ -138,11 +172,36 @@ public:
 };
 
 // Type Definitions ----------------------------------------------------
+template <typename Id, typename AccId>
+AccId AggHash<Id, AccId>::s_key = 0;
+
+template <typename Id, typename AccId>
+AccId AggHash<Id, AccId>::mix(Id id) noexcept
+{
+	// Note: each step is a bijection in the range of the Id type: xor with
+	// a constant, multiplication by an odd constant and xor with the high part
+	using UId = typename std::make_unsigned<Id>::type;
+	constexpr unsigned  hbits = numeric_limits<UId>::digits / 2;  // Shift to the high part
+	UId  val = static_cast<UId>(id) ^ static_cast<UId>(s_key);
+	val *= static_cast<UId>(s_key >> numeric_limits<UId>::digits) | 1;
+	val ^= val >> hbits;
+	val *= static_cast<UId>(0x45D9F3B);  // Odd constant of the avalanche mixing
+	val ^= val >> hbits;
+	return val;
+}
+
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wterminate"  // Disable the warning about the exception throwing function marked as noexcept
 template <typename Id, typename AccId>
 void AggHash<Id, AccId>::add(Id id) noexcept
 {
+	if(s_key) {
+		const AccId  val = mix(id) + idcor;
+		++m_size;
+		m_idsum += val;
+		m_id2sum += val * val;
+		return;
+	}
 	id += idcor;  // Correct id to prevent collisions (see AgordiHash for details)
 	// Check for the overflow after the correction
     // Note: the exception will crash the whole app since noexcept is used but it is fine
@@ -163,6 +222,15 @@ void AggHash<Id, AccId>::clear() noexcept
 	m_id2sum = 0;
 }
 
+template <typename Id, typename AccId>
+AggHash<Id, AccId>& AggHash<Id, AccId>::operator +=(const AggHash& ah) noexcept
+{
+	m_size += ah.m_size;
+	m_idsum += ah.m_idsum;
+	m_id2sum += ah.m_id2sum;
+	return *this;
+}
+
 template <typename Id, typename AccId>
 size_t AggHash<Id, AccId>::hash() const
 {
@@ -0,0 +1,460 @@
+//! \brief Apache Arrow IPC file (Feather v2) writer of the clusters, which
+//! 	is self-contained (does not require the Arrow library)
+//!
+//! \license Apache License, Version 2.0: http://www.apache.org/licenses/LICENSE-2.0.html
+//! > 	Simple explanation: https://tldrlegal.com/license/apache-license-2.0-(apache-2.0)
+//!
+//! Copyright (c)
+//! \authr Artem Lutov
+//! \email luart@ya.ru
+//! \date 2026-10-18
+
+#include <cstring>  // memcpy
+#include <limits>
+#include <algorithm>  // max
+#include <initializer_list>
+
+#include "arrowio.hpp"
+
+
+namespace daoc {
+
+using std::initializer_list;
+using std::numeric_limits;
+
+// Internal types --------------------------------------------------------------
+//! \brief Minimal builder of the FlatBuffers, which forms the buffer from the
+//! 	beginning, so the referenced objects follow the referencing ones
+//! \note The referencing slots (uoffset_t) are patched when the referenced
+//! 	objects are formed. The buffer is 8-byte aligned.
+class FlatBuilder {
+	string  m_buf;  //!< Forming buffer
+public:
+	//! \brief Inline field of the table
+	struct Field {
+		uint8_t  size;  //!< Size of the inline value in bytes, 0 means absent field
+		uint64_t  val;  //!< Scalar value
+		bool  ref;  //!< The field is a slot referencing the object (uoffset_t)
+	};
+
+	//! \brief Scalar field
+	static Field scalar(uint8_t size, uint64_t val) noexcept  { return {size, val, false}; }
+
+	//! \brief Referencing field
+	static Field ref() noexcept  { return {sizeof(uint32_t), 0, true}; }
+
+	//! \brief Absent field
+	static Field absent() noexcept  { return {0, 0, false}; }
+
+	//! \brief Constructor, reserves the slot of the root table
+	FlatBuilder(): m_buf(sizeof(uint32_t), 0)  {}
+
+	//! \brief Formed buffer padded to 8 bytes
+	const string& buffer()
+	{
+		align(8);
+		return m_buf;
+	}
+
+	//! \brief Set the root table
+	void root(size_t table)  { patch(0, table); }
+
+	//! \brief Patch the referencing slot by the object position
+	//!
+	//! \param slot size_t  - position of the slot
+	//! \param target size_t  - position of the object, which follows the slot
+	//! \return void
+	void patch(size_t slot, size_t target)
+	{
+		const uint32_t  ofs = target - slot;
+		memcpy(&m_buf[slot], &ofs, sizeof ofs);
+	}
+
+	//! \brief Add the table
+	//!
+	//! \param fields initializer_list<Field>  - fields of the table in the order of their ids
+	//! \param slots vector<size_t>&  - resulting positions of the referencing fields by their ids
+	//! \return size_t  - position of the table
+	size_t table(initializer_list<Field> fields, vector<size_t>& slots)
+	{
+		// Layout the fields after the vtable offset in the descending order of their sizes
+		vector<uint16_t>  fofs(fields.size(), 0);  // Offsets of the fields in the table
+		size_t  tsize = sizeof(int32_t);  // Size of the table
+		for(uint8_t fsize: {8, 4, 2, 1}) {
+			size_t  i = 0;
+			for(const auto& fld: fields) {
+				if(fld.size == fsize) {
+					tsize = (tsize + fsize - 1) / fsize * fsize;
+					fofs[i] = tsize;
+					tsize += fsize;
+				}
+				++i;
+			}
+		}
+		// Vtable
+		align(sizeof(uint16_t));
+		const size_t  vpos = m_buf.size();
+		put<uint16_t>(sizeof(uint16_t) * (2 + fields.size()));
+		put<uint16_t>(tsize);
+		for(auto ofs: fofs)
+			put<uint16_t>(ofs);
+		// Table
+		align(8);
+		const size_t  tpos = m_buf.size();
+		m_buf.resize(tpos + tsize, 0);
+		const int32_t  vofs = tpos - vpos;
+		memcpy(&m_buf[tpos], &vofs, sizeof vofs);
+		slots.assign(fields.size(), 0);
+		size_t  i = 0;
+		for(const auto& fld: fields) {
+			if(fld.ref)
+				slots[i] = tpos + fofs[i];
+			else if(fld.size)
+				// Note: the little-endian order is assumed
+				memcpy(&m_buf[tpos + fofs[i]], &fld.val, fld.size);
+			++i;
+		}
+		return tpos;
+	}
+
+	//! \brief Add the vector of references
+	//!
+	//! \param num size_t  - the number of references
+	//! \return size_t  - position of the vector, the slots follow the length
+	size_t refs(size_t num)
+	{
+		align(sizeof(uint32_t));
+		const size_t  pos = m_buf.size();
+		put<uint32_t>(num);
+		m_buf.resize(m_buf.size() + num * sizeof(uint32_t), 0);
+		return pos;
+	}
+
+	//! \brief Add the vector of structs
+	//!
+	//! \param data const void*  - the structs
+	//! \param num size_t  - the number of structs
+	//! \param size size_t  - size of the struct
+	//! \param alignment=8 size_t  - alignment of the structs
+	//! \return size_t  - position of the vector
+	size_t structs(const void* data, size_t num, size_t size, size_t alignment=8)
+	{
+		// Align the elements following the length
+		align(sizeof(uint32_t));
+		while((m_buf.size() + sizeof(uint32_t)) % alignment)
+			m_buf.push_back(0);
+		const size_t  pos = m_buf.size();
+		put<uint32_t>(num);
+		m_buf.append(static_cast<const char*>(data), num * size);
+		return pos;
+	}
+
+	//! \brief Add the string
+	//!
+	//! \param str const char*  - the string
+	//! \return size_t  - position of the string
+	size_t text(const char* str)
+	{
+		align(sizeof(uint32_t));
+		const size_t  pos = m_buf.size();
+		const size_t  len = strlen(str);
+		put<uint32_t>(len);
+		m_buf.append(str, len + 1);  // Note: including the null terminator
+		return pos;
+	}
+protected:
+	//! \brief Pad the buffer to the alignment
+	void align(size_t alignment)
+	{
+		m_buf.resize((m_buf.size() + alignment - 1) / alignment * alignment, 0);
+	}
+
+	//! \brief Append the scalar
+	template <typename T>
+	void put(T val)  { m_buf.append(reinterpret_cast<const char*>(&val), sizeof val); }
+};
+
+//! \brief Arrow format constants
+namespace arrow {
+
+constexpr char  magic[] = "ARROW1";  //!< File signature
+constexpr uint32_t  contmark = 0xFFFFFFFF;  //!< Continuation marker of the encapsulated message
+constexpr uint16_t  metaver = 4;  //!< Metadata version V5
+// MessageHeader union tags
+constexpr uint8_t  hdrSchema = 1;  //!< Schema message
+constexpr uint8_t  hdrRecordBatch = 3;  //!< Record batch message
+// Type union tags
+constexpr uint8_t  typeInt = 2;  //!< Integer
+constexpr uint8_t  typeUtf8 = 5;  //!< UTF-8 string
+constexpr uint8_t  typeList = 12;  //!< List
+
+//! \brief Field of the schema
+struct SchemaField {
+	const char*  name;  //!< Name of the field
+	uint8_t  type;  //!< Type union tag
+	vector<SchemaField>  children;  //!< Child fields
+};
+
+//! \brief Field node of the record batch
+struct FieldNode {
+	int64_t  length;  //!< The number of values
+	int64_t  nulls;  //!< The number of nulls
+};
+
+//! \brief Buffer of the record batch body
+struct Buffer {
+	int64_t  offset;  //!< Offset in the body
+	int64_t  length;  //!< Length in bytes without the padding
+};
+
+}  // arrow
+
+// Internal functions ----------------------------------------------------------
+//! \brief Add the field of the schema
+//!
+//! \param fb FlatBuilder&  - the builder
+//! \param fld const arrow::SchemaField&  - the field
+//! \return size_t  - position of the field table
+static size_t addField(FlatBuilder& fb, const arrow::SchemaField& fld)
+{
+	using FB = FlatBuilder;
+	vector<size_t>  slots;
+	// Fields: name, nullable, type_type, type, dictionary, children
+	const size_t  tpos = fb.table({FB::ref(), FB::scalar(1, false), FB::scalar(1, fld.type)
+		, FB::ref(), FB::absent(), FB::ref()}, slots);
+	const vector<size_t>  fslots = slots;
+	fb.patch(fslots[0], fb.text(fld.name));
+	// Note: the unsigned 32-bit integers are the only integer type in the schema
+	fb.patch(fslots[3], fld.type == arrow::typeInt
+		? fb.table({FB::scalar(4, 32), FB::scalar(1, false)}, slots)  // bitWidth, is_signed
+		: fb.table({}, slots));
+	const size_t  vpos = fb.refs(fld.children.size());
+	fb.patch(fslots[5], vpos);
+	for(size_t i = 0; i < fld.children.size(); ++i)
+		fb.patch(vpos + sizeof(uint32_t) * (i + 1), addField(fb, fld.children[i]));
+	return tpos;
+}
+
+//! \brief Add the schema
+//!
+//! \param fb FlatBuilder&  - the builder
+//! \param meta bool  - include the id, source and size columns
+//! \return size_t  - position of the schema table
+static size_t addSchema(FlatBuilder& fb, bool meta)
+{
+	using FB = FlatBuilder;
+	vector<arrow::SchemaField>  fields = {{"members", arrow::typeList, {{"item", arrow::typeInt, {}}}}};
+	if(meta) {
+		fields.push_back({"id", arrow::typeInt, {}});
+		fields.push_back({"source", arrow::typeUtf8, {}});
+		fields.push_back({"size", arrow::typeInt, {}});
+	}
+	vector<size_t>  slots;
+	// Fields: endianness (Little), fields
+	const size_t  tpos = fb.table({FB::scalar(2, 0), FB::ref()}, slots);
+	const size_t  vpos = fb.refs(fields.size());
+	fb.patch(slots[1], vpos);
+	for(size_t i = 0; i < fields.size(); ++i)
+		fb.patch(vpos + sizeof(uint32_t) * (i + 1), addField(fb, fields[i]));
+	return tpos;
+}
+
+//! \brief Form the message metadata with the header table
+//!
+//! \tparam AddHeader  - header formation: size_t (FlatBuilder& fb)
+//!
+//! \param hdrtype uint8_t  - type of the message header
+//! \param bodylen int64_t  - length of the message body
+//! \param addHeader AddHeader  - the header formation returning its position
+//! \return string  - the message flatbuffer
+template <typename AddHeader>
+static string message(uint8_t hdrtype, int64_t bodylen, AddHeader addHeader)
+{
+	using FB = FlatBuilder;
+	FlatBuilder  fb;
+	vector<size_t>  slots;
+	// Fields: version, header_type, header, bodyLength
+	fb.root(fb.table({FB::scalar(2, arrow::metaver), FB::scalar(1, hdrtype), FB::ref()
+		, FB::scalar(8, bodylen)}, slots));
+	const size_t  hslot = slots[2];
+	fb.patch(hslot, addHeader(fb));
+	return fb.buffer();
+}
+
+// Arrow Types definitions -----------------------------------------------------
+static_assert(sizeof(ArrowWriter::Block) == 24 && sizeof(arrow::FieldNode) == 16
+	&& sizeof(arrow::Buffer) == 16, "ArrowWriter, the structs should not have padding");
+#if __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "ArrowWriter, the little-endian platform is required"
+#endif // __BYTE_ORDER__
+
+ArrowWriter::ArrowWriter(const string& name, bool meta, size_t batchrows, size_t batchmbs)
+: m_file(), m_name(name)
+, m_tmpname(OutputGroup::tmpName(name))
+, m_meta(meta)
+, m_batchrows(std::max<size_t>(batchrows, 1)), m_batchmbs(batchmbs), m_fpos(0), m_rows(0)
+, m_blocks(), m_mbofs(1, 0), m_mbrs(), m_srcofs(1, 0), m_srcs()
+{
+	m_file.reset(fopen(m_tmpname.c_str(), "wb"));
+	if(!m_file) {
+		perror(("ERROR ArrowWriter(), the file can't be created: " + m_tmpname).c_str());
+		m_tmpname.clear();
+		return;
+	}
+	write(arrow::magic, sizeof arrow::magic - 1, 8);
+	writeMessage(message(arrow::hdrSchema, 0, [this](FlatBuilder& fb) {
+		return addSchema(fb, m_meta);
+	}));
+}
+
+ArrowWriter::~ArrowWriter()
+{
+	if(!m_tmpname.empty())
+		close();
+}
+
+bool ArrowWriter::add(const vector<uint32_t>& mbrs, const string& source)
+{
+	if(!m_file)
+		return false;
+	m_mbrs.insert(m_mbrs.end(), mbrs.begin(), mbrs.end());
+	m_mbofs.push_back(m_mbrs.size());
+	if(m_meta) {
+		m_srcs += source;
+		m_srcofs.push_back(m_srcs.size());
+	}
+	return (m_mbofs.size() <= m_batchrows && m_mbrs.size() < m_batchmbs) || flush();
+}
+
+bool ArrowWriter::close(OutputGroup* group)
+{
+	if(m_tmpname.empty())
+		return false;
+	bool  res = flush();
+	// End of the stream
+	const uint32_t  eos[] = {arrow::contmark, 0};
+	res = res && write(eos, sizeof eos);
+
+	// Footer
+	using FB = FlatBuilder;
+	FlatBuilder  fb;
+	vector<size_t>  slots;
+	// Fields: version, schema, dictionaries, recordBatches
+	fb.root(fb.table({FB::scalar(2, arrow::metaver), FB::ref(), FB::ref(), FB::ref()}, slots));
+	const vector<size_t>  fslots = slots;
+	fb.patch(fslots[1], addSchema(fb, m_meta));
+	fb.patch(fslots[2], fb.structs(nullptr, 0, sizeof(Block)));
+	fb.patch(fslots[3], fb.structs(m_blocks.data(), m_blocks.size(), sizeof(Block)));
+	const string&  footer = fb.buffer();
+	const int32_t  ftlen = footer.size();
+	res = res && write(footer.data(), footer.size()) && write(&ftlen, sizeof ftlen)
+		&& write(arrow::magic, sizeof arrow::magic - 1);
+	if(m_file && fclose(m_file.release()))
+		res = false;
+	// Note: the grouped file is renamed on the commit of the group
+	if(res && group)
+		group->add(m_tmpname, m_name);
+	else res = res && !rename(m_tmpname.c_str(), m_name.c_str());
+	if(!res) {
+		fprintf(stderr, "ERROR ArrowWriter::close(), '%s' can't be formed\n", m_name.c_str());
+		remove(m_tmpname.c_str());
+	}
+	m_tmpname.clear();
+	return res;
+}
+
+bool ArrowWriter::flush()
+{
+	TraceSpan  span("output", "flush", m_name);
+	const size_t  rows = m_mbofs.size() - 1;
+	if(!rows || !m_file)
+		return m_file;
+	if(m_mbrs.size() > size_t(numeric_limits<int32_t>::max())) {
+		fprintf(stderr, "ERROR ArrowWriter::flush(), the number of members %lu exceeds"
+			" the range of the list offsets\n", m_mbrs.size());
+		m_file.reset();
+		return false;
+	}
+	// Buffers of the body: the validity bitmaps are omitted for the non-nullable columns
+	vector<uint32_t>  ids;  // Ids of the clusters
+	vector<uint32_t>  sizes;  // Sizes of the clusters
+	vector<const void*>  data;  // Data of the buffers
+	vector<arrow::Buffer>  bufs;  // Buffers of the body
+	vector<arrow::FieldNode>  nodes = {{int64_t(rows), 0}, {int64_t(m_mbrs.size()), 0}};
+	int64_t  bodylen = 0;
+	auto  addBuffer = [&](const void* dat, size_t len) {
+		data.push_back(dat);
+		bufs.push_back({bodylen, int64_t(len)});
+		bodylen += (len + 7) / 8 * 8;
+	};
+	addBuffer(nullptr, 0);
+	addBuffer(m_mbofs.data(), m_mbofs.size() * sizeof(int32_t));
+	addBuffer(nullptr, 0);
+	addBuffer(m_mbrs.data(), m_mbrs.size() * sizeof(uint32_t));
+	if(m_meta) {
+		ids.reserve(rows);
+		sizes.reserve(rows);
+		for(size_t i = 0; i < rows; ++i) {
+			ids.push_back(m_rows + i);
+			sizes.push_back(m_mbofs[i + 1] - m_mbofs[i]);
+		}
+		nodes.insert(nodes.end(), 3, {int64_t(rows), 0});
+		addBuffer(nullptr, 0);
+		addBuffer(ids.data(), ids.size() * sizeof(uint32_t));
+		addBuffer(nullptr, 0);
+		addBuffer(m_srcofs.data(), m_srcofs.size() * sizeof(int32_t));
+		addBuffer(m_srcs.data(), m_srcs.size());
+		addBuffer(nullptr, 0);
+		addBuffer(sizes.data(), sizes.size() * sizeof(uint32_t));
+	}
+
+	const int64_t  offset = m_fpos;
+	const int32_t  metalen = writeMessage(message(arrow::hdrRecordBatch, bodylen, [&](FlatBuilder& fb) {
+		using FB = FlatBuilder;
+		vector<size_t>  slots;
+		// Fields: length, nodes, buffers
+		const size_t  tpos = fb.table({FB::scalar(8, rows), FB::ref(), FB::ref()}, slots);
+		const vector<size_t>  rslots = slots;
+		fb.patch(rslots[1], fb.structs(nodes.data(), nodes.size(), sizeof(arrow::FieldNode)));
+		fb.patch(rslots[2], fb.structs(bufs.data(), bufs.size(), sizeof(arrow::Buffer)));
+		return tpos;
+	}));
+	bool  res = metalen;
+	for(size_t i = 0; res && i < bufs.size(); ++i)
+		res = write(data[i], bufs[i].length, 8);
+	if(res)
+		m_blocks.push_back({offset, metalen, 0, bodylen});
+
+	m_rows += rows;
+	m_mbofs.assign(1, 0);
+	m_mbrs.clear();
+	m_srcofs.assign(1, 0);
+	m_srcs.clear();
+	return res;
+}
+
+bool ArrowWriter::write(const void* data, size_t size, size_t align)
+{
+	if(!m_file)
+		return false;
+	constexpr char  zeros[8] = {0};
+	const size_t  pad = (align - (m_fpos + size) % align) % align;
+	if((size && fwrite(data, 1, size, m_file) != size) || (pad && fwrite(zeros, 1, pad, m_file) != pad)) {
+		perror(("ERROR ArrowWriter::write(), writing to " + m_name + " failed").c_str());
+		m_file.reset();
+		return false;
+	}
+	m_fpos += size + pad;
+	return true;
+}
+
+int32_t ArrowWriter::writeMessage(const string& meta)
+{
+	// Note: the metadata is padded to have the body 8-byte aligned
+	const uint32_t  prefix[] = {arrow::contmark, uint32_t(meta.size())};
+	if(!write(prefix, sizeof prefix) || !write(meta.data(), meta.size(), 8))
+		return 0;
+	return sizeof prefix + meta.size();
+}
+
+}  // daoc
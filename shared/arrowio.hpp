@@ -0,0 +1,122 @@
+//! \brief Apache Arrow IPC file (Feather v2) writer of the clusters, which
+//! 	is self-contained (does not require the Arrow library)
+//!
+//! \license Apache License, Version 2.0: http://www.apache.org/licenses/LICENSE-2.0.html
+//! > 	Simple explanation: https://tldrlegal.com/license/apache-license-2.0-(apache-2.0)
+//!
+//! Copyright (c)
+//! \authr Artem Lutov
+//! \email luart@ya.ru
+//! \date 2026-10-18
+
+#ifndef ARROWIO_HPP
+#define ARROWIO_HPP
+
+#include <cstdint>  // uintX_t
+#include <string>
+#include <vector>
+
+#include "fileio.hpp"
+#include "finalize.hpp"
+
+
+namespace daoc {
+
+using std::string;
+using std::vector;
+
+// Arrow Types -----------------------------------------------------------------
+//! \brief Writer of the clusters to the Arrow IPC file by the record batches
+//! \note The schema consists of the members column (list<uint32>) and
+//! 	optionally the id (uint32, 0-based position of the cluster), source
+//! 	(utf8, name of the input file) and size (uint32, the number of members)
+//! 	columns. The columns are non-nullable, the buffers are 8-byte aligned,
+//! 	so the file can be memory mapped by the readers without copying.
+//! 	The file is formed in the temporary file and then renamed on closing to
+//! 	not expose partially formed output.
+class ArrowWriter {
+public:
+	//! \brief Block of the record batch in the file
+	struct Block {
+		int64_t  offset;  //!< Offset of the message in the file
+		int32_t  metalen;  //!< Length of the message metadata including the prefix and padding
+		int32_t  pad;  //!< Padding, 0
+		int64_t  bodylen;  //!< Length of the message body
+	};
+private:
+	FileWrapper  m_file;  //!< Output file
+	string  m_name;  //!< Name of the output file
+	string  m_tmpname;  //!< Name of the forming file, empty when closed
+	bool  m_meta;  //!< Output the id, source and size columns
+	size_t  m_batchrows;  //!< Max number of rows in the record batch
+	size_t  m_batchmbs;  //!< Max number of members in the record batch
+	uint64_t  m_fpos;  //!< Current position in the file
+	uint64_t  m_rows;  //!< The number of written rows
+	vector<Block>  m_blocks;  //!< Written record batches
+	// Columns of the forming record batch
+	vector<int32_t>  m_mbofs;  //!< Offsets of the members of each row
+	vector<uint32_t>  m_mbrs;  //!< Members
+	vector<int32_t>  m_srcofs;  //!< Offsets of the source names of each row
+	string  m_srcs;  //!< Source names
+public:
+    //! \brief Constructor, creates the temporary file and writes the schema
+    //!
+    //! \param name const string&  - name of the output file
+    //! \param meta=false bool  - output the id, source and size columns
+    //! \param batchrows=1<<16 size_t  - max number of rows in the record batch
+    //! \param batchmbs=1<<22 size_t  - max number of members in the record batch
+	ArrowWriter(const string& name, bool meta=false, size_t batchrows=1<<16
+		, size_t batchmbs=1<<22);
+
+    //! \brief Copy constructor
+	ArrowWriter(const ArrowWriter&)=delete;
+
+    //! \brief Copy assignment
+	ArrowWriter& operator= (const ArrowWriter&)=delete;
+
+    //! \brief Destructor, closes the file if has not been closed
+	~ArrowWriter();
+
+    //! \brief Whether the file is opened and has no writing errors
+	explicit operator bool() const noexcept  { return m_file; }
+
+    //! \brief Name of the output file
+	const string& name() const noexcept  { return m_name; }
+
+    //! \brief Add the cluster
+    //!
+    //! \param mbrs const vector<uint32_t>&  - members of the cluster
+    //! \param source const string&  - name of the source (input file)
+    //! \return bool  - the cluster is added without the writing errors
+	bool add(const vector<uint32_t>& mbrs, const string& source);
+
+    //! \brief Write the remained rows and the footer closing and renaming the file
+    //!
+    //! \param group=nullptr OutputGroup*  - group of the outputs, which renames
+    //! 	the file on its commit rather than immediately
+    //! \return bool  - the file is written without the errors
+	bool close(OutputGroup* group=nullptr);
+protected:
+    //! \brief Write the record batch of the accumulated rows
+    //!
+    //! \return bool  - the batch is written without the errors
+	bool flush();
+
+    //! \brief Write the data to the file
+    //!
+    //! \param data const void*  - the data
+    //! \param size size_t  - the number of bytes
+    //! \param align=1 size_t  - alignment of the end of the written data, the padding is zeros
+    //! \return bool  - the data is written without the errors
+	bool write(const void* data, size_t size, size_t align=1);
+
+    //! \brief Write the encapsulated message metadata
+    //!
+    //! \param meta const string&  - the message flatbuffer
+    //! \return int32_t  - the written length including the prefix and padding, 0 on error
+	int32_t writeMessage(const string& meta);
+};
+
+}  // daoc
+
+#endif // ARROWIO_HPP
@@ -0,0 +1,71 @@
+//! \brief Diagnostics of the input data issues, which are counted per category
+//! 	in the hot loops and reported once as a summary
+//!
+//! \license Apache License, Version 2.0: http://www.apache.org/licenses/LICENSE-2.0.html
+//! > 	Simple explanation: https://tldrlegal.com/license/apache-license-2.0-(apache-2.0)
+//!
+//! Copyright (c)
+//! \authr Artem Lutov
+//! \email luart@ya.ru
+//! \date 2026-10-18
+
+#include <cstring>  // strnlen
+
+#include "diagnostics.hpp"
+
+
+namespace daoc {
+
+using std::lock_guard;
+
+//! Descriptions of the issue categories
+static const char* const  issueDescrs[Diagnostics::issuesNum] = {
+	"empty clusters are skipped",
+	"node ids can't be converted and are skipped",
+	"invalid links are omitted"
+};
+
+// Diagnostics Types definitions -----------------------------------------------
+Diagnostics::Diagnostics(unsigned exmax) noexcept
+: m_counts(), m_examples(), m_mutex(), m_exmax(exmax)
+{}
+
+Diagnostics& Diagnostics::global() noexcept
+{
+	static Diagnostics  diags;
+	return diags;
+}
+
+void Diagnostics::capture(Issue issue, const string& file, size_t line, const char* text
+, size_t len)
+{
+	constexpr size_t  textmax = 48;  // Max length of the captured text
+	const size_t  tlen = text ? strnlen(text, std::min(len, textmax)) : 0;
+	lock_guard<mutex>  lock(m_mutex);
+	auto&  examples = m_examples[static_cast<unsigned>(issue)];
+	if(examples.size() < m_exmax)
+		examples.push_back({file, line, string(text, tlen)});
+}
+
+size_t Diagnostics::summary(FILE* fout)
+{
+	size_t  total = 0;  // The total number of issues
+	for(unsigned i = 0; i < issuesNum; ++i) {
+		const size_t  num = m_counts[i].exchange(0, std::memory_order_relaxed);
+		if(!num)
+			continue;
+		total += num;
+		fprintf(fout, "WARNING, %lu %s%s\n", num, issueDescrs[i]
+			, m_examples[i].empty() ? "" : ", e.g.:");
+		for(const auto& exm: m_examples[i]) {
+			fprintf(fout, "  %s", exm.file.c_str());
+			if(exm.line)
+				fprintf(fout, ":%lu", exm.line);
+			fprintf(fout, ": '%s'\n", exm.text.c_str());
+		}
+		m_examples[i].clear();
+	}
+	return total;
+}
+
+}  // daoc
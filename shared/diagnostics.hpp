@@ -0,0 +1,123 @@
+//! \brief Diagnostics of the input data issues, which are counted per category
+//! 	in the hot loops and reported once as a summary
+//!
+//! \license Apache License, Version 2.0: http://www.apache.org/licenses/LICENSE-2.0.html
+//! > 	Simple explanation: https://tldrlegal.com/license/apache-license-2.0-(apache-2.0)
+//!
+//! Copyright (c)
+//! \authr Artem Lutov
+//! \email luart@ya.ru
+//! \date 2026-10-18
+
+#ifndef DIAGNOSTICS_HPP
+#define DIAGNOSTICS_HPP
+
+#include <cstdint>  // uintX_t
+#include <cstdio>  // FILE
+#include <string>
+#include <vector>
+#include <atomic>
+#include <mutex>
+
+
+namespace daoc {
+
+using std::string;
+using std::vector;
+using std::atomic;
+using std::mutex;
+
+// Diagnostics Types -----------------------------------------------------------
+//! \brief Categories of the input data issues
+enum class Issue: uint8_t {
+	EMPTY_CLUSTER,  //!< Empty cluster having only the id
+	INVALID_ID,  //!< Node id conversion error
+	INVALID_LINK,  //!< Link of the network without two valid endpoints
+	NUM  //!< The number of categories
+};
+
+//! \brief Diagnostics accumulating the counters of the issues and the first
+//! 	few examples of each category
+//! \note Reporting of an issue is an atomic increment of the counter unless
+//! 	the example is captured, which happens only for the first issues of the
+//! 	category. So, the reporting can be used in the hot (parallel) loops
+//! 	instead of the direct output to the (unbuffered) stderr.
+class Diagnostics {
+public:
+	constexpr static unsigned  issuesNum = static_cast<unsigned>(Issue::NUM);  //!< The number of categories
+
+	//! \brief Example of the issue
+	struct Example {
+		string  file;  //!< Name of the file
+		size_t  line;  //!< Line number (starting from 1) in the file, 0 if unknown
+		string  text;  //!< Text of the issue (e.g. the invalid token)
+	};
+private:
+	atomic<size_t>  m_counts[issuesNum];  //!< The number of issues of each category
+	vector<Example>  m_examples[issuesNum];  //!< The first examples of each category
+	mutex  m_mutex;  //!< Synchronization of the examples capturing
+	unsigned  m_exmax;  //!< Max number of examples per category
+public:
+    //! \brief Constructor
+    //!
+    //! \param exmax=3 unsigned  - max number of examples per category
+	Diagnostics(unsigned exmax=3) noexcept;
+
+    //! \brief Copy constructor
+	Diagnostics(const Diagnostics&)=delete;
+
+    //! \brief Copy assignment
+	Diagnostics& operator= (const Diagnostics&)=delete;
+
+    //! \brief Global diagnostics of the application
+	static Diagnostics& global() noexcept;
+
+    //! \brief Report the issue
+    //!
+    //! \param issue Issue  - category of the issue
+    //! \param file const string&  - name of the file
+    //! \param line size_t  - line number in the file, 0 if unknown
+    //! \param text const char*  - text of the issue, might be not null-terminated
+    //! \param len=size_t(-1) size_t  - max length of the text
+    //! \return void
+	void report(Issue issue, const string& file, size_t line, const char* text
+		, size_t len=size_t(-1))
+	{
+		if(__builtin_expect(m_counts[static_cast<unsigned>(issue)]
+		.fetch_add(1, std::memory_order_relaxed) < m_exmax, 0))
+			capture(issue, file, line, text, len);
+	}
+
+    //! \brief Report multiple issues without the examples
+    //!
+    //! \param issue Issue  - category of the issue
+    //! \param num size_t  - the number of issues
+    //! \return void
+	void report(Issue issue, size_t num) noexcept
+		{ m_counts[static_cast<unsigned>(issue)].fetch_add(num, std::memory_order_relaxed); }
+
+    //! \brief The number of issues of the category
+	size_t count(Issue issue) const noexcept
+		{ return m_counts[static_cast<unsigned>(issue)].load(std::memory_order_relaxed); }
+
+    //! \brief Output the summary of the accumulated issues and reset them
+    //!
+    //! \param fout=stderr FILE*  - output stream
+    //! \return size_t  - the total number of issues
+	size_t summary(FILE* fout=stderr);
+protected:
+    //! \brief Capture the example of the issue
+    //!
+    //! \param issue Issue  - category of the issue
+    //! \param file const string&  - name of the file
+    //! \param line size_t  - line number in the file, 0 if unknown
+    //! \param text const char*  - text of the issue
+    //! \param len size_t  - max length of the text
+    //! \return void
+	__attribute__((noinline, cold))
+	void capture(Issue issue, const string& file, size_t line, const char* text, size_t len);
+};
+
+}  // daoc
+
+#endif // DIAGNOSTICS_HPP
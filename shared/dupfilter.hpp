@@ -0,0 +1,205 @@
+//! \brief Filter of the repeated member ids within a cluster
+//!
+//! \license Apache License, Version 2.0: http://www.apache.org/licenses/LICENSE-2.0.html
+//! > 	Simple explanation: https://tldrlegal.com/license/apache-license-2.0-(apache-2.0)
+//!
+//! Copyright (c)
+//! \authr Artem Lutov
+//! \email luart@ya.ru
+//! \date 2026-10-18
+
+#ifndef DUPFILTER_HPP
+#define DUPFILTER_HPP
+
+#include <cstdint>  // uintX_t
+#include <vector>
+#include <memory>  // allocator
+#include <algorithm>  // min, max, sort, fill
+#include <limits>
+#include <utility>  // pair
+#include <type_traits>  // is_integral, is_unsigned
+
+
+namespace daoc {
+
+using std::vector;
+using std::is_integral;
+using std::is_unsigned;
+
+// Type Declarations ---------------------------------------------------
+//! \brief Filter of the repeated ids in the sequence (members of the cluster)
+//! 	by the kernel adapted to the number of ids
+//! \note The small sequences are verified by the sorting network, which is
+//! 	branch-free. The large sequences are verified by the dense array of the
+//! 	generation stamps indexed by the ids, so the stamps are not cleared
+//! 	between the sequences. The dense array is bounded by the number of the
+//! 	verified ids, so the sparse large ids exceeding the bound are verified
+//! 	by sorting. The clean sequences are only verified.
+//!
+//! \tparam Id  - type of the ids
+//! \tparam Allocator  - allocator of the stamps
+template <typename Id=uint32_t, typename Allocator=std::allocator<uint32_t>>
+class DupFilter {
+	static_assert(is_integral<Id>::value && is_unsigned<Id>::value
+		, "DupFilter, types constraints are violated");
+public:
+	constexpr static size_t  netsize = 16;  //!< Max number of the ids verified by the sorting network
+	constexpr static size_t  stampsmin = 1 << 16;  //!< Size of the dense array of the stamps, which is always affordable
+	constexpr static size_t  stampsfactor = 4;  //!< Max ratio of the dense array size to the number of the verified ids
+	constexpr static size_t  stampsmax = 1 << 26;  //!< Max size of the dense array of the stamps
+private:
+	vector<uint32_t, Allocator>  m_stamps;  //!< Generation stamps of the ids
+	uint32_t  m_gen;  //!< Current generation
+	size_t  m_idsnum;  //!< The number of ids verified by the large sequences
+	vector<std::pair<Id, uint32_t>>  m_ordered;  //!< Ids with their indices ordered by the ids
+public:
+    //! \brief Default constructor
+	DupFilter(): m_stamps(), m_gen(0), m_idsnum(0), m_ordered()  {}
+
+    //! \brief Whether the ids contain repetitions
+    //!
+    //! \param ids const Id*  - the ids
+    //! \param num size_t  - the number of ids
+    //! \return bool  - some ids are repeated
+	bool duplicated(const Id* ids, size_t num)
+	{
+		if(num <= 1)
+			return false;
+		if(num <= netsize) {
+			Id  vals[netsize];
+			std::copy(ids, ids + num, vals);
+			// Note: the padding ids are ordered after the actual ones
+			std::fill(vals + num, vals + netsize, std::numeric_limits<Id>::max());
+			sortNetwork(vals);
+			bool  dup = false;
+			for(size_t i = 1; i < num; ++i)
+				dup |= vals[i - 1] == vals[i];
+			return dup;
+		}
+		if(!stampable(ids, num))
+			return orderedFirsts(ids, num, nullptr) != num;
+		const uint32_t  gen = nextGen();
+		for(size_t i = 0; i < num; ++i) {
+			uint32_t&  stamp = m_stamps[ids[i]];
+			if(stamp == gen)
+				return true;
+			stamp = gen;
+		}
+		return false;
+	}
+
+    //! \brief Select the first occurrences of the ids
+    //!
+    //! \param ids const Id*  - the ids
+    //! \param num size_t  - the number of ids
+    //! \param sel uint32_t*  - indices of the first occurrences in the ascending order,
+    //! 	should have a capacity of num
+    //! \return size_t  - the number of selected (unique) ids
+	size_t firsts(const Id* ids, size_t num, uint32_t* sel)
+	{
+		size_t  n = 0;  // The number of selected ids
+		if(num <= netsize) {
+			for(size_t i = 0; i < num; ++i) {
+				bool  first = true;
+				for(size_t j = 0; j < i; ++j)
+					first &= ids[j] != ids[i];
+				sel[n] = i;
+				n += first;
+			}
+			return n;
+		}
+		if(!stampable(ids, num))
+			return orderedFirsts(ids, num, sel);
+		const uint32_t  gen = nextGen();
+		for(size_t i = 0; i < num; ++i) {
+			uint32_t&  stamp = m_stamps[ids[i]];
+			sel[n] = i;
+			n += stamp != gen;
+			stamp = gen;
+		}
+		return n;
+	}
+protected:
+    //! \brief Sort the ids by the Batcher's merge-exchange network
+    //!
+    //! \param vals Id*  - the ids to be sorted, netsize
+    //! \return void
+	static void sortNetwork(Id* vals) noexcept
+	{
+		for(size_t p = 1; p < netsize; p <<= 1)
+			for(size_t k = p; k >= 1; k >>= 1)
+				for(size_t j = k % p; j + k < netsize; j += 2 * k)
+					for(size_t i = 0; i < std::min(k, netsize - j - k); ++i)
+						if((i + j) / (2 * p) == (i + j + k) / (2 * p)) {
+							Id&  a = vals[i + j];
+							Id&  b = vals[i + j + k];
+							const Id  lo = std::min(a, b);
+							b = std::max(a, b);
+							a = lo;
+						}
+	}
+
+    //! \brief Whether the ids fit the dense array of the stamps, extending it if required
+    //! \note The array size is bounded by the number of the verified ids, so
+    //! 	the sparse ids do not allocate the memory proportional to the max id
+    //!
+    //! \param ids const Id*  - the ids
+    //! \param num size_t  - the number of ids
+    //! \return bool  - the ids are stampable
+	bool stampable(const Id* ids, size_t num)
+	{
+		m_idsnum += num;
+		Id  idmax = 0;
+		for(size_t i = 0; i < num; ++i)
+			idmax = std::max(idmax, ids[i]);
+		if(idmax < m_stamps.size())
+			return true;
+		const size_t  bound = std::min(std::max(size_t(stampsmin), stampsfactor * m_idsnum)
+			, size_t(stampsmax));  // Max size of the array
+		if(idmax >= bound)
+			return false;
+		m_stamps.resize(std::min(std::max<size_t>(idmax + 1, m_stamps.size() * 2), bound));
+		return true;
+	}
+
+    //! \brief The next generation of the stamps, resetting them on the wraparound
+    //!
+    //! \return uint32_t  - the generation
+	uint32_t nextGen()
+	{
+		if(!++m_gen) {
+			std::fill(m_stamps.begin(), m_stamps.end(), 0);
+			m_gen = 1;
+		}
+		return m_gen;
+	}
+
+    //! \brief Select the first occurrences of the ids by sorting
+    //!
+    //! \param ids const Id*  - the ids
+    //! \param num size_t  - the number of ids
+    //! \param sel uint32_t*  - indices of the first occurrences in the ascending order
+    //! 	or nullptr if only their number is required
+    //! \return size_t  - the number of selected (unique) ids
+	size_t orderedFirsts(const Id* ids, size_t num, uint32_t* sel)
+	{
+		m_ordered.clear();
+		for(size_t i = 0; i < num; ++i)
+			m_ordered.emplace_back(ids[i], i);
+		std::sort(m_ordered.begin(), m_ordered.end());
+		size_t  n = 0;  // The number of selected ids
+		for(size_t i = 0; i < num; ++i)
+			if(!i || m_ordered[i].first != m_ordered[i - 1].first) {
+				if(sel)
+					sel[n] = m_ordered[i].second;
+				++n;
+			}
+		if(sel)
+			std::sort(sel, sel + n);
+		return n;
+	}
+};
+
+}  // daoc
+
+#endif // DUPFILTER_HPP
@@ -14,6 +14,7 @@
 
 #ifdef __unix__
 #include <sys/stat.h>
+#include <sys/mman.h>  // mmap
 #endif // __unix__
 
 #define INCLUDE_STL_FS
@@ -33,6 +34,9 @@ using namespace daoc;
 // File IO Types definitions ---------------------------------------------------
 size_t NamedFileWrapper::size() const noexcept
 {
+	// The size of the non-regular files (archive entries) is known in advance
+	if(m_size != size_t(-1))
+		return m_size;
 	size_t  cmsbytes = -1;  // Return -1 on error
 #ifdef __unix__  // sqrt(cmsbytes) lines => linebuf = max(4-8Kb, sqrt(cmsbytes) * 2) with dynamic realloc
 	struct stat  filest;
@@ -63,9 +67,18 @@ NamedFileWrapper& NamedFileWrapper::reset(const char* filename, const char* mode
 		m_file.reset(fopen(filename, mode));
 		m_name = filename;
 	} else m_file.reset();
+	m_size = -1;
 	return *this;
 }
 
+bool NamedFileWrapper::rename(const string& filename)
+{
+	if(std::rename(m_name.c_str(), filename.c_str()))
+		return false;
+	m_name = filename;
+	return true;
+}
+
 // File Reading Types ----------------------------------------------------------
 StringBuffer::StringBuffer(size_t size)
 : StringBufferBase(size), m_cur(0), m_length(0)
@@ -84,8 +97,9 @@ void StringBuffer::reset(size_t size)
 	m_cur = 0;
 	m_length = 0;
 	// Reset the buffer
-	resize(size);  // Note: can throw bad_alloc
-	shrink_to_fit();  // Free reserved memory
+	// Note: the swap frees the reserved memory like shrink_to_fit(), which is not
+	// instantiable for the custom allocators by some versions of libstdc++
+	StringBufferBase(size).swap(*this);  // Note: can throw bad_alloc
 	*data() = 0;  // Set first element to 0
 	data()[size-2] = 0;  // Set prelast reserved element to 0
 	// Note: data()[size-1] is set to 0 automatically on file read if
@@ -168,6 +182,193 @@ bool StringBuffer::readline(FILE* input)
 	return true;  // More lines can be read
 }
 
+MemberReader::MemberReader(FILE* file, size_t lnum, size_t chunk)
+: m_file(file), m_buf(std::max<size_t>(chunk, 2) + 1), m_pos(m_buf.data())
+, m_end(m_buf.data()), m_lnum(lnum), m_eol(true)
+{}
+
+size_t MemberReader::fill(char* from)
+{
+	// Retain the unprocessed data
+	const size_t  rsize = m_end - from;
+	if(rsize == m_buf.size() - 1) {
+		// The member does not fit the chunk, which happens only for the malformed input
+		const size_t  ipos = m_pos - from;
+		Buffer  buf(2 * m_buf.size() - 1);
+		memcpy(buf.data(), from, rsize);
+		m_buf.swap(buf);
+		m_pos = m_buf.data() + ipos;
+	} else {
+		memmove(m_buf.data(), from, rsize);
+		m_pos -= from - m_buf.data();
+	}
+	m_end = m_buf.data() + rsize;
+	const size_t  num = m_file ? fread(m_end, 1, m_buf.size() - 1 - rsize, m_file) : 0;
+	if(!num && m_file && ferror(m_file))
+		perror("ERROR MemberReader::fill(), file reading error");
+	m_end += num;
+	return num;
+}
+
+bool MemberReader::nextLine()
+{
+	// Skip the remained part of the current line
+	while(!m_eol) {
+		char* eol = static_cast<char*>(memchr(m_pos, '\n', m_end - m_pos));
+		if(eol) {
+			m_pos = eol + 1;
+			m_eol = true;
+		} else {
+			m_pos = m_end;
+			if(!fill(m_pos))
+				m_eol = true;
+		}
+	}
+	if(m_pos == m_end && !fill(m_pos))
+		return false;
+	m_eol = false;
+	++m_lnum;
+	return true;
+}
+
+char* MemberReader::next(size_t* len)
+{
+	if(m_eol)
+		return nullptr;
+	// Skip the delimiters
+	do {
+		while(m_pos != m_end && (*m_pos == ' ' || *m_pos == '\t'))
+			++m_pos;
+	} while(m_pos == m_end && fill(m_pos));
+	if(m_pos == m_end || *m_pos == '\n') {
+		if(m_pos != m_end)
+			++m_pos;
+		m_eol = true;
+		return nullptr;
+	}
+
+	// Find the end of the member
+	char*  pos = m_pos;  // Position in the member
+	while(true) {
+		while(pos != m_end && *pos != ' ' && *pos != '\t' && *pos != '\n')
+			++pos;
+		if(pos != m_end)
+			break;
+		// Read the remained part of the member
+		const size_t  mlen = pos - m_pos;
+		if(!fill(m_pos)) {
+			pos = m_end;
+			break;
+		}
+		pos = m_pos + mlen;
+	}
+	char* const  mbr = m_pos;
+	if(len)
+		*len = pos - mbr;
+	if(pos != m_end) {
+		m_eol = *pos == '\n';
+		m_pos = pos + 1;
+	} else m_pos = pos;
+	*pos = 0;  // Note: the buffer has a reserved byte for the terminating null
+	return mbr;
+}
+
+bool MemberReader::nextMembers(BufferString& mbrs, size_t size)
+{
+	mbrs.clear();
+	while(!m_eol) {
+		if(m_pos == m_end && !fill(m_pos)) {
+			m_eol = true;
+			break;
+		}
+		char* const  eol = static_cast<char*>(memchr(m_pos, '\n', m_end - m_pos));
+		char* const  lim = eol ? eol : m_end;  // Limit of the line data in the buffer
+		if(mbrs.size() >= size) {
+			// Complete the last member
+			char*  pos = m_pos;
+			while(pos != lim && *pos != ' ' && *pos != '\t')
+				++pos;
+			mbrs.append(m_pos, pos);
+			m_pos = pos;
+			if(pos == eol) {
+				m_pos = eol + 1;
+				m_eol = true;
+			}
+			if(pos != m_end)
+				break;
+			continue;
+		}
+		const size_t  num = std::min<size_t>(lim - m_pos, size - mbrs.size());
+		mbrs.append(m_pos, num);
+		m_pos += num;
+		if(m_pos == eol) {
+			++m_pos;
+			m_eol = true;
+		}
+	}
+	return !mbrs.empty();
+}
+
+MappedFile::MappedFile(NamedFileWrapper& file)
+: m_data(nullptr), m_size(0), m_mapped(false), m_buf()
+{
+	if(!file)
+		return;
+#ifdef __unix__
+	const int  fd = fileno(file);
+	struct stat  filest;
+	if(fd != -1 && !fstat(fd, &filest) && S_ISREG(filest.st_mode)) {
+		m_size = filest.st_size;
+		if(!m_size)
+			return;
+		void*  data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if(data != MAP_FAILED) {
+			madvise(data, m_size, MADV_SEQUENTIAL);
+			m_data = static_cast<const char*>(data);
+			m_mapped = true;
+			return;
+		}
+		perror(("WARNING MappedFile(), mmap failed for '" + file.name()
+			+ "', the file is read").c_str());
+		m_size = 0;
+	}
+#endif // __unix__
+	// Read the non-mappable file
+	const size_t  fsize = file.size();
+	constexpr size_t  blocksize = 1 << 20;
+	if(fsize != size_t(-1))
+		m_buf.reserve(fsize + blocksize);
+	size_t  rsize = 0;
+	do {
+		m_buf.resize(m_size + blocksize);
+		rsize = fread(m_buf.data() + m_size, 1, blocksize, file);
+		m_size += rsize;
+	} while(rsize == blocksize);
+	if(ferror(file))
+		perror(("ERROR MappedFile(), reading of '" + file.name() + "' failed").c_str());
+	m_buf.resize(m_size);
+	m_data = m_buf.data();
+}
+
+bool MappedFile::mappable(const NamedFileWrapper& file) noexcept
+{
+#ifdef __unix__
+	const int  fd = file ? fileno(file) : -1;
+	struct stat  filest;
+	return fd != -1 && !fstat(fd, &filest) && S_ISREG(filest.st_mode);
+#else
+	return false;
+#endif // __unix__
+}
+
+MappedFile::~MappedFile()
+{
+#ifdef __unix__
+	if(m_mapped)
+		munmap(const_cast<char*>(m_data), m_size);
+#endif // __unix__
+}
+
 // File I/O functions ----------------------------------------------------------
 namespace daoc {
 
@@ -193,9 +394,10 @@ void ensureDir(const string& dir)
 			+= "' already exists as a non-directory path\n");
 }
 
-void parseCnlHeader(NamedFileWrapper& fcls, StringBuffer& line, size_t& clsnum
+size_t parseCnlHeader(NamedFileWrapper& fcls, StringBuffer& line, size_t& clsnum
 	, size_t& ndsnum, [[maybe_unused]] bool verbose)
 {
+	TraceSpan  span("parse", "header", fcls.name());
     //! Parse count value
     //! \return  - id value of 0 in case of parsing errors
 	auto parseCount = []() noexcept -> size_t {
@@ -214,19 +416,18 @@ void parseCnlHeader(NamedFileWrapper& fcls, StringBuffer& line, size_t& clsnum
 	constexpr char  clsmark[] = "clusters";
 	constexpr char  ndsmark[] = "nodes";
 	constexpr char  attrnameDelim[] = " \t:,";
-#if TRACE >= 2
 	size_t  lnum = 0;  // The number of lines read
-#endif // TRACE
-	while(line.readline(fcls)) {
-#if TRACE >= 2
+	// Note: the first char of the line is peeked to not consume the first non-header line
+	for(int c; (c = getc(fcls)) != EOF && ungetc(c, fcls) != EOF;) {
+		// Consider only subsequent comments and empty lines
+		if(c != '#' && c != '\n')
+			break;
+		if(!line.readline(fcls))
+			break;
 		++lnum;
-#endif // TRACE
 		// Skip empty lines
 		if(line.empty())
 			continue;
-		// Consider only subsequent comments
-		if(line[0] != '#')
-			break;
 
 		// Tokenize the line
 		char *tok = strtok(line + 1, attrnameDelim);  // Note: +1 to skip the leading '#'
@@ -278,14 +479,22 @@ void parseCnlHeader(NamedFileWrapper& fcls, StringBuffer& line, size_t& clsnum
 			clsnum = ndsnum;
 			//assert(0 && "parseCnlHeader(), clsnum typically should be less than ndsnum");
 		}
-		// Get following line for the unified subsequent processing
-		line.readline(fcls);
 		break;
 	}
 #if TRACE >= 2
 	fprintf(stderr, "parseCnlHeader(), processed %lu lines of '%s'\n"
 		, lnum, fcls.name().c_str());
 #endif // TRACE
+	return lnum;
+}
+
+bool isNetworkFile(const string& name) noexcept
+{
+	const auto  iext = name.rfind('.');
+	if(iext == string::npos)
+		return false;
+	const char*  ext = name.c_str() + iext + 1;
+	return !strcmp(ext, "nse") || !strcmp(ext, "nsa") || !strcmp(ext, "ncol");
 }
 
 size_t estimateCnlNodes(size_t filesize, float membership) noexcept
@@ -24,6 +24,8 @@
 // For the template definitions
 #include <cstring>  // strtok
 #include <cmath>  // sqrt
+#include <limits>  // numeric_limits
+#include <algorithm>  // find
 
 #ifdef INCLUDE_STL_FS
 #if defined(__has_include) && __has_include(<filesystem>) && __cplusplus >= 201703L  // C++17+
@@ -38,6 +40,12 @@
 #endif // INCLUDE_STL_FS
 
 #include "agghash.hpp"
+#include "diagnostics.hpp"
+#include "idset.hpp"
+#include "labels.hpp"
+#include "memstat.hpp"
+#include "parallel.hpp"
+#include "tracing.hpp"
 
 //#include "types.h"
 
@@ -135,10 +143,11 @@ public:
 class NamedFileWrapper {
 	FileWrapper  m_file;  //!< File descriptor
 	string  m_name;  //!< File name
+	size_t  m_size;  //!< File size if known in advance (non-regular files), -1 otherwise
 public:
     //! \brief Default Constructor
     // Note: Required tor return empty objects using NRVO optimization
-	NamedFileWrapper() noexcept: m_file(), m_name()  {}
+	NamedFileWrapper() noexcept: m_file(), m_name(), m_size(-1)  {}
 
     //! \brief Constructor
     //! \pre Parent directory must exists
@@ -147,7 +156,16 @@ public:
     //! \param mode const char*  - opening mode, the same as fopen() has
 	NamedFileWrapper(const char* filename, const char* mode)
 	: m_file(filename && mode ? fopen(filename, mode) : nullptr)
-	, m_name(filename ? filename : "")  {}
+	, m_name(filename ? filename : ""), m_size(-1)  {}
+
+    //! \brief Constructor from the already opened stream
+    //!
+    //! \param fd FILE*  - the file descriptor to be held and closed on destruction
+    //! \param filename const char*  - the file name
+    //! \param size=-1 size_t  - the file size if known in advance, which is
+    //! 	required for the non-regular files (e.g. archive entries), -1 means unknown
+	NamedFileWrapper(FILE* fd, const char* filename, size_t size=-1)
+	: m_file(fd), m_name(filename ? filename : ""), m_size(size)  {}
 
     //! \brief Copy constructor
     //! \note Any file descriptor should have a single owner
@@ -157,7 +175,7 @@ public:
 	// ATTENTION: std::vector will move their elements if the elements' move constructor
 	// is noexcept, and copy otherwise (unless the copy constructor is not accessible)
     NamedFileWrapper(NamedFileWrapper&& fw) noexcept
-    : m_file(move(fw.m_file)), m_name(move(fw.m_name))  {}
+    : m_file(move(fw.m_file)), m_name(move(fw.m_name)), m_size(fw.m_size)  {}
 
     //! \brief Copy assignment
     //! \note Any file descriptor should have the single owner
@@ -168,6 +186,7 @@ public:
     {
 		m_file = move(fw.m_file);
 		m_name = move(fw.m_name);
+		m_size = fw.m_size;
 		return *this;
     }
 
@@ -204,6 +223,12 @@ public:
     //! \return NamedFileWrapper&  - the newly opened file or just the old one closed
 	NamedFileWrapper& reset(const char* filename, const char* mode);
 
+    //! \brief Rename the file retaining it opened
+    //!
+    //! \param filename const string&  - new file name
+    //! \return bool  - whether the file has been renamed
+	bool rename(const string& filename);
+
     //! \brief Release ownership of the holding file
     //!
     //! \return FILE*  - file descriptor
@@ -211,8 +236,11 @@ public:
 };
 
 // File Reading Types ----------------------------------------------------------
+//! \brief Buffer of the input data accounted to the buffers memory
+using Buffer = vector<char, CountingAllocator<char, MemUse::BUFFERS>>;
+
 //! \brief Base of the StringBuffer
-using StringBufferBase = vector<char>;
+using StringBufferBase = Buffer;
 
 //! \brief String buffer to real file by lines using c-strings
 //! \note The last symbol in the string is always set to 0 automatically
@@ -273,6 +301,106 @@ public:
 	bool readline(FILE* input);
 };
 
+//! \brief Streaming reader of the members (tokens) of the clusters, which
+//! 	processes the input by the fixed-size chunks carrying partial tokens
+//! 	across the chunk boundaries, so the memory consumption is constant
+//! 	regardless of the line (cluster) length
+//! \note The members are delimited by ' ' or '\t', the lines are delimited by '\n'
+class MemberReader {
+	FILE*  m_file;  //!< Input file
+	Buffer  m_buf;  //!< Chunk buffer, the last byte is reserved for the null terminator
+	char*  m_pos;  //!< Current position in the buffer
+	char*  m_end;  //!< End of the read data in the buffer
+	size_t  m_lnum;  //!< Number of the current line
+	bool  m_eol;  //!< The current line is completely read
+public:
+    //! \brief Constructor
+    //!
+    //! \param file FILE*  - input file positioned to the beginning of a line
+    //! \param lnum=0 size_t  - the number of lines preceding the current position
+    //! 	(e.g. the header lines)
+    //! \param chunk=1<<16 size_t  - size of the chunk for the reading
+	MemberReader(FILE* file, size_t lnum=0, size_t chunk=1<<16);
+
+    //! \brief Copy constructor
+	MemberReader(const MemberReader&)=delete;
+
+    //! \brief Copy assignment
+	MemberReader& operator= (const MemberReader&)=delete;
+
+    //! \brief Move to the next line skipping the remained members of the current one
+    //!
+    //! \return bool  - whether the next line exists
+	bool nextLine();
+
+    //! \brief Fetch the next member of the current line
+    //! \attention The member is valid only until the next fetching
+    //!
+    //! \param[out] len=nullptr size_t*  - length of the member
+    //! \return char*  - null-terminated member or nullptr on the end of line
+	char* next(size_t* len=nullptr);
+
+    //! \brief Fetch the next whole members of the current line in the raw form
+    //! 	(delimited by the spaces or tabs) having about the specified size
+    //!
+    //! \param[out] mbrs BufferString&  - the fetched members, the last one is not split
+    //! \param size size_t  - the size to be fetched, which is exceeded only
+    //! 	to complete the last member
+    //! \return bool  - whether any data is fetched, false on the end of line
+	bool nextMembers(BufferString& mbrs, size_t size);
+
+    //! \brief Number of the current line starting from 1
+	size_t line() const noexcept  { return m_lnum; }
+protected:
+    //! \brief Read the next chunk retaining the data starting from the specified position
+    //!
+    //! \param from char*  - beginning of the data to be retained
+    //! \return size_t  - the number of read bytes, 0 on the end of file or an error
+	size_t fill(char* from);
+};
+
+//! \brief Read-only memory view of the whole file, which is memory mapped
+//! 	if possible and read into the memory otherwise (e.g. for the pipes and
+//! 	archive entries)
+class MappedFile {
+	const char*  m_data;  //!< File content
+	size_t  m_size;  //!< The number of bytes in the content
+	bool  m_mapped;  //!< Whether the content is memory mapped
+	Buffer  m_buf;  //!< Content of the non-mappable file
+public:
+    //! \brief Constructor
+    //! \note The non-mappable file is read from the current position
+    //!
+    //! \param file NamedFileWrapper&  - the file opened for reading
+	MappedFile(NamedFileWrapper& file);
+
+    //! \brief Copy constructor
+	MappedFile(const MappedFile&)=delete;
+
+    //! \brief Copy assignment
+	MappedFile& operator= (const MappedFile&)=delete;
+
+    //! \brief Destructor, unmaps the file
+	~MappedFile();
+
+    //! \brief File content
+    //!
+    //! \return const char*  - the content, which is not null-terminated
+	const char* data() const noexcept  { return m_data; }
+
+    //! \brief The number of bytes in the content
+	size_t size() const noexcept  { return m_size; }
+
+    //! \brief Whether the content is memory mapped rather than read
+	bool mapped() const noexcept  { return m_mapped; }
+
+    //! \brief Whether the file is mappable (regular) rather than read
+    //!
+    //! \param file const NamedFileWrapper&  - the file opened for reading
+    //! \return bool  - the file content can be memory mapped
+	static bool mappable(const NamedFileWrapper& file) noexcept;
+};
+
 // File I/O functions declaration ----------------------------------------------
 //! \brief Ensure existence of the specified directory
 //!
@@ -282,20 +410,23 @@ void ensureDir(const string& dir);
 
 //! \brief  Parse the header of CNL file and validate the results
 //! \post clsnum <= ndsnum if ndsnum > 0. 0 means not specified
+//! \post The file is positioned to the first line following the header,
+//! 	which is not consumed
 //!
 //! \param fcls NamedFileWrapper&  - the reading file
 //! \param line StringBuffer&  - processing line (string, header) being read from the file
 //! \param[out] clsnum size_t&  - resulting number of clusters if specified, 0 in case of parsing errors
 //! \param[out] ndsnum size_t&  - resulting number of nodes if specified, 0 in case of parsing errors
 //! \param verbose=false bool  - print information about the header parsing issue to the stdout
-//! \return void
-void parseCnlHeader(NamedFileWrapper& fcls, StringBuffer& line, size_t& clsnum
+//! \return size_t  - the number of read lines
+size_t parseCnlHeader(NamedFileWrapper& fcls, StringBuffer& line, size_t& clsnum
 	, size_t& ndsnum, bool verbose=false);
 
 //! \brief Load all unique nodes from the CNL file with optional filtering by the cluster size
 //!
 //! \tparam Id  - Node id type
 //! \tparam AccId  - Accumulated node ids type
+//! \tparam Nodes  - Unique nodes container (unordered_set<Id>, IdSet<Id>)
 //!
 //! \param file NamedFileWrapper&  - input collection of clusters in the CNL format
 //! \param membership=1 float  - expected membership of the nodes, >0, typically >= 1.
@@ -306,10 +437,38 @@ void parseCnlHeader(NamedFileWrapper& fcls, StringBuffer& line, size_t& clsnum
 //! \param cmin=0 size_t  - min allowed cluster size
 //! \param cmax=0 size_t  - max allowed cluster size, 0 means any size
 //! \param verbose=true bool  - print the number of loaded nodes to the stdout
-//! \return bool  - the collection is loaded successfully
-template <typename Id, typename AccId>
-unordered_set<Id> loadNodes(NamedFileWrapper& file, float membership=1
-	, AggHash<Id, AccId>* ahash=nullptr, size_t cmin=0, size_t cmax=0, bool verbose=true);
+//! \param labels=nullptr LabelTable<Id>*  - interning table of the string labels
+//! 	of the nodes, whose ids are loaded, or nullptr for the numeric ids
+//! \return Nodes  - the loaded unique nodes
+template <typename Id, typename AccId, typename Nodes=unordered_set<Id>>
+Nodes loadNodes(NamedFileWrapper& file, float membership=1
+	, AggHash<Id, AccId>* ahash=nullptr, size_t cmin=0, size_t cmax=0, bool verbose=true
+	, LabelTable<Id>* labels=nullptr);
+
+//! \brief Load all unique nodes from the network specified by the edge/arc list
+//! 	(.nse/.nsa/.ncol formats), where the first two ids of each line are
+//! 	the link endpoints and the remained line (weight) is omitted
+//! \note The file is parsed in parallel by the line-aligned chunks unless
+//! 	the labels are interned, which is performed sequentially
+//!
+//! \tparam Id  - Node id type
+//! \tparam Nodes  - Unique nodes container (IdSet<Id> with any allocator)
+//!
+//! \param file NamedFileWrapper&  - input network
+//! \param threads=0 unsigned  - the number of worker threads, 0 means the number of CPUs
+//! \param verbose=true bool  - print the number of loaded nodes to the stdout
+//! \param labels=nullptr LabelTable<Id>*  - interning table of the string labels
+//! 	of the nodes delimited by the spaces or tabs, or nullptr for the numeric ids
+//! \return Nodes  - the loaded unique nodes
+template <typename Id, typename Nodes=IdSet<Id>>
+Nodes loadNetNodes(NamedFileWrapper& file, unsigned threads=0, bool verbose=true
+	, LabelTable<Id>* labels=nullptr);
+
+//! \brief Whether the file is a network (edge/arc list) by its extension
+//!
+//! \param name const string&  - file name
+//! \return bool  - the file has a network extension (.nse, .nsa, .ncol)
+bool isNetworkFile(const string& name) noexcept;
 
 //! \brief Estimate the number of nodes from the CNL file size
 //!
@@ -334,11 +493,11 @@ size_t estimateClusters(size_t ndsnum, float membership=1.f) noexcept;
 constexpr const char* toYesNo(bool val) noexcept  { return val ? "yes" : "no"; }
 
 // File I/O templates definition -----------------------------------------------
-template <typename Id, typename AccId>
-unordered_set<Id> loadNodes(NamedFileWrapper& file, float membership
-	, AggHash<Id, AccId>* ahash, size_t cmin, size_t cmax, bool verbose)
+template <typename Id, typename AccId, typename Nodes>
+Nodes loadNodes(NamedFileWrapper& file, float membership
+	, AggHash<Id, AccId>* ahash, size_t cmin, size_t cmax, bool verbose, LabelTable<Id>* labels)
 {
-	unordered_set<Id>  nodebase;  // Node base;  Note: returned using NRVO optimization
+	Nodes  nodebase;  // Node base;  Note: returned using NRVO optimization
 
 	if(!file)
 		return nodebase;
@@ -347,11 +506,9 @@ unordered_set<Id> loadNodes(NamedFileWrapper& file, float membership
 	size_t  clsnum = 0;  // The number of clusters
 	size_t  ndsnum = 0;  // The number of nodes
 
-	// Note: strings defined out of the cycle to avoid reallocations
-	StringBuffer  line;  // Reading line
+	StringBuffer  line;  // Reading line of the header
 	// Parse header and read the number of clusters if specified
-	// Note: line includes terminating '\n'
-	parseCnlHeader(file, line, clsnum, ndsnum, verbose);
+	const size_t  lnum = parseCnlHeader(file, line, clsnum, ndsnum, verbose);  // The number of header lines
 
 	// Estimate the number of nodes in the file if not specified
 	if(!ndsnum) {
@@ -373,32 +530,32 @@ unordered_set<Id> loadNodes(NamedFileWrapper& file, float membership
 		nodebase.reserve(ndsnum);
 
 	// Load clusters
-	// ATTENTION: without '\n' delimiter the terminating '\n' is read as an item
-	constexpr char  mbdelim[] = " \t\n";  // Delimiter for the members
+	// Note: the clusters are read by the members to not materialize the whole
+	// (potentially giant) line. The members are buffered only to filter the
+	// cluster by size, and the buffering is interrupted when cmax is exceeded.
+	const bool  sizefilt = cmin > 1 || cmax;  // Filter the clusters by size
 	vector<Id>  cnds;  // Cluster nodes. Note: a dedicated container is required to filter clusters by size
-	cnds.reserve(sqrt(ndsnum));  // Note: typically cluster size does not increase the square root of the number of nodes
+	if(sizefilt)
+		cnds.reserve(sqrt(ndsnum));  // Note: typically cluster size does not increase the square root of the number of nodes
 #if TRACE >= 2
 	size_t  totmbs = 0;  // The number of read member nodes from the file including repetitions
 	size_t  fclsnum = 0;  // The number of read clusters from the file
 #endif // TRACE
-	do {
-#if TRACE >= 3
-		// Note: line includes terminating '\n'
-		fprintf(stderr, "%lu> %s", fclsnum, static_cast<const char*>(line));
-#endif // TRACE
-		char *tok = strtok(line, mbdelim);  // const_cast<char*>(line.data())
+	MemberReader  mbrs(file, lnum);  // Members of the clusters
+	while(mbrs.nextLine()) {
+		size_t  toklen = 0;  // Length of the token
+		char *tok = mbrs.next(&toklen);
 
 		// Skip comments
 		if(!tok || tok[0] == '#')
 			continue;
 		// Skip the cluster id if present
-		if(tok[strlen(tok) - 1] == '>') {
-			const char* cidstr = tok;
-			tok = strtok(nullptr, mbdelim);
+		if(tok[toklen - 1] == '>') {
+			const string  cidstr = tok;
+			tok = mbrs.next(&toklen);
 			// Skip empty clusters, which actually should not exist
 			if(!tok) {
-				fprintf(stderr, "WARNING loadNodes(), empty cluster"
-					" exists: '%s', skipped\n", cidstr);
+				Diagnostics::global().report(Issue::EMPTY_CLUSTER, file.name(), mbrs.line(), cidstr.c_str());
 				continue;
 			}
 		}
@@ -407,29 +564,37 @@ unordered_set<Id> loadNodes(NamedFileWrapper& file, float membership
 			// but potentially can be considered in NMI and F1 evaluation.
 			// In the latter case abs diff of shares instead of co occurrence
 			// counting should be performed.
-			Id  nid = strtoul(tok, nullptr, 10);
+			// The string label is interned as a whole.
+			Id  nid = labels ? labels->intern(tok, toklen) : strtoul(tok, nullptr, 10);
 #if VALIDATE >= 2
-			if(!nid && tok[0] != '0') {
-				fprintf(stderr, "WARNING loadNodes(), conversion error of '%s' into 0: %s\n"
-					, tok, strerror(errno));
+			if(!labels && !nid && tok[0] != '0') {
+				Diagnostics::global().report(Issue::INVALID_ID, file.name(), mbrs.line(), tok);
 				continue;
 			}
 #endif // VALIDATE
 #if TRACE >= 2
 			++totmbs;  // Update the total number of read members
 #endif // TRACE
-			cnds.push_back(nid);
-		} while((tok = strtok(nullptr, mbdelim)));
+			if(!sizefilt)
+				nodebase.insert(nid);
+			else if(!cmax || cnds.size() < cmax)
+				cnds.push_back(nid);
+			else {
+				// The cluster exceeds cmax and is skipped
+				cnds.clear();
+				break;
+			}
+		} while((tok = mbrs.next(&toklen)));
 #if TRACE >= 2
 		++fclsnum;  // The number of valid read lines, i.e. clusters
 #endif // TRACE
 
 		// Filter read cluster by size
-		if(cnds.size() >= cmin && (!cmax || cnds.size() <= cmax))
+		if(cnds.size() >= cmin)
 			nodebase.insert(cnds.begin(), cnds.end());
 		// Prepare outer vars for the next iteration
 		cnds.clear();
-	} while(line.readline(file));
+	}
 //	// Rehash the nodes decreasing the allocated space if required
 //	if(nodebase.size() <= nodebase.bucket_count() * nodebase.max_load_factor() / 3)
 //		nodebase.reserve(nodebase.size());
@@ -452,6 +617,128 @@ unordered_set<Id> loadNodes(NamedFileWrapper& file, float membership
 	return nodebase;
 }
 
+template <typename Id, typename Nodes>
+Nodes loadNetNodes(NamedFileWrapper& file, unsigned threads, bool verbose, LabelTable<Id>* labels)
+{
+	Nodes  nodebase;  // Node base;  Note: returned using NRVO optimization
+
+	if(!file)
+		return nodebase;
+
+	// Split the input into the line-aligned chunks, a few per worker to balance the load
+	// Note: the labels are interned by a single worker, which processes the chunks in order
+	const unsigned  workers = labels ? 1 : workersNum(threads);
+	constexpr size_t  chunkmin = 1 << 20;  // Min size of the chunk
+	vector<Nodes>  wnodes(workers);  // Nodes of each worker
+	size_t  size = 0;  // The number of parsed bytes
+	size_t  nchunks = 0;  // The number of parsed chunks
+
+	// Parse the block of the whole lines by the chunks in parallel
+	auto parseBlock = [&](const char* const data, size_t bsize) {
+		const size_t  bchunks = std::max<size_t>(std::min<size_t>(bsize / chunkmin, workers * 4), 1);
+		parallelFor(bchunks, std::min<size_t>(workers, bchunks), [&](size_t ichunk, unsigned iworker) {
+			TraceSpan  span("parse", "chunk", file.name());
+			const char*  pos = data + bsize * ichunk / bchunks;
+			const char* const  end = data + bsize * (ichunk + 1) / bchunks;
+			const char* const  eof = data + bsize;
+			// Start from the beginning of the line, the line started in the previous
+			// chunk is processed by that chunk
+			if(ichunk && pos[-1] != '\n')
+				while(pos < eof && *pos++ != '\n');
+			auto&  nodes = wnodes[iworker];
+			// Process lines starting in the chunk
+			while(pos < end) {
+				// Skip leading spaces
+				while(pos < eof && (*pos == ' ' || *pos == '\t'))
+					++pos;
+				// Skip comments and empty lines
+				if(pos < eof && *pos != '#' && *pos != '%' && *pos != '\n' && *pos != '\r') {
+					const char* const  lbeg = pos;  // Beginning of the link
+					// Parse the endpoints
+					uint64_t  nids[2];  // Link endpoints
+					uint8_t  ids = 0;  // The number of parsed ids
+					for(; labels && ids < 2; ++ids) {
+						while(pos < eof && (*pos == ' ' || *pos == '\t'))
+							++pos;
+						const char* const  tok = pos;
+						while(pos < eof && *pos != ' ' && *pos != '\t' && *pos != '\n' && *pos != '\r')
+							++pos;
+						if(pos == tok)
+							break;
+						nids[ids] = labels->intern(tok, pos - tok);
+					}
+					for(; !labels && ids < 2; ++ids) {
+						while(pos < eof && (*pos == ' ' || *pos == '\t' || *pos == ','))
+							++pos;
+						if(pos == eof || *pos < '0' || *pos > '9')
+							break;
+						uint64_t  nid = 0;
+						do nid = nid * 10 + (*pos++ - '0');
+						while(pos < eof && *pos >= '0' && *pos <= '9' && nid <= std::numeric_limits<Id>::max());
+						if(nid > std::numeric_limits<Id>::max())
+							break;
+						nids[ids] = nid;
+					}
+					if(ids == 2) {
+						nodes.insert(nids[0]);
+						nodes.insert(nids[1]);
+					} else Diagnostics::global().report(Issue::INVALID_LINK, file.name(), 0, lbeg
+						, std::find(lbeg, eof, '\n') - lbeg);
+				}
+				// Skip the remained line
+				while(pos < eof && *pos++ != '\n');
+			}
+		});
+		size += bsize;
+		nchunks += bchunks;
+	};
+
+	if(MappedFile::mappable(file)) {
+		const MappedFile  net(file);
+		parseBlock(net.data(), net.size());
+	} else {
+		// Stream the non-mappable file (e.g. a pipe or an archive entry) by the
+		// blocks of the whole lines to bound the memory consumption
+		Buffer  buf(chunkmin * workers * 4);  // Block of the lines
+		size_t  tail = 0;  // The number of bytes of the incomplete last line retained in the buffer
+		while(true) {
+			// Extend the buffer if the line does not fit it, which happens only for the malformed input
+			if(tail == buf.size())
+				buf.resize(2 * buf.size());
+			const size_t  rsize = fread(buf.data() + tail, 1, buf.size() - tail, file);
+			size_t  bsize = tail + rsize;  // The number of bytes of the whole lines in the buffer
+			if(!rsize) {
+				if(bsize)
+					parseBlock(buf.data(), bsize);
+				break;
+			}
+			while(bsize && buf[bsize - 1] != '\n')
+				--bsize;
+			if(bsize)
+				parseBlock(buf.data(), bsize);
+			tail = tail + rsize - bsize;
+			memmove(buf.data(), buf.data() + bsize, tail);
+		}
+		if(ferror(file))
+			perror(("ERROR loadNetNodes(), reading of '" + file.name() + "' failed").c_str());
+	}
+
+	// Unite the worker nodes
+	for(auto& nodes: wnodes) {
+		nodebase |= nodes;
+		nodes = Nodes();  // Release the memory
+	}
+#if TRACE >= 2
+	printf("loadNetNodes(), the loaded base has %lu nodes from %lu bytes parsed by %lu chunks\n"
+		, nodebase.size(), size, nchunks);
+#else
+	if(verbose)
+		printf("loadNetNodes(), nodebase nodes loaded: %lu\n", nodebase.size());
+#endif // TRACE 2
+
+	return nodebase;
+}
+
 }  // daoc
 
 #endif // FILEIO_H
@@ -0,0 +1,174 @@
+//! \brief Finalization of the outputs of the run, which are formed in the
+//! 	temporary files and committed together
+//!
+//! \license Apache License, Version 2.0: http://www.apache.org/licenses/LICENSE-2.0.html
+//! > 	Simple explanation: https://tldrlegal.com/license/apache-license-2.0-(apache-2.0)
+//!
+//! Copyright (c)
+//! \authr Artem Lutov
+//! \email luart@ya.ru
+//! \date 2026-10-18
+
+#include <cassert>
+#include <cstdio>  // rename, remove
+#include <algorithm>  // find, find_if, sort, unique
+
+#ifdef __unix__
+#include <unistd.h>  // getpid, pwrite, fsync
+#include <fcntl.h>  // open
+#endif // __unix__
+
+#define INCLUDE_STL_FS
+#include "finalize.hpp"
+
+
+namespace daoc {
+
+using std::to_string;
+
+OutputGroup::~OutputGroup()
+{
+	for(const auto& out: m_outputs)
+		if(!out.tmpname.empty())
+			remove(out.tmpname.c_str());
+}
+
+string OutputGroup::tmpName(const string& name)
+{
+#ifdef __unix__
+	return name + ".tmp" + to_string(getpid());
+#else
+	return name + ".tmp";
+#endif // __unix__
+}
+
+string OutputGroup::stub()
+{
+	string  res(stubsize, ' ');
+	// Set the first digit to zero to have a valid header in case the stub is not patched
+	constexpr char  zval[] = "0,";
+	res.replace(0, sizeof zval - 1, zval);  // Note: -1 to not include the null terminator
+	return res;
+}
+
+bool OutputGroup::stage(NamedFileWrapper& file)
+{
+	m_outputs.push_back({&file, file.name(), string(), {}});
+	// Note: the non-regular files (e.g. /dev/stdout) should not be renamed
+	if(!MappedFile::mappable(file))
+		return true;
+	const string  tmpname = tmpName(file.name());
+	if(!file.rename(tmpname)) {
+		perror(("ERROR OutputGroup::stage(), the output can't be staged: " + file.name()).c_str());
+		m_outputs.pop_back();
+		return false;
+	}
+	m_outputs.back().tmpname = tmpname;
+	return true;
+}
+
+void OutputGroup::add(const string& tmpname, const string& name)
+{
+	m_outputs.push_back({nullptr, name, tmpname, {}});
+}
+
+void OutputGroup::patch(const NamedFileWrapper& file, uint64_t offset, uint64_t value)
+{
+	auto  iout = std::find_if(m_outputs.begin(), m_outputs.end(), [&file](const Output& out) noexcept {
+		return out.file == &file;
+	});
+	assert(iout != m_outputs.end() && "patch(), the output should be staged");
+	if(iout != m_outputs.end())
+		iout->patches.push_back({offset, value});
+}
+
+bool OutputGroup::commit(unsigned workers)
+{
+	TraceSpan  span("output", "commit");
+	// Note: vector<bool> can't be written concurrently
+	vector<char>  synced(m_outputs.size(), false);  // Whether the output is synced
+	parallelFor(m_outputs.size(), workers, [&](size_t iout, unsigned) {
+		const Output&  out = m_outputs[iout];
+		TraceSpan  span("output", "sync", out.name);
+		synced[iout] = sync(out);
+	});
+	bool  res = true;
+	for(size_t i = 0; i < m_outputs.size(); ++i)
+		if(!synced[i]) {
+			fprintf(stderr, "ERROR OutputGroup::commit(), '%s' can't be written\n", m_outputs[i].name.c_str());
+			res = false;
+		}
+	// Note: the temporary files are removed on destruction
+	if(!res)
+		return false;
+
+	// Rename the synced outputs to their final names
+	vector<string>  dirs;  // Directories of the renamed outputs
+	for(auto& out: m_outputs) {
+		if(out.tmpname.empty())
+			continue;
+		if(out.file ? !out.file->rename(out.name) : std::rename(out.tmpname.c_str(), out.name.c_str())) {
+			perror(("ERROR OutputGroup::commit(), the output can't be renamed: " + out.name).c_str());
+			return false;
+		}
+		out.tmpname.clear();
+		dirs.push_back(fs::path(out.name).parent_path().string());
+	}
+#ifdef __unix__
+	// Sync the directories to persist the renaming
+	std::sort(dirs.begin(), dirs.end());
+	dirs.erase(std::unique(dirs.begin(), dirs.end()), dirs.end());
+	for(const auto& dir: dirs) {
+		const int  fd = open(dir.empty() ? "." : dir.c_str(), O_RDONLY);
+		if(fd != -1) {
+			fsync(fd);
+			close(fd);
+		}
+	}
+#endif // __unix__
+	return true;
+}
+
+bool OutputGroup::sync(const Output& out)
+{
+	// Note: the non-regular output formed in place is patched if possible
+	const bool  regular = !out.tmpname.empty();
+#ifdef __unix__
+	if(!out.file) {
+		const int  fd = open(out.tmpname.c_str(), O_RDONLY);
+		const bool  synced = fd != -1 && !fsync(fd);
+		if(fd != -1)
+			close(fd);
+		return synced;
+	}
+	if(fflush(*out.file))
+		return false;
+	const int  fd = fileno(*out.file);
+	char  val[stubsize + 1];  // The value followed by ','
+	for(const auto& pch: out.patches) {
+		const int  len = sprintf(val, "%lu,", pch.value);
+		if(pwrite(fd, val, len, pch.offset) != len) {
+			if(regular)
+				return false;
+			fprintf(stderr, "WARNING OutputGroup::sync(), the stub header of '%s' has not been replaced\n"
+				, out.name.c_str());
+			break;
+		}
+	}
+	return !fsync(fd) || !regular;
+#else
+	if(!out.file)
+		return true;
+	for(const auto& pch: out.patches)
+		if(fseek(*out.file, pch.offset, SEEK_SET) || fprintf(*out.file, "%lu,", pch.value) < 0) {
+			if(regular)
+				return false;
+			fprintf(stderr, "WARNING OutputGroup::sync(), the stub header of '%s' has not been replaced\n"
+				, out.name.c_str());
+			break;
+		}
+	return (!fseek(*out.file, 0, SEEK_END) && !fflush(*out.file)) || !regular;
+#endif // __unix__
+}
+
+}  // daoc
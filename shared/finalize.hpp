@@ -0,0 +1,117 @@
+//! \brief Finalization of the outputs of the run, which are formed in the
+//! 	temporary files and committed together
+//!
+//! \license Apache License, Version 2.0: http://www.apache.org/licenses/LICENSE-2.0.html
+//! > 	Simple explanation: https://tldrlegal.com/license/apache-license-2.0-(apache-2.0)
+//!
+//! Copyright (c)
+//! \authr Artem Lutov
+//! \email luart@ya.ru
+//! \date 2026-10-18
+
+#ifndef FINALIZE_HPP
+#define FINALIZE_HPP
+
+#include <cstdint>  // uintX_t
+#include <string>
+#include <vector>
+#include <limits>
+
+#include "fileio.hpp"
+
+
+namespace daoc {
+
+using std::string;
+using std::vector;
+
+// Type Declarations ---------------------------------------------------
+//! \brief Group of the outputs of the run, which are formed in the temporary
+//! 	files and then committed together
+//! \note The stub values of the headers are patched on the commit in place
+//! 	(pwrite) in parallel for all outputs, which are synced to the disk and
+//! 	only then renamed to their final names. So, an interrupted run leaves only
+//! 	the temporary files rather than the partially formed outputs looking valid.
+//! 	The uncommitted temporary files are removed on destruction.
+//! \attention The staged files should not be released before the commit
+class OutputGroup {
+	//! \brief Header value to be written to the stub
+	struct Patch {
+		uint64_t  offset;  //!< Offset of the stub in the file
+		uint64_t  value;  //!< The value
+	};
+
+	//! \brief Output of the group
+	struct Output {
+		NamedFileWrapper*  file;  //!< Forming file or nullptr for the complete closed one
+		string  name;  //!< Final name of the output
+		string  tmpname;  //!< Temporary name of the output, empty for the non-regular file formed in place
+		vector<Patch>  patches;  //!< Values of the header stubs
+	};
+
+	vector<Output>  m_outputs;  //!< Outputs of the group
+public:
+	//! Width of the header value stub including the trailing ',', which fits any uint64_t
+	constexpr static size_t  stubsize = std::numeric_limits<uint64_t>::digits10 + 2;
+
+    //! \brief Default constructor
+	OutputGroup(): m_outputs()  {}
+
+    //! \brief Copy constructor
+	OutputGroup(const OutputGroup&)=delete;
+
+    //! \brief Copy assignment
+	OutputGroup& operator= (const OutputGroup&)=delete;
+
+    //! \brief Destructor, removes the uncommitted temporary files
+	~OutputGroup();
+
+    //! \brief Temporary name of the output, which is unique per process
+    //!
+    //! \param name const string&  - final name of the output
+    //! \return string  - the temporary name
+	static string tmpName(const string& name);
+
+    //! \brief Stub of the header value, which is a valid zero value padded
+    //! 	to stubsize
+    //!
+    //! \return string  - the stub
+	static string stub();
+
+    //! \brief Stage the opened output renaming it to the temporary name
+    //! \note The non-regular file (e.g. a pipe) is formed in place
+    //!
+    //! \param file NamedFileWrapper&  - the output opened for writing under its final name
+    //! \return bool  - whether the output has been staged
+	bool stage(NamedFileWrapper& file);
+
+    //! \brief Add the complete output formed in the closed temporary file
+    //!
+    //! \param tmpname const string&  - the temporary name
+    //! \param name const string&  - final name of the output
+	void add(const string& tmpname, const string& name);
+
+    //! \brief Set the header value to be written to the stub on the commit
+    //!
+    //! \param file const NamedFileWrapper&  - the staged output
+    //! \param offset uint64_t  - offset of the stub in the file
+    //! \param value uint64_t  - the value
+	void patch(const NamedFileWrapper& file, uint64_t offset, uint64_t value);
+
+    //! \brief Commit the outputs: patch the header stubs and sync the files
+    //! 	in parallel, then rename them to their final names
+    //!
+    //! \param workers unsigned  - the number of workers, >= 1
+    //! \return bool  - whether all outputs have been committed
+	bool commit(unsigned workers);
+protected:
+    //! \brief Patch the header stubs of the output and sync it to the disk
+    //!
+    //! \param out const Output&  - the output
+    //! \return bool  - whether the output is synced
+	static bool sync(const Output& out);
+};
+
+}  // daoc
+
+#endif // FINALIZE_HPP
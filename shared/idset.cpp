@@ -0,0 +1,171 @@
+//! \brief Adaptive (dense bitmap or roaring-style) set of the node ids
+//!
+//! \license Apache License, Version 2.0: http://www.apache.org/licenses/LICENSE-2.0.html
+//! > 	Simple explanation: https://tldrlegal.com/license/apache-license-2.0-(apache-2.0)
+//!
+//! Copyright (c)
+//! \authr Artem Lutov
+//! \email luart@ya.ru
+//! \date 2026-10-18
+
+#include <limits>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define IDSET_SIMD 1
+#include <immintrin.h>
+#endif // __GNUC__ && __x86_64__
+
+#include "idset.hpp"
+
+
+using std::numeric_limits;
+using namespace daoc;
+
+namespace {
+
+//! \brief Selection kernel of the present ids
+using SelectKernel = size_t (*)(const uint64_t* words, size_t nwords, const uint32_t* ids
+	, size_t num, uint32_t* sel) noexcept;
+
+//! \brief Select the present ids starting from the specified index
+//!
+//! \param words const uint64_t*  - bitmap words
+//! \param nwords size_t  - the number of bitmap words
+//! \param ids const uint32_t*  - the ids to be tested
+//! \param i size_t  - index of the first tested id
+//! \param num size_t  - the number of ids
+//! \param sel uint32_t*  - indices of the present ids
+//! \param n size_t  - the number of already selected ids
+//! \return size_t  - the total number of selected ids
+inline size_t selectFrom(const uint64_t* words, size_t nwords, const uint32_t* ids
+	, size_t i, size_t num, uint32_t* sel, size_t n) noexcept
+{
+	for(; i < num; ++i) {
+		const size_t  iw = ids[i] >> 6;
+		sel[n] = i;
+		n += iw < nwords && (words[iw] >> (ids[i] & 63) & 1);
+	}
+	return n;
+}
+
+//! \copydoc daoc::selectIds
+size_t selectIdsScalar(const uint64_t* words, size_t nwords, const uint32_t* ids
+	, size_t num, uint32_t* sel) noexcept
+{
+	return selectFrom(words, nwords, ids, 0, num, sel, 0);
+}
+
+#ifdef IDSET_SIMD
+//! \brief Permutation table of the AVX2 compaction, which moves the lanes
+//! 	selected by the mask to the front
+struct CompactTable {
+	uint8_t  perms[256][8];  //!< Source lanes of the compacted lanes per mask
+
+	CompactTable() noexcept
+	: perms()
+	{
+		for(unsigned mask = 0; mask < 256; ++mask)
+			for(unsigned lane = 0, n = 0; lane < 8; ++lane)
+				if(mask & 1u << lane)
+					perms[mask][n++] = lane;
+	}
+};
+
+//! \brief Bound of the 32-bit bitmap words indices comparable as the signed values
+//!
+//! \param nwords size_t  - the number of 64-bit bitmap words
+//! \return int  - the number of 32-bit words bounded by INT_MAX
+inline int dwordsBound(size_t nwords) noexcept
+{
+	return nwords < size_t(numeric_limits<int>::max()) / 2 ? nwords * 2 : numeric_limits<int>::max();
+}
+
+//! \copydoc daoc::selectIds
+__attribute__((target("avx512f")))
+size_t selectIdsAvx512(const uint64_t* words, size_t nwords, const uint32_t* ids
+	, size_t num, uint32_t* sel) noexcept
+{
+	// Note: the bitmap is addressed by the 32-bit words to gather 16 of them
+	// at once, which is valid for the little-endian x86
+	const int*  dwords = reinterpret_cast<const int*>(words);
+	const __m512i  bound = _mm512_set1_epi32(dwordsBound(nwords));
+	const __m512i  one = _mm512_set1_epi32(1);
+	const __m512i  lowbits = _mm512_set1_epi32(31);
+	const __m512i  step = _mm512_set1_epi32(16);
+	__m512i  lanes = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+	size_t  n = 0;  // The number of selected ids
+	size_t  i = 0;
+	for(; i + 16 <= num; i += 16, lanes = _mm512_add_epi32(lanes, step)) {
+		const __m512i  vids = _mm512_loadu_si512(ids + i);
+		const __m512i  iws = _mm512_srli_epi32(vids, 5);
+		// Note: the ids out of the bitmap are not gathered and remain absent
+		const __m512i  vwords = _mm512_mask_i32gather_epi32(_mm512_setzero_si512()
+			, _mm512_cmplt_epi32_mask(iws, bound), iws, dwords, 4);
+		const __mmask16  present = _mm512_test_epi32_mask(vwords
+			, _mm512_sllv_epi32(one, _mm512_and_si512(vids, lowbits)));
+		_mm512_mask_compressstoreu_epi32(sel + n, present, lanes);
+		n += __builtin_popcount(present);
+	}
+	return selectFrom(words, nwords, ids, i, num, sel, n);
+}
+
+//! \copydoc daoc::selectIds
+__attribute__((target("avx2")))
+size_t selectIdsAvx2(const uint64_t* words, size_t nwords, const uint32_t* ids
+	, size_t num, uint32_t* sel) noexcept
+{
+	static const CompactTable  table;
+	const int*  dwords = reinterpret_cast<const int*>(words);
+	const __m256i  bound = _mm256_set1_epi32(dwordsBound(nwords));
+	const __m256i  one = _mm256_set1_epi32(1);
+	const __m256i  lowbits = _mm256_set1_epi32(31);
+	const __m256i  step = _mm256_set1_epi32(8);
+	__m256i  lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+	size_t  n = 0;  // The number of selected ids
+	size_t  i = 0;
+	for(; i + 8 <= num; i += 8, lanes = _mm256_add_epi32(lanes, step)) {
+		const __m256i  vids = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ids + i));
+		const __m256i  iws = _mm256_srli_epi32(vids, 5);
+		const __m256i  vwords = _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), dwords
+			, iws, _mm256_cmpgt_epi32(bound, iws), 4);
+		const __m256i  bits = _mm256_sllv_epi32(one, _mm256_and_si256(vids, lowbits));
+		const unsigned  present = _mm256_movemask_ps(_mm256_castsi256_ps(
+			_mm256_cmpeq_epi32(_mm256_and_si256(vwords, bits), bits)));
+		// Note: all 8 lanes are stored, where the trailing ones are overwritten
+		// by the subsequent stores or ignored, and n <= i, so sel has a room for them
+		const __m256i  perm = _mm256_cvtepu8_epi32(_mm_loadl_epi64(
+			reinterpret_cast<const __m128i*>(table.perms[present])));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(sel + n), _mm256_permutevar8x32_epi32(lanes, perm));
+		n += __builtin_popcount(present);
+	}
+	return selectFrom(words, nwords, ids, i, num, sel, n);
+}
+#endif // IDSET_SIMD
+
+//! \brief Resolve the selection kernel supported by the CPU
+//!
+//! \return SelectKernel  - the selection kernel
+SelectKernel selectKernel() noexcept
+{
+#ifdef IDSET_SIMD
+	__builtin_cpu_init();
+	if(__builtin_cpu_supports("avx512f"))
+		return selectIdsAvx512;
+	if(__builtin_cpu_supports("avx2"))
+		return selectIdsAvx2;
+#endif // IDSET_SIMD
+	return selectIdsScalar;
+}
+
+}  // namespace
+
+namespace daoc {
+
+size_t selectIds(const uint64_t* words, size_t nwords, const uint32_t* ids, size_t num
+	, uint32_t* sel) noexcept
+{
+	static const SelectKernel  kernel = selectKernel();
+	return kernel(words, nwords, ids, num, sel);
+}
+
+}  // daoc
@@ -0,0 +1,442 @@
+//! \brief Adaptive (dense bitmap or roaring-style) set of the node ids
+//!
+//! \license Apache License, Version 2.0: http://www.apache.org/licenses/LICENSE-2.0.html
+//! > 	Simple explanation: https://tldrlegal.com/license/apache-license-2.0-(apache-2.0)
+//!
+//! Copyright (c)
+//! \authr Artem Lutov
+//! \email luart@ya.ru
+//! \date 2026-10-18
+
+#ifndef IDSET_HPP
+#define IDSET_HPP
+
+#include <cstdint>  // uintX_t
+#include <vector>
+#include <map>
+#include <memory>  // allocator
+#include <algorithm>  // fill, lower_bound, binary_search
+#include <iterator>  // forward_iterator_tag, next
+#include <type_traits>  // is_integral, is_unsigned
+
+
+namespace daoc {
+
+using std::vector;
+using std::is_integral;
+using std::is_unsigned;
+
+// Function Declarations -----------------------------------------------
+//! \brief Select the ids present in the bitmap (filter and compact)
+//! \note The selection is branch-free, so it does not suffer from the
+//! 	mispredictions on ~50% of the present ids
+//!
+//! \tparam Id  - type of the ids
+//! \param words const uint64_t*  - bitmap words
+//! \param nwords size_t  - the number of bitmap words
+//! \param ids const Id*  - the ids to be tested
+//! \param num size_t  - the number of ids
+//! \param sel uint32_t*  - indices of the present ids in the ascending order,
+//! 	should have a capacity of num
+//! \return size_t  - the number of present ids
+template <typename Id>
+size_t selectIds(const uint64_t* words, size_t nwords, const Id* ids, size_t num
+	, uint32_t* sel) noexcept
+{
+	size_t  n = 0;  // The number of selected ids
+	for(size_t i = 0; i < num; ++i) {
+		const size_t  iw = size_t(ids[i]) >> 6;
+		sel[n] = i;
+		n += iw < nwords && (words[iw] >> (ids[i] & 63) & 1);
+	}
+	return n;
+}
+
+//! \copydoc selectIds
+//! \note The ids are tested by the gathered bitmap words and compacted by the
+//! 	compress-store (AVX-512) or by the permutation table (AVX2) if supported
+//! 	by the CPU, which is identified on the first call
+size_t selectIds(const uint64_t* words, size_t nwords, const uint32_t* ids, size_t num
+	, uint32_t* sel) noexcept;
+
+// Type Declarations ---------------------------------------------------
+//! \brief Adaptive set of the ids, which is efficient for both the dense ids
+//! 	(i.e. max id ~ the number of ids) and the sparse ones, and iterates the ids
+//! 	in the ascending order
+//! \note The ids are stored in the dense bitmap while it covers them economically,
+//! 	i.e. its size is comparable to the number of ids. The ids beyond the bitmap
+//! 	are stored in the roaring-style containers of 2^16 ids having the same high
+//! 	bits, which are the sorted arrays of the low bits converted to the bitmaps
+//! 	on their filling. The bitmap is extended (absorbing the containers) when
+//! 	the number of ids grows.
+//! 	The memory consumption is min(max(id) / 8, ~2 * size + the containers overhead) bytes.
+//!
+//! \tparam Id  - type of the ids
+//! \tparam Allocator  - allocator of the bitmap words
+template <typename Id=uint32_t, typename Allocator=std::allocator<uint64_t>>
+class IdSet {
+	static_assert(is_integral<Id>::value && is_unsigned<Id>::value
+		, "IdSet, types constraints are violated");
+public:
+	using Word = uint64_t;  //!< Bitmap word
+	constexpr static unsigned  wbits = 64;  //!< The number of bits in the word
+	constexpr static unsigned  wshift = 6;  //!< Shift of the id to get the word index
+	constexpr static unsigned  cshift = 16;  //!< Shift of the id to get the key of the container
+	constexpr static size_t  cwords = size_t(1) << (cshift - wshift);  //!< The number of words in the container bitmap
+	constexpr static size_t  arraymax = 4096;  //!< Max number of ids in the array container
+	constexpr static size_t  densemin = size_t(1) << 20;  //!< The ids below are always stored in the dense bitmap
+	constexpr static size_t  densefactor = 16;  //!< Max ratio of the ids covered by the dense bitmap to the number of ids
+private:
+	//! Allocator of the other type values
+	template <typename T>
+	using Alloc = typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+	using Low = uint16_t;  //!< Low bits of the id in the container
+
+	//! \brief Container of the sparse ids having the same high bits (key)
+	struct Container {
+		vector<Low, Alloc<Low>>  vals;  //!< Ordered low bits of the ids in the array container
+		vector<Word, Allocator>  bits;  //!< Bitmap of the low bits in the bitmap container, empty for the array one
+		size_t  size;  //!< The number of ids
+
+		Container(): vals(), bits(), size(0)  {}
+	};
+	//! Containers by the keys
+	//! \note The ordered map is used rather than the sorted vector to insert the
+	//! 	containers of the random sparse ids in the logarithmic time
+	using Containers = std::map<Id, Container, std::less<Id>, Alloc<std::pair<const Id, Container>>>;
+
+	vector<Word, Allocator>  m_words;  //!< Dense bitmap words, the number is a multiple of cwords
+	Containers  m_sparse;  //!< Containers of the ids beyond the dense bitmap
+	size_t  m_size;  //!< The number of ids in the set
+public:
+	//! \brief Forward iterator of the ids in the ascending order
+	class const_iterator {
+		using ContIt = typename Containers::const_iterator;
+
+		const IdSet*  m_set;  //!< Iterating set
+		size_t  m_iw;  //!< Index of the current dense word, the number of words for the containers
+		ContIt  m_ic;  //!< The current container
+		size_t  m_pos;  //!< Position in the array container or index of the word in the bitmap container
+		Word  m_rem;  //!< Remained (not iterated) bits of the current word
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = Id;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const Id*;
+		using reference = Id;
+
+		const_iterator(const IdSet* set, bool end) noexcept
+		: m_set(set), m_iw(end ? set->m_words.size() : 0), m_ic(set->m_sparse.end()), m_pos(0), m_rem(0)
+		{
+			if(end)
+				return;
+			if(!set->m_words.empty())
+				m_rem = set->m_words.front();
+			else enter(set->m_sparse.begin());
+			seek();
+		}
+
+		const_iterator(const const_iterator&)=default;
+
+		const_iterator& operator =(const const_iterator&)=default;
+
+		Id operator *() const noexcept
+		{
+			if(m_iw < m_set->m_words.size())
+				return (m_iw << wshift) + __builtin_ctzll(m_rem);
+			const Container&  cont = m_ic->second;
+			const Id  base = Id(m_ic->first) << cshift;
+			return cont.bits.empty() ? base + cont.vals[m_pos]
+				: base + (m_pos << wshift) + __builtin_ctzll(m_rem);
+		}
+
+		const_iterator& operator ++() noexcept
+		{
+			if(m_iw < m_set->m_words.size() || !m_ic->second.bits.empty())
+				m_rem &= m_rem - 1;  // Reset the lowest set bit
+			else ++m_pos;
+			seek();
+			return *this;
+		}
+
+		const_iterator operator ++(int) noexcept
+		{
+			const_iterator  it = *this;
+			++*this;
+			return it;
+		}
+
+		bool operator ==(const const_iterator& it) const noexcept
+			{ return m_iw == it.m_iw && m_ic == it.m_ic && m_pos == it.m_pos && m_rem == it.m_rem; }
+
+		bool operator !=(const const_iterator& it) const noexcept  { return !(*this == it); }
+	private:
+		//! \brief Enter the container
+		//!
+		//! \param ic ContIt  - the container
+		void enter(ContIt ic) noexcept
+		{
+			m_ic = ic;
+			m_pos = 0;
+			m_rem = ic != m_set->m_sparse.end() && !ic->second.bits.empty()
+				? ic->second.bits.front() : 0;
+		}
+
+		//! \brief Seek the present id
+		void seek() noexcept
+		{
+			const auto&  words = m_set->m_words;
+			if(m_iw < words.size()) {
+				while(!m_rem && ++m_iw < words.size())
+					m_rem = words[m_iw];
+				if(m_rem)
+					return;
+				m_iw = words.size();
+				enter(m_set->m_sparse.begin());
+			}
+			for(; m_ic != m_set->m_sparse.end(); enter(std::next(m_ic))) {
+				const Container&  cont = m_ic->second;
+				if(cont.bits.empty()) {
+					if(m_pos < cont.vals.size())
+						return;
+					continue;
+				}
+				while(!m_rem && ++m_pos < cont.bits.size())
+					m_rem = cont.bits[m_pos];
+				if(m_rem)
+					return;
+			}
+			m_pos = 0;
+			m_rem = 0;
+		}
+	};
+
+	//! \brief Default constructor
+	IdSet(): m_words(), m_sparse(), m_size(0)  {}
+
+	//! \brief Reserve the space for the ids < idsnum in the dense bitmap
+	//!
+	//! \param idsnum size_t  - the bound of the ids
+	//! \return void
+	void reserve(size_t idsnum)  { extend(idsnum); }
+
+	//! \brief Insert the id
+	//!
+	//! \param id Id  - the id to be inserted
+	//! \return bool  - whether the id has been inserted (was not present)
+	bool insert(Id id)
+	{
+		size_t  iw = size_t(id) >> wshift;
+		if(iw >= m_words.size()) {
+			// Note: the bitmap grows geometrically to amortize the reallocations,
+			// but only while it covers the ids economically
+			const size_t  bound = std::max(size_t(densemin), densefactor * (m_size + 1));
+			if(size_t(id) >= bound)
+				return insertSparse(id);
+			size_t  idsnum = std::max(size_t(id) + 1, m_words.size() * wbits * 3 / 2);
+			// Absorb the containers if affordable
+			if(!m_sparse.empty())
+				idsnum = std::max(idsnum, (size_t(m_sparse.rbegin()->first) + 1) << cshift);
+			extend(std::min(idsnum, bound));
+		}
+		const Word  bit = Word(1) << (id & (wbits - 1));
+		if(m_words[iw] & bit)
+			return false;
+		m_words[iw] |= bit;
+		++m_size;
+		return true;
+	}
+
+	//! \brief Insert the range of ids
+	//!
+	//! \tparam It  - ids iterator
+	//! \param begin It  - begin of the range
+	//! \param end It  - end of the range
+	//! \return void
+	template <typename It>
+	void insert(It begin, It end)
+	{
+		for(; begin != end; ++begin)
+			insert(*begin);
+	}
+
+	//! \brief The number of the specified id in the set
+	//!
+	//! \param id Id  - the id to be checked
+	//! \return size_t  - 1 if the id is present, 0 otherwise
+	size_t count(Id id) const noexcept
+	{
+		const size_t  iw = size_t(id) >> wshift;
+		if(iw < m_words.size())
+			return m_words[iw] >> (id & (wbits - 1)) & 1;
+		if(m_sparse.empty())
+			return 0;
+		const auto  icont = m_sparse.find(id >> cshift);
+		if(icont == m_sparse.end())
+			return 0;
+		const Container&  cont = icont->second;
+		const Low  low = id;
+		return cont.bits.empty() ? std::binary_search(cont.vals.begin(), cont.vals.end(), low)
+			: cont.bits[low >> wshift] >> (low & (wbits - 1)) & 1;
+	}
+
+	//! \brief Select the present ids (filter and compact)
+	//! \note The selection is vectorized only for the ids stored in the dense bitmap
+	//!
+	//! \param ids const Id*  - the ids to be tested
+	//! \param num size_t  - the number of ids
+	//! \param sel uint32_t*  - indices of the present ids in the ascending order,
+	//! 	should have a capacity of num
+	//! \return size_t  - the number of present ids
+	size_t select(const Id* ids, size_t num, uint32_t* sel) const noexcept
+	{
+		if(m_sparse.empty())
+			return selectIds(m_words.data(), m_words.size(), ids, num, sel);
+		size_t  n = 0;  // The number of selected ids
+		for(size_t i = 0; i < num; ++i) {
+			sel[n] = i;
+			n += count(ids[i]);
+		}
+		return n;
+	}
+
+	//! \brief The number of ids in the set
+	size_t size() const noexcept  { return m_size; }
+
+	//! \brief The set is empty
+	bool empty() const noexcept  { return !m_size; }
+
+	//! \brief Clear the set retaining the allocated dense bitmap
+	//!
+	//! \return void
+	void clear() noexcept
+	{
+		std::fill(m_words.begin(), m_words.end(), 0);
+		m_sparse.clear();
+		m_size = 0;
+	}
+
+	//! \brief Unite with the specified set
+	//!
+	//! \param ids const IdSet&  - the set to be merged
+	//! \return IdSet&  - self
+	IdSet& operator |=(const IdSet& ids)
+	{
+		extend(ids.m_words.size() * wbits);
+		// Note: the loop is vectorized by the compiler
+		for(size_t i = 0; i < ids.m_words.size(); ++i)
+			m_words[i] |= ids.m_words[i];
+		for(const auto& cont: ids.m_sparse) {
+			if((size_t(cont.first) << cshift) < m_words.size() * wbits) {
+				forEach(cont, [this](Id id) {
+					m_words[size_t(id) >> wshift] |= Word(1) << (id & (wbits - 1));
+				});
+				continue;
+			}
+			const auto  icont = m_sparse.lower_bound(cont.first);
+			if(icont == m_sparse.end() || icont->first != cont.first)
+				m_sparse.insert(icont, cont);
+			else forEach(cont, [this](Id id) { insertSparse(id); });
+		}
+		recount();
+		return *this;
+	}
+
+	//! \brief Begin of the ids in the ascending order
+	const_iterator begin() const noexcept  { return const_iterator(this, false); }
+
+	//! \brief End of the ids
+	const_iterator end() const noexcept  { return const_iterator(this, true); }
+protected:
+	//! \brief Apply the function to each id of the container
+	//!
+	//! \tparam F  - the function: void (Id id)
+	//! \param cont const typename Containers::value_type&  - the keyed container
+	//! \param func F  - the function
+	//! \return void
+	template <typename F>
+	static void forEach(const typename Containers::value_type& cont, F func)
+	{
+		const Id  base = Id(cont.first) << cshift;
+		const auto&  bits = cont.second.bits;
+		if(bits.empty()) {
+			for(auto low: cont.second.vals)
+				func(base + low);
+			return;
+		}
+		for(size_t i = 0; i < bits.size(); ++i)
+			for(Word rem = bits[i]; rem; rem &= rem - 1)
+				func(base + (i << wshift) + __builtin_ctzll(rem));
+	}
+
+	//! \brief Extend the dense bitmap to cover the ids < idsnum absorbing
+	//! 	the containers of the covered ids
+	//!
+	//! \param idsnum size_t  - the bound of the ids
+	//! \return void
+	void extend(size_t idsnum)
+	{
+		// Note: the bitmap consists of the whole containers, so each container
+		// is either covered or not
+		const size_t  nwords = (idsnum + (size_t(1) << cshift) - 1) >> cshift << (cshift - wshift);
+		if(m_words.size() >= nwords)
+			return;
+		m_words.resize(nwords);
+		auto  icont = m_sparse.begin();
+		for(; icont != m_sparse.end() && (size_t(icont->first) << cshift) < nwords * wbits; ++icont)
+			forEach(*icont, [this](Id id) {
+				m_words[size_t(id) >> wshift] |= Word(1) << (id & (wbits - 1));
+			});
+		m_sparse.erase(m_sparse.begin(), icont);
+	}
+
+	//! \brief Insert the id beyond the dense bitmap to the container
+	//!
+	//! \param id Id  - the id to be inserted
+	//! \return bool  - whether the id has been inserted (was not present)
+	bool insertSparse(Id id)
+	{
+		Container&  cont = m_sparse[id >> cshift];
+		const Low  low = id;
+		if(cont.bits.empty()) {
+			auto  ival = std::lower_bound(cont.vals.begin(), cont.vals.end(), low);
+			if(ival != cont.vals.end() && *ival == low)
+				return false;
+			if(cont.vals.size() < arraymax)
+				cont.vals.insert(ival, low);
+			else {
+				// Convert the filled array container to the bitmap
+				cont.bits.resize(cwords);
+				for(auto val: cont.vals)
+					cont.bits[val >> wshift] |= Word(1) << (val & (wbits - 1));
+				decltype(cont.vals)().swap(cont.vals);
+				cont.bits[low >> wshift] |= Word(1) << (low & (wbits - 1));
+			}
+		} else {
+			Word&  word = cont.bits[low >> wshift];
+			const Word  bit = Word(1) << (low & (wbits - 1));
+			if(word & bit)
+				return false;
+			word |= bit;
+		}
+		++cont.size;
+		++m_size;
+		return true;
+	}
+
+	//! \brief Evaluate the number of ids
+	//!
+	//! \return void
+	void recount() noexcept
+	{
+		m_size = 0;
+		for(auto w: m_words)
+			m_size += __builtin_popcountll(w);
+		for(const auto& cont: m_sparse)
+			m_size += cont.second.size;
+	}
+};
+
+}  // daoc
+
+#endif // IDSET_HPP
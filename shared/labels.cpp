@@ -0,0 +1,111 @@
+//! \brief Interning table of the string labels of the nodes mapping them to
+//! 	the dense ids
+//!
+//! \license Apache License, Version 2.0: http://www.apache.org/licenses/LICENSE-2.0.html
+//! > 	Simple explanation: https://tldrlegal.com/license/apache-license-2.0-(apache-2.0)
+//!
+//! Copyright (c)
+//! \authr Artem Lutov
+//! \email luart@ya.ru
+//! \date 2026-10-18
+
+#include <cstring>  // memcpy
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define LABELS_SIMD 1
+#include <immintrin.h>
+#endif // __GNUC__ && __x86_64__
+
+#include "labels.hpp"
+
+
+using namespace daoc;
+
+namespace {
+
+//! \brief Hashing kernel of the labels
+using HashKernel = uint64_t (*)(const char* str, size_t len) noexcept;
+
+//! \brief Multiplicative mixing of the word
+//!
+//! \param val uint64_t  - the value to be mixed
+//! \return uint64_t  - mixed value
+inline uint64_t mix(uint64_t val) noexcept
+{
+	const unsigned __int128  prod = static_cast<unsigned __int128>(val) * 0x9E3779B97F4A7C15;
+	return uint64_t(prod) ^ uint64_t(prod >> 64);
+}
+
+//! \brief Hash the label by 8 bytes
+//!
+//! \param str const char*  - the label
+//! \param len size_t  - length of the label
+//! \return uint64_t  - resulting hash
+uint64_t hashScalar(const char* str, size_t len) noexcept
+{
+	uint64_t  hash = mix(len ^ 0xA4093822299F31D0);
+	for(; len >= sizeof(uint64_t); len -= sizeof(uint64_t), str += sizeof(uint64_t)) {
+		uint64_t  word;
+		memcpy(&word, str, sizeof word);  // Note: unaligned access is handled by the compiler
+		hash = mix(hash ^ word);
+	}
+	if(len) {
+		uint64_t  word = 0;
+		memcpy(&word, str, len);
+		hash = mix(hash ^ word);
+	}
+	return mix(hash);
+}
+
+#ifdef LABELS_SIMD
+//! \brief Hash the label by 16 bytes with the AES rounds
+//!
+//! \param str const char*  - the label
+//! \param len size_t  - length of the label
+//! \return uint64_t  - resulting hash
+__attribute__((target("aes")))
+uint64_t hashAes(const char* str, size_t len) noexcept
+{
+	const __m128i  key = _mm_set_epi64x(0x243F6A8885A308D3, 0x13198A2E03707344);
+	__m128i  hash = _mm_set_epi64x(len, 0xA4093822299F31D0);
+	for(; len >= sizeof(__m128i); len -= sizeof(__m128i), str += sizeof(__m128i))
+		hash = _mm_aesenc_si128(_mm_xor_si128(hash
+			, _mm_loadu_si128(reinterpret_cast<const __m128i*>(str))), key);
+	if(len) {
+		// Note: the tail is copied to not read beyond the label
+		char  tail[sizeof(__m128i)] = {};
+		memcpy(tail, str, len);
+		hash = _mm_aesenc_si128(_mm_xor_si128(hash
+			, _mm_loadu_si128(reinterpret_cast<const __m128i*>(tail))), key);
+	}
+	// Diffuse all bytes of the state
+	hash = _mm_aesenc_si128(hash, key);
+	hash = _mm_aesenc_si128(hash, key);
+	return _mm_cvtsi128_si64(hash) ^ _mm_cvtsi128_si64(_mm_unpackhi_epi64(hash, hash));
+}
+#endif // LABELS_SIMD
+
+//! \brief Resolve the hashing kernel supported by the CPU
+//!
+//! \return HashKernel  - the hashing kernel
+HashKernel hashKernel() noexcept
+{
+#ifdef LABELS_SIMD
+	__builtin_cpu_init();
+	if(__builtin_cpu_supports("aes"))
+		return hashAes;
+#endif // LABELS_SIMD
+	return hashScalar;
+}
+
+}  // namespace
+
+namespace daoc {
+
+uint64_t hashLabel(const char* str, size_t len) noexcept
+{
+	static const HashKernel  kernel = hashKernel();
+	return kernel(str, len);
+}
+
+}  // daoc
@@ -0,0 +1,173 @@
+//! \brief Interning table of the string labels of the nodes mapping them to
+//! 	the dense ids
+//!
+//! \license Apache License, Version 2.0: http://www.apache.org/licenses/LICENSE-2.0.html
+//! > 	Simple explanation: https://tldrlegal.com/license/apache-license-2.0-(apache-2.0)
+//!
+//! Copyright (c)
+//! \authr Artem Lutov
+//! \email luart@ya.ru
+//! \date 2026-10-18
+
+#ifndef LABELS_HPP
+#define LABELS_HPP
+
+#include <cstdint>  // uintX_t
+#include <cstring>  // memcpy, memcmp
+#include <vector>
+#include <limits>
+#include <stdexcept>  // overflow_error
+#include <type_traits>  // is_integral, is_unsigned
+
+#include "memstat.hpp"
+
+
+namespace daoc {
+
+using std::vector;
+using std::is_integral;
+using std::is_unsigned;
+
+// Function Declarations -----------------------------------------------
+//! \brief Hash of the string label
+//! \note The label is hashed by 16 bytes with the AES rounds if supported by
+//! 	the CPU, which is identified on the first call, and by 8 bytes with the
+//! 	multiplicative mixing otherwise. So, the hashes are not persistent across
+//! 	the hosts.
+//!
+//! \param str const char*  - the label
+//! \param len size_t  - length of the label
+//! \return uint64_t  - resulting hash
+uint64_t hashLabel(const char* str, size_t len) noexcept;
+
+// Type Declarations ---------------------------------------------------
+//! \brief Interning table of the string labels, which maps each distinct label
+//! 	to the dense id in the order of the first occurrence
+//! \note The label bytes are stored in the arena of the large blocks, which are
+//! 	never reallocated. The labels are indexed by the open-addressing table with
+//! 	the linear probing, whose slots hold the ids with the hashes of the labels,
+//! 	so the labels are compared only on the matching hashes.
+//!
+//! \tparam Id  - type of the ids
+template <typename Id=uint32_t>
+class LabelTable {
+	static_assert(is_integral<Id>::value && is_unsigned<Id>::value
+		, "LabelTable, types constraints are violated");
+
+	//! Memory accounting allocator
+	template <typename T>
+	using Allocator = CountingAllocator<T, MemUse::LABELS>;
+
+	constexpr static Id  ID_NONE = std::numeric_limits<Id>::max();  //!< Id of the empty slot
+	constexpr static size_t  blocksize = 1 << 20;  //!< Size of the arena block
+
+	//! \brief Slot of the index
+	struct Slot {
+		uint32_t  hash;  //!< Hash of the label
+		Id  id;  //!< Id of the label, ID_NONE for the empty slot
+	};
+
+	//! \brief Interned label
+	struct Label {
+		const char*  str;  //!< Null-terminated label in the arena
+		size_t  len;  //!< Length of the label
+	};
+
+	vector<vector<char, Allocator<char>>>  m_blocks;  //!< Arena of the label bytes
+	size_t  m_left;  //!< The number of free bytes in the last block
+	vector<Label, Allocator<Label>>  m_labels;  //!< Labels by the ids
+	vector<Slot, Allocator<Slot>>  m_slots;  //!< Index of the labels, the number is a power of 2
+public:
+    //! \brief Default constructor
+	LabelTable(): m_blocks(), m_left(0), m_labels(), m_slots(64, {0, ID_NONE})  {}
+
+    //! \brief Copy constructor
+	LabelTable(const LabelTable&)=delete;
+
+    //! \brief Copy assignment
+	LabelTable& operator= (const LabelTable&)=delete;
+
+    //! \brief Intern the label
+    //! \note The trailing carriage return (CRLF line ending) is not a part of the label
+    //!
+    //! \param str const char*  - the label, might be not null-terminated
+    //! \param len size_t  - length of the label
+    //! \return Id  - id of the label
+	Id intern(const char* str, size_t len)
+	{
+		if(len && str[len - 1] == '\r')
+			--len;
+		// Keep the load factor <= 1/2
+		if(m_labels.size() * 2 >= m_slots.size())
+			grow();
+		const uint64_t  hash64 = hashLabel(str, len);
+		const uint32_t  hash = hash64 ^ hash64 >> 32;
+		const size_t  mask = m_slots.size() - 1;
+		for(size_t i = hash & mask;; i = (i + 1) & mask) {
+			Slot&  slot = m_slots[i];
+			if(slot.id == ID_NONE) {
+				slot = {hash, add(str, len)};
+				return slot.id;
+			}
+			if(slot.hash == hash) {
+				const Label&  lbl = m_labels[slot.id];
+				if(lbl.len == len && !memcmp(lbl.str, str, len))
+					return slot.id;
+			}
+		}
+	}
+
+    //! \brief Label of the id
+    //!
+    //! \param id Id  - id of the label
+    //! \return const char*  - null-terminated label
+	const char* label(Id id) const noexcept  { return m_labels[id].str; }
+
+    //! \brief Length of the label of the id
+	size_t labelSize(Id id) const noexcept  { return m_labels[id].len; }
+
+    //! \brief The number of labels
+	size_t size() const noexcept  { return m_labels.size(); }
+protected:
+    //! \brief Store the label in the arena assigning the next id
+    //!
+    //! \param str const char*  - the label
+    //! \param len size_t  - length of the label
+    //! \return Id  - id of the label
+	Id add(const char* str, size_t len)
+	{
+		if(m_labels.size() >= ID_NONE)
+			throw std::overflow_error("LabelTable::add(), the number of labels exceeds the Id type");
+		if(m_left <= len) {
+			// Note: the long labels are stored in the dedicated blocks
+			m_blocks.emplace_back(std::max(size_t(blocksize), len + 1));
+			m_left = m_blocks.back().size();
+		}
+		char*  pos = m_blocks.back().data() + m_blocks.back().size() - m_left;
+		memcpy(pos, str, len);
+		pos[len] = 0;
+		m_left -= len + 1;
+		m_labels.push_back({pos, len});
+		return m_labels.size() - 1;
+	}
+
+    //! \brief Double the index reinserting the slots by their hashes
+	void grow()
+	{
+		vector<Slot, Allocator<Slot>>  slots(m_slots.size() * 2, {0, ID_NONE});
+		const size_t  mask = slots.size() - 1;
+		for(const auto& slot: m_slots) {
+			if(slot.id == ID_NONE)
+				continue;
+			size_t  i = slot.hash & mask;
+			while(slots[i].id != ID_NONE)
+				i = (i + 1) & mask;
+			slots[i] = slot;
+		}
+		m_slots.swap(slots);
+	}
+};
+
+}  // daoc
+
+#endif // LABELS_HPP
@@ -0,0 +1,152 @@
+//! \brief Memory accounting per subsystem by the counting allocators of the
+//! 	long-lived containers
+//!
+//! \license Apache License, Version 2.0: http://www.apache.org/licenses/LICENSE-2.0.html
+//! > 	Simple explanation: https://tldrlegal.com/license/apache-license-2.0-(apache-2.0)
+//!
+//! Copyright (c)
+//! \authr Artem Lutov
+//! \email luart@ya.ru
+//! \date 2026-10-18
+
+#include <cstring>  // strlen, memset
+#include <csignal>  // sigaction
+
+#ifdef __unix__
+#include <unistd.h>  // write
+#endif // __unix__
+
+#include "memstat.hpp"
+
+
+namespace daoc {
+
+//! Titles of the subsystems followed by the total
+static const char* const  useTitles[MemStats::usesNum + 1] = {
+	"node base",
+	"dedup table",
+	"hash chains",
+	"buffers",
+	"indices",
+	"labels",
+	"member stamps",
+	"TOTAL"
+};
+
+//! \brief Append the text to the buffer aligning it to the field width
+//! \note The function is async-signal-safe
+//!
+//! \param pos char*  - position in the buffer
+//! \param end char*  - end of the buffer
+//! \param text const char*  - the appending text
+//! \param width size_t  - min width of the field
+//! \param left=false bool  - left-align the text instead of the right alignment
+//! \return char*  - position after the appended field
+static char* appendField(char* pos, char* end, const char* text, size_t width, bool left=false) noexcept
+{
+	const size_t  len = strlen(text);
+	size_t  pad = width > len ? width - len : 0;  // Padding of the field
+	if(!left)
+		for(; pad && pos < end; --pad)
+			*pos++ = ' ';
+	for(size_t i = 0; i < len && pos < end; ++i)
+		*pos++ = text[i];
+	for(; pad && pos < end; --pad)
+		*pos++ = ' ';
+	return pos;
+}
+
+//! \brief Append the number to the buffer aligning it to the field width
+//! \note The function is async-signal-safe
+//!
+//! \param pos char*  - position in the buffer
+//! \param end char*  - end of the buffer
+//! \param val size_t  - the appending value
+//! \param width size_t  - min width of the field, the number is right-aligned
+//! \return char*  - position after the appended field
+static char* appendField(char* pos, char* end, size_t val, size_t width) noexcept
+{
+	char  digits[24];
+	char*  dpos = digits + sizeof digits - 1;
+	*dpos = 0;
+	do *--dpos = '0' + val % 10;
+	while(val /= 10);
+	return appendField(pos, end, dpos, width);
+}
+
+// MemStats Types definitions --------------------------------------------------
+MemStats& MemStats::global() noexcept
+{
+	static MemStats  stats;
+	return stats;
+}
+
+size_t MemStats::format(char* buf, size_t size) const noexcept
+{
+	if(!size)
+		return 0;
+	char*  pos = buf;
+	char* const  end = buf + size - 1;  // Note: the last byte is reserved for the null terminator
+	constexpr size_t  twidth = 14;  // Width of the titles
+	constexpr size_t  fwidth = 16;  // Width of the fields
+	pos = appendField(pos, end, "Memory use:", 2 + twidth, true);
+	pos = appendField(pos, end, "Live bytes", fwidth);
+	pos = appendField(pos, end, "Peak bytes", fwidth);
+	pos = appendField(pos, end, "Allocations", fwidth);
+	for(unsigned i = 0; i <= usesNum; ++i) {
+		const Counters&  cs = m_counters[i];
+		pos = appendField(pos, end, "\n  ", 0);
+		pos = appendField(pos, end, useTitles[i], twidth, true);
+		pos = appendField(pos, end, cs.live.load(std::memory_order_relaxed), fwidth);
+		pos = appendField(pos, end, cs.peak.load(std::memory_order_relaxed), fwidth);
+		pos = appendField(pos, end, cs.allocs.load(std::memory_order_relaxed), fwidth);
+	}
+	pos = appendField(pos, end, "\n", 0);
+	*pos = 0;
+	return pos - buf;
+}
+
+void MemStats::report(FILE* fout) const
+{
+	char  buf[1024];
+	format(buf, sizeof buf);
+	fputs(buf, fout);
+}
+
+//! \brief Signal handler reporting the global memory statistics
+//!
+//! \param signum int  - the signal number
+//! \return void
+static void reportSignaled(int signum) noexcept
+{
+	(void)signum;
+	char  buf[1024];
+	const size_t  len = MemStats::global().format(buf, sizeof buf);
+#ifdef __unix__
+	// Note: the formatting and write() are async-signal-safe unlike the stdio
+	if(write(STDERR_FILENO, buf, len) < 0)
+		return;
+#else
+	(void)len;
+#endif // __unix__
+}
+
+bool MemStats::reportOn(int signum) noexcept
+{
+#ifdef __unix__
+	// Note: the statistics are constructed before the handler can access them
+	global();
+	struct sigaction  act;
+	memset(&act, 0, sizeof act);
+	act.sa_handler = reportSignaled;
+	// Restart the interrupted system calls (e.g. reading of the input)
+	act.sa_flags = SA_RESTART;
+	sigemptyset(&act.sa_mask);
+	return !sigaction(signum, &act, nullptr);
+#else
+	(void)signum;
+	return false;
+#endif // __unix__
+}
+
+}  // daoc
@@ -0,0 +1,183 @@
+//! \brief Memory accounting per subsystem by the counting allocators of the
+//! 	long-lived containers
+//!
+//! \license Apache License, Version 2.0: http://www.apache.org/licenses/LICENSE-2.0.html
+//! > 	Simple explanation: https://tldrlegal.com/license/apache-license-2.0-(apache-2.0)
+//!
+//! Copyright (c)
+//! \authr Artem Lutov
+//! \email luart@ya.ru
+//! \date 2026-10-18
+
+#ifndef MEMSTAT_HPP
+#define MEMSTAT_HPP
+
+#include <cstdint>  // uintX_t
+#include <cstdio>  // FILE
+#include <string>
+#include <memory>  // allocator
+#include <atomic>
+
+
+namespace daoc {
+
+using std::atomic;
+
+// Memory Accounting Types -----------------------------------------------------
+//! \brief Subsystems consuming the memory
+enum class MemUse: uint8_t {
+	NODE_BASE,  //!< Sets of the unique nodes (node base, worker nodes)
+	DEDUP_TABLE,  //!< Deduplication table of the cluster fingerprints (buckets and nodes)
+	HASH_CHAINS,  //!< Per-bucket vectors (chains) of the cluster fingerprints
+	BUFFERS,  //!< Line and chunk buffers of the input, writing lines of the clusters
+	INDICES,  //!< Entries of the fingerprint and posting indices, supports of the clusters
+	LABELS,  //!< Arena and index of the interned string labels of the nodes
+	MEMBER_STAMPS,  //!< Generation stamps of the members to filter their repetitions
+	NUM  //!< The number of subsystems
+};
+
+//! \brief Memory statistics: live and peak bytes, and the number of allocations
+//! 	per subsystem and in total
+//! \note The accounting is a few relaxed atomic operations per allocation, so
+//! 	it is applied to the long-lived containers, which are rarely reallocated.
+//! 	The statistics can be reported from the signal handler.
+class MemStats {
+public:
+	constexpr static unsigned  usesNum = static_cast<unsigned>(MemUse::NUM);  //!< The number of subsystems
+
+	//! \brief Memory counters
+	struct Counters {
+		atomic<size_t>  live;  //!< Allocated bytes
+		atomic<size_t>  peak;  //!< Peak of the allocated bytes
+		atomic<size_t>  allocs;  //!< The number of allocations
+	};
+private:
+	Counters  m_counters[usesNum + 1];  //!< Counters of each subsystem followed by the total
+public:
+    //! \brief Default constructor
+	MemStats() noexcept: m_counters()  {}
+
+    //! \brief Copy constructor
+	MemStats(const MemStats&)=delete;
+
+    //! \brief Copy assignment
+	MemStats& operator= (const MemStats&)=delete;
+
+    //! \brief Global memory statistics of the application
+	static MemStats& global() noexcept;
+
+    //! \brief Account the allocation
+    //!
+    //! \param use MemUse  - consuming subsystem
+    //! \param bytes size_t  - the number of allocated bytes
+    //! \return void
+	void allocate(MemUse use, size_t bytes) noexcept
+	{
+		account(m_counters[static_cast<unsigned>(use)], bytes);
+		account(m_counters[usesNum], bytes);
+	}
+
+    //! \brief Account the deallocation
+    //!
+    //! \param use MemUse  - consuming subsystem
+    //! \param bytes size_t  - the number of deallocated bytes
+    //! \return void
+	void deallocate(MemUse use, size_t bytes) noexcept
+	{
+		m_counters[static_cast<unsigned>(use)].live.fetch_sub(bytes, std::memory_order_relaxed);
+		m_counters[usesNum].live.fetch_sub(bytes, std::memory_order_relaxed);
+	}
+
+    //! \brief Counters of the subsystem
+	const Counters& counters(MemUse use) const noexcept
+		{ return m_counters[static_cast<unsigned>(use)]; }
+
+    //! \brief Format the report of the statistics
+    //! \note The formatting is async-signal-safe
+    //!
+    //! \param buf char*  - output buffer
+    //! \param size size_t  - size of the buffer
+    //! \return size_t  - length of the report without the null terminator
+	size_t format(char* buf, size_t size) const noexcept;
+
+    //! \brief Output the report of the statistics
+    //!
+    //! \param fout=stderr FILE*  - output stream
+    //! \return void
+	void report(FILE* fout=stderr) const;
+
+    //! \brief Report the global statistics to the stderr on the signal
+    //! 	(e.g. SIGUSR1) without the interruption of the processing
+    //!
+    //! \param signum int  - the signal number
+    //! \return bool  - the handler is installed
+	static bool reportOn(int signum) noexcept;
+protected:
+    //! \brief Account the allocation in the counters
+    //!
+    //! \param cs Counters&  - counters to be updated
+    //! \param bytes size_t  - the number of allocated bytes
+    //! \return void
+	static void account(Counters& cs, size_t bytes) noexcept
+	{
+		const size_t  live = cs.live.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+		size_t  peak = cs.peak.load(std::memory_order_relaxed);
+		while(peak < live && !cs.peak.compare_exchange_weak(peak, live, std::memory_order_relaxed));
+		cs.allocs.fetch_add(1, std::memory_order_relaxed);
+	}
+};
+
+//! \brief Allocator accounting the memory of the specified subsystem
+//!
+//! \tparam T  - type of the allocated values
+//! \tparam U  - consuming subsystem
+template <typename T, MemUse U>
+struct CountingAllocator {
+	using value_type = T;
+
+	//! \brief Allocator of the other type values accounted to the same subsystem
+	template <typename V>
+	struct rebind {
+		using other = CountingAllocator<V, U>;
+	};
+
+	CountingAllocator() noexcept=default;
+
+	template <typename V>
+	CountingAllocator(const CountingAllocator<V, U>&) noexcept  {}
+
+    //! \brief Allocate the values
+    //!
+    //! \param num size_t  - the number of values
+    //! \return T*  - allocated memory
+	T* allocate(size_t num)
+	{
+		T*  vals = std::allocator<T>().allocate(num);
+		MemStats::global().allocate(U, num * sizeof(T));
+		return vals;
+	}
+
+    //! \brief Deallocate the values
+    //!
+    //! \param vals T*  - allocated memory
+    //! \param num size_t  - the number of values
+    //! \return void
+	void deallocate(T* vals, size_t num) noexcept
+	{
+		MemStats::global().deallocate(U, num * sizeof(T));
+		std::allocator<T>().deallocate(vals, num);
+	}
+
+	template <typename V>
+	bool operator ==(const CountingAllocator<V, U>&) const noexcept  { return true; }
+
+	template <typename V>
+	bool operator !=(const CountingAllocator<V, U>&) const noexcept  { return false; }
+};
+
+//! \brief String accounted to the buffers
+using BufferString = std::basic_string<char, std::char_traits<char>, CountingAllocator<char, MemUse::BUFFERS>>;
+
+}  // daoc
+
+#endif // MEMSTAT_HPP
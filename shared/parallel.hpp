@@ -0,0 +1,154 @@
+//! \brief Parallel execution utils
+//!
+//! \license Apache License, Version 2.0: http://www.apache.org/licenses/LICENSE-2.0.html
+//! > 	Simple explanation: https://tldrlegal.com/license/apache-license-2.0-(apache-2.0)
+//!
+//! Copyright (c)
+//! \authr Artem Lutov
+//! \email luart@ya.ru
+//! \date 2026-10-18
+
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <memory>  // unique_ptr
+#include <numeric>  // iota
+#include <algorithm>  // min, max, stable_sort
+
+
+namespace daoc {
+
+using std::vector;
+using std::thread;
+using std::atomic;
+using std::mutex;
+using std::lock_guard;
+
+// Parallel functions ----------------------------------------------------------
+//! \brief The number of workers to be used
+//!
+//! \param threads unsigned  - the requested number of threads, 0 means
+//! 	the number of hardware threads (CPUs)
+//! \return unsigned  - the number of workers, >= 1
+inline unsigned workersNum(unsigned threads=0) noexcept
+{
+	return threads ? threads : std::max(thread::hardware_concurrency(), 1u);
+}
+
+//! \brief Execute the tasks in parallel by the workers fetching the tasks
+//! 	dynamically in the ascending order
+//! \note The calling thread is one of the workers
+//!
+//! \tparam Task  - the task: void (size_t itask, unsigned iworker)
+//!
+//! \param ntasks size_t  - the number of tasks
+//! \param workers unsigned  - the number of workers, >= 1
+//! \param task Task  - the task executor
+//! \return void
+template <typename Task>
+void parallelFor(size_t ntasks, unsigned workers, Task task)
+{
+	workers = std::min<size_t>(std::max(workers, 1u), ntasks);
+	if(workers <= 1) {
+		for(size_t i = 0; i < ntasks; ++i)
+			task(i, 0);
+		return;
+	}
+
+	atomic<size_t>  itask(0);  // Index of the next task
+	auto  worker = [&itask, ntasks, &task](unsigned iworker) {
+		for(size_t i; (i = itask.fetch_add(1, std::memory_order_relaxed)) < ntasks;)
+			task(i, iworker);
+	};
+	vector<thread>  threads;
+	threads.reserve(workers - 1);
+	for(unsigned i = 1; i < workers; ++i)
+		threads.emplace_back(worker, i);
+	worker(0);
+	for(auto& thr: threads)
+		thr.join();
+}
+
+//! \brief Execute the weighted tasks in parallel by the work-stealing workers
+//! \note The tasks are dealt to the queues of the workers round-robin in the
+//! 	descending order of their weights, so the largest tasks are started first.
+//! 	Each worker takes the tasks from the front of its queue and on its exhaustion
+//! 	steals the smallest remained tasks from the back of the other queues. The
+//! 	calling thread is one of the workers.
+//!
+//! \tparam Task  - the task: void (size_t itask, unsigned iworker)
+//!
+//! \param weights const vector<size_t>&  - weights of the tasks (e.g. their sizes)
+//! \param workers unsigned  - the number of workers, >= 1
+//! \param task Task  - the task executor
+//! \return void
+template <typename Task>
+void stealingFor(const vector<size_t>& weights, unsigned workers, Task task)
+{
+	const size_t  ntasks = weights.size();
+	vector<size_t>  order(ntasks);  // Tasks in the descending order of the weights
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [&weights](size_t a, size_t b) noexcept {
+		return weights[a] > weights[b];
+	});
+	workers = std::min<size_t>(std::max(workers, 1u), ntasks);
+	if(workers <= 1) {
+		for(auto i: order)
+			task(i, 0);
+		return;
+	}
+
+	//! Queue of the worker tasks
+	struct Queue {
+		mutex  mtx;  //!< Access synchronization
+		vector<size_t>  tasks;  //!< Tasks in the descending order of the weights
+		size_t  head;  //!< Index of the next own task
+		size_t  tail;  //!< End of the remained tasks, where the tasks are stolen
+
+		Queue(): mtx(), tasks(), head(0), tail(0)  {}
+	};
+	std::unique_ptr<Queue[]>  queues(new Queue[workers]);
+	for(size_t i = 0; i < ntasks; ++i)
+		queues[i % workers].tasks.push_back(order[i]);
+	for(unsigned i = 0; i < workers; ++i)
+		queues[i].tail = queues[i].tasks.size();
+
+	auto  worker = [&queues, workers, ntasks, &task](unsigned iworker) {
+		Queue&  own = queues[iworker];
+		while(true) {
+			size_t  itask = ntasks;  // Index of the task, ntasks if absent
+			{
+				lock_guard<mutex>  lock(own.mtx);
+				if(own.head < own.tail)
+					itask = own.tasks[own.head++];
+			}
+			// Steal the task from another worker
+			// Note: the tasks are not added during the execution, so all queues
+			// are exhausted if the stealing failed
+			for(unsigned i = 1; itask == ntasks && i < workers; ++i) {
+				Queue&  victim = queues[(iworker + i) % workers];
+				lock_guard<mutex>  lock(victim.mtx);
+				if(victim.head < victim.tail)
+					itask = victim.tasks[--victim.tail];
+			}
+			if(itask == ntasks)
+				break;
+			task(itask, iworker);
+		}
+	};
+	vector<thread>  threads;
+	threads.reserve(workers - 1);
+	for(unsigned i = 1; i < workers; ++i)
+		threads.emplace_back(worker, i);
+	worker(0);
+	for(auto& thr: threads)
+		thr.join();
+}
+
+}  // daoc
+
+#endif // PARALLEL_HPP
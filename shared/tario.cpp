@@ -0,0 +1,407 @@
+//! \brief Streaming reader of the tar archives (optionally compressed)
+//!
+//! \license Apache License, Version 2.0: http://www.apache.org/licenses/LICENSE-2.0.html
+//! > 	Simple explanation: https://tldrlegal.com/license/apache-license-2.0-(apache-2.0)
+//!
+//! Copyright (c)
+//! \authr Artem Lutov
+//! \email luart@ya.ru
+//! \date 2026-10-18
+
+#include <cstring>  // memcmp, strtoul
+#include <cassert>
+#include <cerrno>
+#include <csignal>  // SIGPIPE
+#include <algorithm>  // min
+
+#ifdef __unix__
+#include <unistd.h>  // pipe2, fork, dup2, execlp
+#include <fcntl.h>  // O_CLOEXEC, fcntl
+#include <sys/wait.h>  // waitpid
+#endif // __unix__
+
+#include "tario.hpp"
+
+
+using std::min;
+using namespace daoc;
+
+namespace {
+
+//! \brief Tar archive compression
+struct Compression {
+	const char*  ext;  //!< Archive extension
+	const char*  decomp;  //!< Decompressor (nullptr for the uncompressed archive)
+};
+
+//! Supported archive extensions
+constexpr Compression  compressions[] = {
+	{".tar", nullptr},
+	{".tar.gz", "gzip"}, {".tgz", "gzip"},
+	{".tar.bz2", "bzip2"}, {".tbz2", "bzip2"}, {".tbz", "bzip2"},
+	{".tar.xz", "xz"}, {".txz", "xz"},
+	{".tar.zst", "zstd"}, {".tzst", "zstd"}
+};
+
+//! \brief Fetch compression of the archive
+//!
+//! \param name const string&  - archive name
+//! \return const Compression*  - compression or nullptr if the name is not an archive
+const Compression* compression(const string& name) noexcept
+{
+	for(const auto& cmp: compressions) {
+		const size_t  elen = strlen(cmp.ext);
+		if(name.size() > elen && !name.compare(name.size() - elen, elen, cmp.ext))
+			return &cmp;
+	}
+	return nullptr;
+}
+
+//! \brief Parse numeric field of the tar header (octal or base-256 GNU extension)
+//!
+//! \param field const char*  - the field
+//! \param size size_t  - the field size
+//! \return uint64_t  - the parsed value
+uint64_t parseNumber(const char* field, size_t size) noexcept
+{
+	uint64_t  val = 0;
+	// Base-256 encoding
+	if(static_cast<uint8_t>(field[0]) & 0x80) {
+		val = field[0] & 0x7F;
+		for(size_t i = 1; i < size; ++i)
+			val = (val << 8) | static_cast<uint8_t>(field[i]);
+		return val;
+	}
+	for(size_t i = 0; i < size && field[i]; ++i) {
+		if(field[i] == ' ')
+			continue;
+		if(field[i] < '0' || field[i] > '7')
+			break;
+		val = (val << 3) | (field[i] - '0');
+	}
+	return val;
+}
+
+//! \brief Copy the null-terminated field of the limited size
+//!
+//! \param field const char*  - the field
+//! \param size size_t  - max size of the field
+//! \return string  - resulting string
+string fieldStr(const char* field, size_t size)
+{
+	return string(field, strnlen(field, size));
+}
+
+//! \brief Parse pax extended header records ("<len> <key>=<value>\n")
+//!
+//! \param data const string&  - the extended header content
+//! \param[out] path string&  - the path attribute if specified
+//! \param[out] size uint64_t&  - the size attribute if specified
+//! \return void
+void parsePax(const string& data, string& path, uint64_t& size)
+{
+	size_t  pos = 0;
+	while(pos < data.size()) {
+		char*  end = nullptr;
+		const size_t  rlen = strtoul(data.c_str() + pos, &end, 10);
+		if(!rlen || pos + rlen > data.size() || *end != ' ')
+			break;
+		const size_t  ikey = end + 1 - data.c_str();
+		const size_t  ival = data.find('=', ikey);
+		// Note: the record is terminated with '\n'
+		if(ival != string::npos && ival < pos + rlen) {
+			const string  key = data.substr(ikey, ival - ikey);
+			const string  val = data.substr(ival + 1, pos + rlen - 1 - (ival + 1));
+			if(key == "path")
+				path = val;
+			else if(key == "size")
+				size = strtoull(val.c_str(), nullptr, 10);
+		}
+		pos += rlen;
+	}
+}
+
+}  // namespace
+
+// Archive Reading Types -------------------------------------------------------
+TarReader::TarReader(NamedFileWrapper& archive)
+: m_stream(archive), m_pipe(), m_decomp(-1), m_name(archive.name()), m_remain(0)
+, m_pos(0), m_padding(0), m_end(!archive), m_failed(!archive)
+{
+	const Compression*  cmp = compression(m_name);
+	if(m_end || !cmp || !cmp->decomp)
+		return;
+
+	// Chain the decompressor reading the archive and writing to the pipe
+#ifdef __unix__
+	// Note: the pipe is not inherited by the other concurrently spawned decompressors
+	int  pfds[2];
+	if(pipe2(pfds, O_CLOEXEC)) {
+		perror(("ERROR TarReader(), can't create a pipe for '" + m_name + "'").c_str());
+		m_end = true;
+		m_failed = true;
+		return;
+	}
+	fflush(nullptr);  // Avoid duplication of the buffered output by the child
+	m_decomp = fork();
+	if(!m_decomp) {
+		// The decompressor process
+		const int  fd = fileno(archive);
+		lseek(fd, 0, SEEK_SET);
+		if(dup2(fd, STDIN_FILENO) == -1 || dup2(pfds[1], STDOUT_FILENO) == -1)
+			_exit(127);
+		// Note: dup2() clears FD_CLOEXEC of the target descriptor unless it is
+		// the source one, the remained pipe descriptors are closed on exec
+		if(pfds[1] == STDOUT_FILENO && fcntl(STDOUT_FILENO, F_SETFD, 0) == -1)
+			_exit(127);
+		execlp(cmp->decomp, cmp->decomp, "-dc", static_cast<char*>(nullptr));
+		_exit(127);  // The decompressor is not available
+	}
+	::close(pfds[1]);
+	if(m_decomp == -1) {
+		perror(("ERROR TarReader(), can't start the decompressor for '" + m_name + "'").c_str());
+		::close(pfds[0]);
+		m_end = true;
+		m_failed = true;
+		return;
+	}
+	m_pipe.reset(fdopen(pfds[0], "r"));
+	m_stream = m_pipe;
+	if(!m_stream) {
+		perror("ERROR TarReader(), can't read the decompressed archive");
+		m_end = true;
+		m_failed = true;
+	}
+#else
+	fprintf(stderr, "ERROR TarReader(), compressed archives are not supported on this"
+		" platform: %s\n", m_name.c_str());
+	m_end = true;
+	m_failed = true;
+#endif // __unix__
+}
+
+TarReader::~TarReader()
+{
+#ifdef __unix__
+	if(m_decomp == -1)
+		return;
+	m_pipe.reset();  // Note: the decompressor is terminated by SIGPIPE if still writing
+	waitpid(m_decomp, nullptr, 0);
+#endif // __unix__
+}
+
+bool TarReader::close()
+{
+	m_end = true;
+#ifdef __unix__
+	if(m_decomp == -1)
+		return !m_failed;
+	// Drain the remained output (the trailing padding of the archive) to not
+	// terminate the decompressor by SIGPIPE
+	if(!m_failed) {
+		char  buf[16 * blocksize];
+		while(fread(buf, 1, sizeof buf, m_pipe) == sizeof buf);
+	}
+	m_pipe.reset();
+	m_stream = nullptr;
+	int  status = 0;
+	const bool  reaped = waitpid(m_decomp, &status, 0) == m_decomp;
+	m_decomp = -1;
+	// Note: the decompressor of the failed archive might be terminated by SIGPIPE
+	if(!reaped || (WIFEXITED(status) ? WEXITSTATUS(status) : WTERMSIG(status) != SIGPIPE)) {
+		if(reaped && WIFEXITED(status))
+			fprintf(stderr, "ERROR TarReader::close(), the decompression of '%s' failed with the"
+				" code %d\n", m_name.c_str(), WEXITSTATUS(status));
+		else fprintf(stderr, "ERROR TarReader::close(), the decompression of '%s' failed\n"
+				, m_name.c_str());
+		m_failed = true;
+	}
+#endif // __unix__
+	return !m_failed;
+}
+
+size_t TarReader::archiveExt(const string& name) noexcept
+{
+	const Compression*  cmp = compression(name);
+	return cmp ? strlen(cmp->ext) : 0;
+}
+
+bool TarReader::next(NamedFileWrapper& entry)
+{
+	entry.reset(nullptr, nullptr);  // Release the previous entry
+	if(m_end || !skip())
+		return false;
+
+	string  path;  // Entry path from the extended header
+	uint64_t  xsize = -1;  // Entry size from the extended header
+	char  hdr[blocksize];
+	while(fread(hdr, 1, blocksize, m_stream) == blocksize) {
+		// The end of archive is marked with the zero blocks
+		if(!hdr[0] && !memcmp(hdr, hdr + 1, blocksize - 1))
+			break;
+		// Validate the header checksum, where the checksum field itself is
+		// considered as spaces
+		constexpr size_t  ichks = 148;  // Checksum offset
+		constexpr size_t  chksize = 8;  // Checksum field size
+		uint64_t  chks = ' ' * chksize;
+		for(size_t i = 0; i < blocksize; ++i)
+			if(i < ichks || i >= ichks + chksize)
+				chks += static_cast<uint8_t>(hdr[i]);
+		if(chks != parseNumber(hdr + ichks, chksize)) {
+			fprintf(stderr, "ERROR TarReader::next(), corrupted header in '%s'\n", m_name.c_str());
+			m_end = true;
+			m_failed = true;
+			return false;
+		}
+
+		m_pos = 0;
+		m_remain = parseNumber(hdr + 124, 12);
+		m_padding = (blocksize - m_remain % blocksize) % blocksize;
+		const char  type = hdr[156];
+		switch(type) {
+		case 'x':  // Pax extended header of the following entry
+		case 'L': {  // GNU long name of the following entry
+			string  data;
+			if(!readAll(data))
+				return false;
+			if(type == 'x')
+				parsePax(data, path, xsize);
+			else path = data.c_str();  // Note: the name is null-terminated
+			continue;
+		}
+		case '0':  // Regular file
+		case '\0':  // Regular file (pre-POSIX)
+		case '7':  // Contiguous file
+			break;
+		default:  // Directories, links, devices and global extended headers are omitted
+			path.clear();
+			xsize = -1;
+			if(!skip())
+				return false;
+			continue;
+		}
+
+		if(xsize != uint64_t(-1)) {
+			m_remain = xsize;
+			m_padding = (blocksize - m_remain % blocksize) % blocksize;
+		}
+		if(path.empty()) {
+			// ustar prefix is applied only if the magic is valid
+			const string  prefix = !memcmp(hdr + 257, "ustar", 5) ? fieldStr(hdr + 345, 155) : string();
+			path = fieldStr(hdr, 100);
+			if(!prefix.empty())
+				path.insert(0, prefix + '/');
+		}
+
+#ifdef __GLIBC__
+		constexpr cookie_io_functions_t  iofuncs = {cookieRead, nullptr, cookieSeek, cookieClose};
+		FILE*  fentry = fopencookie(this, "r", iofuncs);
+		if(!fentry) {
+			perror(("ERROR TarReader::next(), can't open entry '" + path + "'").c_str());
+			m_end = true;
+			m_failed = true;
+			return false;
+		}
+		entry = NamedFileWrapper(fentry, (m_name + '/' + path).c_str(), m_remain);
+		return true;
+#else
+		fputs("ERROR TarReader::next(), the archive entries streaming is not supported"
+			" on this platform\n", stderr);
+		m_end = true;
+		m_failed = true;
+		return false;
+#endif // __GLIBC__
+	}
+	m_end = true;
+	// Note: the archive is terminated with the zero blocks, so their absence
+	// indicates the truncation
+	if(ferror(m_stream)) {
+		perror(("ERROR TarReader::next(), reading of '" + m_name + "' failed").c_str());
+		m_failed = true;
+	} else if(feof(m_stream)) {
+		fprintf(stderr, "ERROR TarReader::next(), unexpected end of the archive '%s'\n"
+			, m_name.c_str());
+		m_failed = true;
+	}
+	return false;
+}
+
+ssize_t TarReader::read(char* buf, size_t size)
+{
+	if(!m_remain)
+		return 0;
+	size = fread(buf, 1, min<uint64_t>(size, m_remain), m_stream);
+	if(!size) {
+		const bool  eof = !ferror(m_stream);  // Unexpected end of the archive
+		if(!m_failed)
+			fprintf(stderr, "ERROR TarReader::read(), %s of the archive '%s'\n"
+				, eof ? "unexpected end" : "reading failed", m_name.c_str());
+		m_end = true;
+		m_failed = true;
+		if(eof)
+			errno = EIO;
+		return -1;
+	}
+	m_remain -= size;
+	m_pos += size;
+	return size;
+}
+
+bool TarReader::skip()
+{
+	uint64_t  rem = m_remain + m_padding;
+	m_remain = 0;
+	m_padding = 0;
+	// Note: the seeking is not applicable for the decompressor output
+	if(rem && m_decomp == -1 && !fseek(m_stream, rem, SEEK_CUR))
+		return true;
+	char  buf[16 * blocksize];
+	while(rem) {
+		const size_t  rsize = fread(buf, 1, min<uint64_t>(sizeof buf, rem), m_stream);
+		if(!rsize) {
+			fprintf(stderr, "ERROR TarReader::skip(), unexpected end of the archive '%s'\n"
+				, m_name.c_str());
+			m_end = true;
+			m_failed = true;
+			return false;
+		}
+		rem -= rsize;
+	}
+	return true;
+}
+
+bool TarReader::readAll(string& data)
+{
+	data.resize(m_remain);
+	if(m_remain && fread(&data[0], 1, m_remain, m_stream) != m_remain) {
+		fprintf(stderr, "ERROR TarReader::readAll(), unexpected end of the archive '%s'\n"
+			, m_name.c_str());
+		m_end = true;
+		m_failed = true;
+		return false;
+	}
+	m_remain = 0;
+	return skip();  // Skip the padding
+}
+
+ssize_t TarReader::cookieRead(void* cookie, char* buf, size_t size)
+{
+	return static_cast<TarReader*>(cookie)->read(buf, size);
+}
+
+int TarReader::cookieSeek(void* cookie, int64_t* offset, int whence)
+{
+	// Only the position fetching (ftell) is supported
+	const auto  pos = static_cast<TarReader*>(cookie)->m_pos;
+	if((whence == SEEK_CUR && !*offset) || (whence == SEEK_SET && uint64_t(*offset) == pos)) {
+		*offset = pos;
+		return 0;
+	}
+	errno = ESPIPE;
+	return -1;
+}
+
+int TarReader::cookieClose(void*)
+{
+	return 0;  // The archive stream is owned by the reader
+}
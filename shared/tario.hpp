@@ -0,0 +1,123 @@
+//! \brief Streaming reader of the tar archives (optionally compressed)
+//!
+//! \license Apache License, Version 2.0: http://www.apache.org/licenses/LICENSE-2.0.html
+//! > 	Simple explanation: https://tldrlegal.com/license/apache-license-2.0-(apache-2.0)
+//!
+//! Copyright (c)
+//! \authr Artem Lutov
+//! \email luart@ya.ru
+//! \date 2026-10-18
+
+#ifndef TARIO_H
+#define TARIO_H
+
+#include <cstdint>  // uintX_t
+#include <cstdio>  // FILE
+#include <string>
+#include <sys/types.h>  // ssize_t
+
+#include "fileio.hpp"
+
+
+namespace daoc {
+
+using std::string;
+
+// Archive Reading Types -------------------------------------------------------
+//! \brief Sequential reader of the ustar/pax/GNU tar archives, which presents
+//! 	each regular entry as a file without the extraction to the disk
+//! \note Compressed archives are decompressed on the fly by the external
+//! 	decompressor (gzip, bzip2, xz or zstd), which is chained via the pipe
+//! \attention Entries are read strictly sequentially, an entry becomes invalid
+//! 	when the next one is fetched or the reader is destructed
+class TarReader {
+	FILE*  m_stream;  //!< Archive stream (either the archive file or the decompressor output)
+	FileWrapper  m_pipe;  //!< Decompressor output if any
+	int  m_decomp;  //!< Process id of the decompressor, -1 if not used
+	string  m_name;  //!< Archive name
+	uint64_t  m_remain;  //!< Remained number of bytes in the current entry
+	uint64_t  m_pos;  //!< Position in the current entry
+	uint16_t  m_padding;  //!< Padding of the current entry to the block size
+	bool  m_end;  //!< Whether the end of the archive is reached
+	bool  m_failed;  //!< Whether the archive is corrupted, truncated or can't be read
+public:
+	constexpr static size_t  blocksize = 512;  //!< Size of the tar block
+
+    //! \brief Constructor
+    //! \pre The archive is positioned to the beginning
+    //!
+    //! \param archive NamedFileWrapper&  - the archive opened for reading
+	TarReader(NamedFileWrapper& archive);
+
+    //! \brief Copy constructor
+	TarReader(const TarReader&)=delete;
+
+    //! \brief Copy assignment
+	TarReader& operator= (const TarReader&)=delete;
+
+    //! \brief Destructor, terminates the decompressor if any
+    //! \note The decompressor of the reader not closed explicitly (i.e. on the
+    //! 	interruption of the processing) is terminated without the validation
+	~TarReader();
+
+    //! \brief The length of the tar archive extension of the file name
+    //!
+    //! \param name const string&  - file name
+    //! \return size_t  - the length of the archive extension (e.g. 7 for ".tar.gz")
+    //! 	or 0 if the file is not a tar archive
+	static size_t archiveExt(const string& name) noexcept;
+
+    //! \brief Whether the file name corresponds to a tar archive (optionally compressed)
+    //!
+    //! \param name const string&  - file name
+    //! \return bool  - the file is a tar archive
+	static bool isArchive(const string& name) noexcept  { return archiveExt(name); }
+
+    //! \brief Fetch the next regular entry of the archive skipping the
+    //! 	remained content of the previous entry
+    //!
+    //! \param[out] entry NamedFileWrapper&  - the entry opened for reading named
+    //! 	as <archive>/<entry_path>
+    //! \return bool  - whether the entry is fetched, false on the end of archive or an error
+	bool next(NamedFileWrapper& entry);
+
+    //! \brief Whether the archive is failed (corrupted, truncated or can't be read),
+    //! 	so the fetched entries might be incomplete
+    //!
+    //! \return bool  - the archive is failed
+	bool failed() const noexcept  { return m_failed; }
+
+    //! \brief Close the archive validating the exit status of the decompressor if any
+    //! \pre The fetched entry is released
+    //!
+    //! \return bool  - the archive is read completely without the errors
+	bool close();
+protected:
+    //! \brief Read the entry content
+    //!
+    //! \param buf char*  - output buffer
+    //! \param size size_t  - the buffer size
+    //! \return ssize_t  - the number of read bytes, 0 on the end of the entry, -1 on error
+	ssize_t read(char* buf, size_t size);
+
+    //! \brief Skip the remained content of the current entry including the padding
+    //!
+    //! \return bool  - the skipping is successful
+	bool skip();
+
+    //! \brief Read the whole (small) content of the current entry,
+    //! 	which is used for the extended headers
+    //!
+    //! \param[out] data string&  - the read content
+    //! \return bool  - the reading is successful
+	bool readAll(string& data);
+
+	// Stream functions of the entry view
+	static ssize_t cookieRead(void* cookie, char* buf, size_t size);
+	static int cookieSeek(void* cookie, int64_t* offset, int whence);
+	static int cookieClose(void* cookie);
+};
+
+}  // daoc
+
+#endif // TARIO_H
@@ -0,0 +1,176 @@
+//! \brief Timeline tracing of the processing stages exported in the Chrome
+//! 	trace-event format (viewable in Perfetto and chrome://tracing)
+//!
+//! \license Apache License, Version 2.0: http://www.apache.org/licenses/LICENSE-2.0.html
+//! > 	Simple explanation: https://tldrlegal.com/license/apache-license-2.0-(apache-2.0)
+//!
+//! Copyright (c)
+//! \authr Artem Lutov
+//! \email luart@ya.ru
+//! \date 2026-10-18
+
+#include <cstdio>
+#include <cstring>  // strlen, memcpy
+#include <chrono>
+#include <exception>
+#include <algorithm>  // min, max
+
+#ifdef __unix__
+#include <unistd.h>  // getpid
+#endif // __unix__
+
+#include "tracing.hpp"
+
+
+namespace daoc {
+
+using std::lock_guard;
+using Clock = std::chrono::steady_clock;
+
+//! Start time of the tracer
+static Clock::time_point  traceStart = Clock::now();
+
+//! Ring buffer of the events of the current thread
+static thread_local Tracer::Ring*  threadRing = nullptr;
+
+//! \brief Output the JSON string escaping the special chars
+//!
+//! \param fout FILE*  - output stream
+//! \param str const char*  - the string to be output
+//! \return void
+static void putJsonString(FILE* fout, const char* str)
+{
+	fputc('"', fout);
+	for(; *str; ++str) {
+		const unsigned char  c = *str;
+		if(c == '"' || c == '\\')
+			fprintf(fout, "\\%c", c);
+		else if(c < ' ')
+			fprintf(fout, "\\u%04x", c);
+		else fputc(c, fout);
+	}
+	fputc('"', fout);
+}
+
+// Tracer Types definitions ----------------------------------------------------
+bool Tracer::s_enabled = false;
+
+Tracer& Tracer::global() noexcept
+{
+	static Tracer  tracer;
+	return tracer;
+}
+
+uint64_t Tracer::now() noexcept
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - traceStart).count();
+}
+
+void Tracer::start(const string& name, size_t capacity)
+{
+	m_name = name;
+	m_capacity = std::max<size_t>(capacity, 1);
+	m_main = std::this_thread::get_id();
+	traceStart = Clock::now();
+	s_enabled = true;
+}
+
+Tracer::Ring& Tracer::ring()
+{
+	if(!threadRing) {
+		lock_guard<mutex>  lock(m_mutex);
+		m_rings.emplace_back(new Ring(m_capacity, m_rings.size()
+			, std::this_thread::get_id() == m_main));
+		threadRing = m_rings.back().get();
+	}
+	return *threadRing;
+}
+
+void Tracer::record(const char* cat, const char* name, uint64_t begin, uint64_t end
+	, const char* detail) noexcept
+{
+	Ring*  rng;
+	try {
+		rng = &ring();
+	} catch(std::exception&) {
+		// The event is omitted if the ring can't be allocated
+		return;
+	}
+	Event&  ev = rng->events[rng->count++ % rng->events.size()];
+	ev.cat = cat;
+	ev.name = name;
+	ev.begin = begin;
+	ev.end = end;
+	// Retain the tail of the long detail (e.g. the file name rather than its
+	// path) skipping the partial UTF-8 char
+	size_t  len = detail ? strlen(detail) : 0;
+	if(len >= sizeof ev.detail) {
+		detail += len - (sizeof ev.detail - 1);
+		while((*detail & 0xC0) == 0x80)
+			++detail;
+		len = strlen(detail);
+	}
+	memcpy(ev.detail, detail, len);
+	ev.detail[len] = 0;
+}
+
+bool Tracer::save()
+{
+	if(!s_enabled)
+		return false;
+	s_enabled = false;
+	FILE*  fout = fopen(m_name.c_str(), "w");
+	if(!fout) {
+		perror(("ERROR Tracer::save(), the trace can't be created: " + m_name).c_str());
+		return false;
+	}
+#ifdef __unix__
+	const int  pid = getpid();
+#else
+	const int  pid = 1;
+#endif // __unix__
+	size_t  evsnum = 0;  // The number of saved events
+	size_t  dropped = 0;  // The number of overwritten events
+	fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", fout);
+	bool  first = true;  // The first event is output
+	lock_guard<mutex>  lock(m_mutex);
+	for(const auto& rng: m_rings) {
+		// Name the thread
+		fprintf(fout, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%u"
+			",\"args\":{\"name\":", first ? "" : ",", pid, rng->tid);
+		if(rng->main)
+			fputs("\"main\"}}", fout);
+		else fprintf(fout, "\"worker %u\"}}", rng->tid);
+		first = false;
+		// Output the retained events from the oldest one
+		const size_t  capacity = rng->events.size();
+		const size_t  num = std::min(rng->count, capacity);
+		dropped += rng->count - num;
+		for(size_t i = rng->count - num; i < rng->count; ++i) {
+			const Event&  ev = rng->events[i % capacity];
+			fprintf(fout, ",\n{\"cat\":\"%s\",\"name\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f"
+				",\"pid\":%d,\"tid\":%u", ev.cat, ev.name, ev.begin / 1000., (ev.end - ev.begin) / 1000.
+				, pid, rng->tid);
+			if(ev.detail[0]) {
+				fputs(",\"args\":{\"detail\":", fout);
+				putJsonString(fout, ev.detail);
+				fputc('}', fout);
+			}
+			fputc('}', fout);
+		}
+		evsnum += num;
+	}
+	fputs("\n]}\n", fout);
+	const bool  success = !ferror(fout);
+	if(fclose(fout) || !success) {
+		perror(("ERROR Tracer::save(), the trace can't be saved to " + m_name).c_str());
+		return false;
+	}
+	printf("%lu trace events of %lu threads are saved to %s", evsnum, m_rings.size(), m_name.c_str());
+	if(dropped)
+		printf(", %lu earliest events are overwritten", dropped);
+	puts("");
+	return true;
+}
+
+}  // daoc
@@ -0,0 +1,155 @@
+//! \brief Timeline tracing of the processing stages exported in the Chrome
+//! 	trace-event format (viewable in Perfetto and chrome://tracing)
+//!
+//! \license Apache License, Version 2.0: http://www.apache.org/licenses/LICENSE-2.0.html
+//! > 	Simple explanation: https://tldrlegal.com/license/apache-license-2.0-(apache-2.0)
+//!
+//! Copyright (c)
+//! \authr Artem Lutov
+//! \email luart@ya.ru
+//! \date 2026-10-18
+
+#ifndef TRACING_HPP
+#define TRACING_HPP
+
+#include <cstdint>  // uintX_t
+#include <string>
+#include <vector>
+#include <memory>  // unique_ptr
+#include <mutex>
+#include <thread>  // thread::id
+
+
+namespace daoc {
+
+using std::string;
+using std::vector;
+using std::unique_ptr;
+using std::mutex;
+
+// Tracing Types ---------------------------------------------------------------
+//! \brief Tracer of the timeline events, which are recorded into the thread-local
+//! 	ring buffers and saved in the Chrome trace-event format
+//! \note The events are recorded only when the tracer is started, otherwise the
+//! 	recording is a single check of the flag. The ring buffers retain the latest
+//! 	events on overflow.
+class Tracer {
+public:
+	//! \brief Timeline event (span)
+	struct Event {
+		const char*  cat;  //!< Category (static string)
+		const char*  name;  //!< Name (static string)
+		uint64_t  begin;  //!< Begin time in ns since the start of the tracer
+		uint64_t  end;  //!< End time in ns since the start of the tracer
+		char  detail[56];  //!< Detail of the event (e.g. the file name), null-terminated
+	};
+
+	//! \brief Ring buffer of the events of a thread
+	struct Ring {
+		vector<Event>  events;  //!< Recorded events
+		size_t  count;  //!< The number of the recorded events including the overwritten ones
+		unsigned  tid;  //!< Index of the thread in the trace
+		bool  main;  //!< The ring belongs to the main (starting) thread
+
+		Ring(size_t capacity, unsigned tid, bool main)
+		: events(capacity), count(0), tid(tid), main(main)  {}
+	};
+private:
+	static bool  s_enabled;  //!< The tracing is started
+	string  m_name;  //!< Output file name
+	size_t  m_capacity;  //!< Capacity of the ring buffers
+	std::thread::id  m_main;  //!< Id of the main (starting) thread
+	vector<unique_ptr<Ring>>  m_rings;  //!< Ring buffers of all threads, including the finished ones
+	mutex  m_mutex;  //!< Synchronization of the rings registration
+public:
+    //! \brief Default constructor
+	Tracer(): m_name(), m_capacity(0), m_main(), m_rings(), m_mutex()  {}
+
+    //! \brief Copy constructor
+	Tracer(const Tracer&)=delete;
+
+    //! \brief Copy assignment
+	Tracer& operator= (const Tracer&)=delete;
+
+    //! \brief Global tracer of the application
+	static Tracer& global() noexcept;
+
+    //! \brief Whether the tracing is started
+	static bool enabled() noexcept  { return s_enabled; }
+
+    //! \brief Current time in ns since the start of the tracer
+	static uint64_t now() noexcept;
+
+    //! \brief Start the tracing
+    //! \pre Called by the main thread before the workers are spawned
+    //!
+    //! \param name const string&  - output file of the trace
+    //! \param capacity=1<<16 size_t  - capacity of the ring buffer of each thread
+    //! \return void
+	void start(const string& name, size_t capacity=1<<16);
+
+    //! \brief Record the event
+    //!
+    //! \param cat const char*  - category of the event (static string)
+    //! \param name const char*  - name of the event (static string)
+    //! \param begin uint64_t  - begin time, see now()
+    //! \param end uint64_t  - end time, see now()
+    //! \param detail const char*  - detail of the event, which is copied, might be nullptr
+    //! \return void
+	void record(const char* cat, const char* name, uint64_t begin, uint64_t end
+		, const char* detail) noexcept;
+
+    //! \brief Save the recorded events to the output file stopping the tracing
+    //! \pre The workers are finished
+    //!
+    //! \return bool  - the events are saved successfully
+	bool save();
+protected:
+    //! \brief Ring buffer of the calling thread, which is registered on demand
+    //!
+    //! \return Ring&  - the ring buffer
+	Ring& ring();
+};
+
+//! \brief Span of the traced stage, which is recorded on the destruction
+class TraceSpan {
+	const char*  m_cat;  //!< Category of the event
+	const char*  m_name;  //!< Name of the event
+	const char*  m_detail;  //!< Detail of the event
+	uint64_t  m_begin;  //!< Begin time of the span
+public:
+    //! \brief Constructor
+    //!
+    //! \param cat const char*  - category of the event (static string)
+    //! \param name const char*  - name of the event (static string)
+    //! \param detail=nullptr const char*  - detail of the event, which should be
+    //! 	valid until the span is destructed
+	TraceSpan(const char* cat, const char* name, const char* detail=nullptr) noexcept
+	: m_cat(cat), m_name(name), m_detail(detail)
+	, m_begin(Tracer::enabled() ? Tracer::now() : 0)  {}
+
+    //! \brief Constructor
+    //!
+    //! \param cat const char*  - category of the event (static string)
+    //! \param name const char*  - name of the event (static string)
+    //! \param detail const string&  - detail of the event, which should be valid
+    //! 	until the span is destructed
+	TraceSpan(const char* cat, const char* name, const string& detail) noexcept
+	: TraceSpan(cat, name, detail.c_str())  {}
+
+    //! \brief Copy constructor
+	TraceSpan(const TraceSpan&)=delete;
+
+    //! \brief Copy assignment
+	TraceSpan& operator= (const TraceSpan&)=delete;
+
+	~TraceSpan()
+	{
+		if(Tracer::enabled())
+			Tracer::global().record(m_cat, m_name, m_begin, Tracer::now(), m_detail);
+	}
+};
+
+}  // daoc
+
+#endif // TRACING_HPP
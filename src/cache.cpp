@@ -0,0 +1,355 @@
+//! \brief Memoization of the processing results
+//!
+//! \license Apache License, Version 2.0: http://www.apache.org/licenses/LICENSE-2.0.html
+//! > 	Simple explanation: https://tldrlegal.com/license/apache-license-2.0-(apache-2.0)
+//!
+//! Copyright (c)
+//! \authr Artem Lutov
+//! \email luart@ya.ru
+//! \date 2026-10-18
+
+#include <cstring>  // strerror
+#include <cassert>
+#include <algorithm>  // sort
+#include <system_error>  // error_code
+
+#ifdef __unix__
+#include <unistd.h>  // link, getpid
+#include <fcntl.h>  // open
+#include <sys/stat.h>  // stat
+#include <sys/ioctl.h>  // ioctl
+#include <utime.h>  // utime
+#endif // __unix__
+#ifdef __linux__
+#include <linux/fs.h>  // FICLONE
+#endif // __linux__
+#if defined(__x86_64__) || defined(__i386__)
+#include <nmmintrin.h>  // SSE 4.2 crc32
+#endif // x86
+
+#include "cache.h"
+
+
+using std::error_code;
+using std::to_string;
+using std::sort;
+using fs::path;
+using fs::directory_iterator;
+
+// Internal functions ----------------------------------------------------------
+//! \brief Software CRC32C
+//!
+//! \param data const uint8_t*  - the data to be hashed
+//! \param size size_t  - the number of bytes in the data
+//! \param crc uint32_t  - inverted initial value
+//! \return uint32_t  - inverted resulting checksum
+static uint32_t crc32cSoft(const uint8_t* data, size_t size, uint32_t crc) noexcept
+{
+	// Lookup table of the reflected Castagnoli polynomial
+	static const auto  table = [] {
+		constexpr uint32_t  poly = 0x82F63B78;
+		vector<uint32_t>  tbl(256);
+		for(uint32_t i = 0; i < tbl.size(); ++i) {
+			uint32_t  val = i;
+			for(uint8_t j = 0; j < 8; ++j)
+				val = val & 1 ? (val >> 1) ^ poly : val >> 1;
+			tbl[i] = val;
+		}
+		return tbl;
+	}();
+
+	while(size--)
+		crc = table[(crc ^ *data++) & 0xFF] ^ (crc >> 8);
+	return crc;
+}
+
+#if defined(__x86_64__)
+//! \brief Hardware CRC32C
+//!
+//! \param data const uint8_t*  - the data to be hashed
+//! \param size size_t  - the number of bytes in the data
+//! \param crc uint32_t  - inverted initial value
+//! \return uint32_t  - inverted resulting checksum
+__attribute__((target("sse4.2")))
+static uint32_t crc32cHard(const uint8_t* data, size_t size, uint32_t crc) noexcept
+{
+	uint64_t  crcw = crc;
+	for(; size >= sizeof(uint64_t); size -= sizeof(uint64_t), data += sizeof(uint64_t)) {
+		uint64_t  word;
+		memcpy(&word, data, sizeof word);  // Note: unaligned access is handled by the compiler
+		crcw = _mm_crc32_u64(crcw, word);
+	}
+	crc = crcw;
+	while(size--)
+		crc = _mm_crc32_u8(crc, *data++);
+	return crc;
+}
+#endif // __x86_64__
+
+//! \brief 64-bit FNV-1a hash of the string
+//!
+//! \param str const string&  - the string to be hashed
+//! \return uint64_t  - resulting hash
+static uint64_t fnv1a(const string& str) noexcept
+{
+	uint64_t  hash = 0xCBF29CE484222325;
+	for(auto c: str)
+		hash = (hash ^ static_cast<uint8_t>(c)) * 0x100000001B3;
+	return hash;
+}
+
+//! \brief Key of the file considering its canonical path, size, modification
+//! 	time and optionally the content checksum
+//!
+//! \param name const string&  - file name
+//! \param content bool  - include the content checksum
+//! \return string  - resulting key
+static string fileKey(const string& name, bool content)
+{
+	error_code  err;
+	string  key = fs::canonical(name, err).string();
+	if(err)
+		key = fs::absolute(name).string();
+#ifdef __unix__
+	struct stat  fst;
+	if(!stat(name.c_str(), &fst))
+		key.append("\t").append(to_string(fst.st_size)).append("\t")
+			.append(to_string(fst.st_mtim.tv_sec)).append(".")
+			.append(to_string(fst.st_mtim.tv_nsec));
+#else
+	key.append("\t").append(to_string(fs::file_size(name, err))).append("\t")
+		.append(to_string(fs::last_write_time(name, err).time_since_epoch().count()));
+#endif // __unix__
+	if(content) {
+		uint32_t  crc = 0;
+		FileWrapper  finp(fopen(name.c_str(), "rb"));
+		if(finp) {
+			vector<char>  buf(1 << 20);
+			size_t  rsize;
+			while((rsize = fread(buf.data(), 1, buf.size(), finp)))
+				crc = crc32c(buf.data(), rsize, crc);
+		}
+		key.append("\t").append(to_string(crc));
+	}
+	return key;
+}
+
+//! \brief Clone the file by the reflinking, hardlinking or copying
+//! \pre The destination file does not exist
+//!
+//! \param src const string&  - source file name
+//! \param dst const string&  - destination file name
+//! \return bool  - the cloning is successful
+static bool cloneFile(const string& src, const string& dst)
+{
+#ifdef __unix__
+#ifdef FICLONE
+	// Copy-on-write clone sharing the data blocks
+	const int  fsrc = open(src.c_str(), O_RDONLY);
+	if(fsrc != -1) {
+		const int  fdst = open(dst.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+		bool  cloned = fdst != -1 && !ioctl(fdst, FICLONE, fsrc);
+		if(fdst != -1)
+			close(fdst);
+		close(fsrc);
+		if(cloned)
+			return true;
+		remove(dst.c_str());
+	}
+#endif // FICLONE
+	if(!link(src.c_str(), dst.c_str()))
+		return true;
+#endif // __unix__
+	error_code  err;
+	if(fs::copy_file(src, dst, err))
+		return true;
+	fprintf(stderr, "WARNING cloneFile(), '%s' can't be cloned to '%s': %s\n"
+		, src.c_str(), dst.c_str(), err.message().c_str());
+	return false;
+}
+
+//! \brief Update the modification time of the file to the current time
+//!
+//! \param name const string&  - file name
+//! \return void
+static void touch(const string& name)
+{
+#ifdef __unix__
+	utime(name.c_str(), nullptr);
+#else
+	error_code  err;
+	fs::last_write_time(name, fs::file_time_type::clock::now(), err);
+#endif // __unix__
+}
+
+// Cache Types definitions -----------------------------------------------------
+ResultCache::ResultCache(const char* dir, size_t limit, bool content)
+: m_dir(dir ? dir : ""), m_limit(limit), m_content(content), m_key(), m_id()
+{
+	if(m_dir.empty())
+		return;
+	while(m_dir.size() > 1 && m_dir.back() == PATHSEP)
+		m_dir.pop_back();
+	try {
+		ensureDir(m_dir);
+	} catch(std::exception& err) {
+		fprintf(stderr, "WARNING ResultCache(), the caching is disabled: %s\n", err.what());
+		m_dir.clear();
+	}
+}
+
+void ResultCache::bind(const string& options, const NamedFileWrappers& files
+, const NamedFileWrapper& fbase)
+{
+	if(m_dir.empty())
+		return;
+	m_key = options;
+	if(fbase)
+		m_key.append("base: ").append(fileKey(fbase.name(), m_content)) += '\n';
+	for(const auto& file: files)
+		m_key.append("input: ").append(fileKey(file.name(), m_content)) += '\n';
+
+	char  id[2 * sizeof(uint64_t) + 1];
+	snprintf(id, sizeof id, "%016lx", static_cast<unsigned long>(fnv1a(m_key)));
+	m_id = id;
+#if TRACE >= 2
+	fprintf(stderr, "ResultCache::bind(), id: %s, key:\n%s", id, m_key.c_str());
+#endif // TRACE
+}
+
+bool ResultCache::fetch(NamedFileWrapper& fout)
+{
+	if(m_dir.empty() || m_id.empty() || !fout)
+		return false;
+
+	// Validate the stored key to avoid collisions of the ids
+	const string  entry = m_dir + PATHSEP + m_id;
+	{
+		FileWrapper  fkey(fopen((entry + ".key").c_str(), "rb"));
+		if(!fkey)
+			return false;
+		string  key(m_key.size() + 1, 0);
+		if(fread(&key[0], 1, key.size(), fkey) != m_key.size() || key.compare(0, m_key.size(), m_key))
+			return false;
+	}
+	if(!fs::exists(entry + ".cnl"))
+		return false;
+
+	const string  outname = fout.name();
+	fout.reset(nullptr, nullptr);  // Close the empty output
+	remove(outname.c_str());
+	if(!cloneFile(entry + ".cnl", outname)) {
+		fout.reset(outname.c_str(), "w");  // Restore the empty output
+		return false;
+	}
+	touch(entry + ".key");
+	return true;
+}
+
+bool ResultCache::store(NamedFileWrapper& fout)
+{
+	if(m_dir.empty() || m_id.empty() || !fout)
+		return false;
+	if(fflush(fout)) {
+		perror("WARNING ResultCache::store(), the output can't be flushed");
+		return false;
+	}
+
+	const string  entry = m_dir + PATHSEP + m_id;
+#ifdef __unix__
+	const string  tmpsuf = ".tmp" + to_string(getpid());
+#else
+	const string  tmpsuf = ".tmp";
+#endif // __unix__
+	// Note: the results are stored to the temporary file and then renamed
+	// to not expose partially formed results for the concurrent processes
+	if(!cloneFile(fout.name(), entry + tmpsuf))
+		return false;
+	bool  stored = false;
+	{
+		FileWrapper  fkey(fopen((entry + ".key" + tmpsuf).c_str(), "wb"));
+		stored = fkey && fwrite(m_key.data(), 1, m_key.size(), fkey) == m_key.size();
+	}
+	stored = stored && !rename((entry + tmpsuf).c_str(), (entry + ".cnl").c_str())
+		&& !rename((entry + ".key" + tmpsuf).c_str(), (entry + ".key").c_str());
+	if(!stored) {
+		perror(("WARNING ResultCache::store(), the results can't be stored to " + entry).c_str());
+		remove((entry + tmpsuf).c_str());
+		remove((entry + ".key" + tmpsuf).c_str());
+		return false;
+	}
+	evict();
+	return true;
+}
+
+void ResultCache::evict()
+{
+	if(!m_limit)
+		return;
+
+	//! Cached results
+	struct Entry {
+		string  name;  //!< Path without the extension
+		fs::file_time_type  atime;  //!< Access time
+		size_t  size;  //!< The number of occupied bytes
+	};
+	vector<Entry>  entries;
+	size_t  total = 0;  // Total size of the cache
+	error_code  err;
+	for(const auto& detry: directory_iterator(m_dir, err)) {
+		const path&  pkey = detry.path();
+		if(pkey.extension() != ".key")
+			continue;
+		path  pres = pkey;
+		pres.replace_extension(".cnl");
+		const auto  keysize = fs::file_size(pkey, err);
+		if(err)
+			continue;  // Note: the key might be evicted concurrently
+		const auto  ressize = fs::file_size(pres, err);
+		if(err) {
+			// Remove the orphaned key, which results are missed
+			remove(pkey.c_str());
+			continue;
+		}
+		const auto  atime = fs::last_write_time(pkey, err);
+		if(err)
+			continue;
+		const size_t  size = keysize + ressize;
+		total += size;
+		if(pkey.stem() == m_id)
+			continue;  // Note: the current results are not evicted
+		entries.push_back({(pkey.parent_path() / pkey.stem()).string(), atime, size});
+	}
+	if(total <= m_limit)
+		return;
+
+	sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) noexcept {
+		return a.atime < b.atime;
+	});
+	size_t  evicted = 0;  // The number of evicted results
+	for(const auto& etr: entries) {
+		// Note: the key is removed first to never have unverifiable results
+		if(remove((etr.name + ".key").c_str()))
+			continue;
+		remove((etr.name + ".cnl").c_str());
+		total -= etr.size;
+		++evicted;
+		if(total <= m_limit)
+			break;
+	}
+#if TRACE >= 1
+	printf("ResultCache::evict(), %lu results evicted, the cache size: %lu bytes\n"
+		, evicted, total);
+#endif // TRACE
+}
+
+// Cache functions definitions -------------------------------------------------
+uint32_t crc32c(const void* data, size_t size, uint32_t crc) noexcept
+{
+#if defined(__x86_64__)
+	static const bool  hwcrc = __builtin_cpu_supports("sse4.2");
+	if(hwcrc)
+		return ~crc32cHard(static_cast<const uint8_t*>(data), size, ~crc);
+#endif // __x86_64__
+	return ~crc32cSoft(static_cast<const uint8_t*>(data), size, ~crc);
+}
@@ -0,0 +1,630 @@
+//! \brief Validation (linting), annotation and inspection of the CNL files
+//!
+//! \license Apache License, Version 2.0: http://www.apache.org/licenses/LICENSE-2.0.html
+//! > 	Simple explanation: https://tldrlegal.com/license/apache-license-2.0-(apache-2.0)
+//!
+//! Copyright (c)
+//! \authr Artem Lutov
+//! \email luart@ya.ru
+//! \date 2026-10-18
+
+#include <cstring>  // memchr, strncasecmp
+#include <algorithm>  // min, max
+#include <limits>
+#include <utility>  // pair
+#include <memory>  // unique_ptr
+
+#ifdef __SSE2__
+#include <emmintrin.h>  // SSE2 intrinsics
+#endif // __SSE2__
+
+#ifdef __unix__
+#include <unistd.h>  // getpid
+#include <sys/stat.h>  // fstat, fchmod
+#endif // __unix__
+
+#include "checker.h"
+#include "parallel.hpp"
+
+
+using std::numeric_limits;
+using std::to_string;
+using std::pair;
+
+// Internal types --------------------------------------------------------------
+//! \brief Issue of the CNL content
+struct CnlIssue {
+	size_t  line;  //!< Line number, starting from 0 in the chunk and from 1 in the file
+	size_t  column;  //!< Column (byte position) in the line, starting from 1
+	string  text;  //!< Description of the issue
+
+	CnlIssue(size_t line=0, size_t column=0, string text=string())
+	: line(line), column(column), text(std::move(text))  {}
+};
+
+//! \brief Statistics of the CNL content (chunk)
+struct CnlStat {
+	size_t  lines;  //!< The number of lines ('\n')
+	size_t  clusters;  //!< The number of non-empty clusters
+	size_t  members;  //!< The number of valid members
+	size_t  issues;  //!< The number of issues
+	bool  shares;  //!< The members have shares (the clusters are fuzzy)
+	bool  numbered;  //!< The clusters have ids
+	vector<CnlIssue>  examples;  //!< The first issues
+
+	CnlStat(): lines(0), clusters(0), members(0), issues(0), shares(false), numbered(false)
+	, examples()  {}
+};
+
+//! Line-aligned span of the CNL content
+using CnlSpan = pair<const char*, const char*>;
+
+//! \brief Summary of the CNL content (span) clusters
+struct CnlInfo {
+	size_t  clusters;  //!< The number of non-empty clusters
+	size_t  members;  //!< The number of members
+	size_t  smin;  //!< Min size of the clusters
+	size_t  smax;  //!< Max size of the clusters
+
+	CnlInfo() noexcept: clusters(0), members(0), smin(numeric_limits<size_t>::max()), smax(0)  {}
+
+    //! \brief Add the cluster of the specified size
+	void add(size_t size) noexcept
+	{
+		++clusters;
+		members += size;
+		smin = std::min(smin, size);
+		smax = std::max(smax, size);
+	}
+
+    //! \brief Unite with the specified summary
+	CnlInfo& operator +=(const CnlInfo& info) noexcept
+	{
+		clusters += info.clusters;
+		members += info.members;
+		smin = std::min(smin, info.smin);
+		smax = std::max(smax, info.smax);
+		return *this;
+	}
+};
+
+//! Unspecified count of the header
+constexpr size_t  COUNT_NONE = size_t(-1);
+
+// Internal functions ----------------------------------------------------------
+//! \brief Whether the char is plain, i.e. a digit or a delimiter of the members
+inline bool isPlainChar(char c) noexcept
+	{ return (c >= '0' && c <= '9') || c == ' ' || c == '\t' || c == '\n'; }
+
+//! \brief Whether the token ends at the specified position
+inline bool isTokenEnd(const char* pos, const char* end) noexcept
+	{ return pos == end || *pos == ' ' || *pos == '\t' || *pos == '\n' || *pos == '\r'; }
+
+//! \brief Quote the token truncating it to the reasonable length
+static string quote(const char* tok, const char* tend)
+{
+	constexpr size_t  lenmax = 24;
+	return string("'").append(tok, std::min<size_t>(tend - tok, lenmax))
+		.append(size_t(tend - tok) > lenmax ? "...'" : "'");
+}
+
+//! \brief Find the first special char, which is neither a digit nor a delimiter
+//! 	of the members, scanning the content by 16 bytes when possible
+//!
+//! \param pos const char*  - beginning of the content
+//! \param end const char*  - end of the content
+//! \return const char*  - the special char or end
+static const char* findSpecial(const char* pos, const char* end) noexcept
+{
+#ifdef __SSE2__
+	const __m128i  digbeg = _mm_set1_epi8('0' - 1);
+	const __m128i  digend = _mm_set1_epi8('9' + 1);
+	const __m128i  space = _mm_set1_epi8(' ');
+	const __m128i  tab = _mm_set1_epi8('\t');
+	const __m128i  eol = _mm_set1_epi8('\n');
+	for(; end - pos >= 16; pos += 16) {
+		const __m128i  chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pos));
+		// Note: the chars >= 0x80 are negative, so they are not classified as digits
+		const __m128i  digits = _mm_and_si128(_mm_cmpgt_epi8(chars, digbeg), _mm_cmplt_epi8(chars, digend));
+		const __m128i  delims = _mm_or_si128(_mm_cmpeq_epi8(chars, space)
+			, _mm_or_si128(_mm_cmpeq_epi8(chars, tab), _mm_cmpeq_epi8(chars, eol)));
+		const unsigned  mask = ~_mm_movemask_epi8(_mm_or_si128(digits, delims)) & 0xFFFF;
+		if(mask)
+			return pos + __builtin_ctz(mask);
+	}
+#endif // __SSE2__
+	while(pos != end && isPlainChar(*pos))
+		++pos;
+	return pos;
+}
+
+//! \brief Split the CNL content into the line-aligned spans of about the specified size
+//!
+//! \param data const char*  - the content
+//! \param size size_t  - the number of bytes in the content
+//! \param spansize size_t  - the target size of the span
+//! \return vector<CnlSpan>  - resulting spans
+static vector<CnlSpan> splitLines(const char* data, size_t size, size_t spansize)
+{
+	vector<CnlSpan>  spans;
+	const char* const  eof = data + size;
+	for(const char* beg = data; beg != eof;) {
+		const char*  end = beg + std::min<size_t>(spansize, eof - beg);
+		const char* const  eol = static_cast<const char*>(memchr(end, '\n', eof - end));
+		end = eol ? eol + 1 : eof;
+		spans.emplace_back(beg, end);
+		beg = end;
+	}
+	return spans;
+}
+
+//! \brief Validate the header of the CNL content
+//! \note The header is parsed the same way as by parseCnlHeader()
+//!
+//! \param data const char*  - the content
+//! \param size size_t  - the number of bytes in the content
+//! \param[out] clsnum size_t&  - the number of clusters, COUNT_NONE if not specified
+//! \param[out] ndsnum size_t&  - the number of nodes, COUNT_NONE if not specified
+//! \param issues vector<CnlIssue>&  - accumulated issues
+//! \return size_t  - the number of the header line (starting from 1), 0 if the header is absent
+static size_t checkHeader(const char* data, size_t size, size_t& clsnum, size_t& ndsnum
+, vector<CnlIssue>& issues)
+{
+	constexpr char  clsmark[] = "clusters";
+	constexpr char  ndsmark[] = "nodes";
+	clsnum = COUNT_NONE;
+	ndsnum = COUNT_NONE;
+	auto  isDelim = [](char c) noexcept  { return c == ' ' || c == '\t' || c == ':' || c == ',' || c == '\r'; };
+	const char* const  eof = data + size;
+	size_t  lnum = 0;  // The number of lines
+	// Consider only subsequent comments and empty lines
+	for(const char* lbeg = data; lbeg != eof && (*lbeg == '#' || *lbeg == '\n');) {
+		const char*  lend = static_cast<const char*>(memchr(lbeg, '\n', eof - lbeg));
+		if(!lend)
+			lend = eof;
+		++lnum;
+		// Tokenize the line skipping the leading '#'
+		const char*  pos = lbeg + 1;
+		auto  nextToken = [&pos, lend, isDelim](const char*& tend) noexcept -> const char* {
+			while(pos < lend && isDelim(*pos))
+				++pos;
+			const char* const  tok = pos;
+			while(pos < lend && !isDelim(*pos))
+				++pos;
+			tend = pos;
+			return tok < pos ? tok : nullptr;
+		};
+		const char*  tend = nullptr;
+		const char*  tok = nextToken(tend);
+		// Skip empty lines, comments without the string continuation and continuous comments
+		if(*lbeg != '#' || !tok || *tok == '#') {
+			lbeg = lend + (lend != eof);
+			continue;
+		}
+		bool  header = false;  // The line is a header, i.e. starts with a known attribute
+		for(unsigned attrs = 0; tok && attrs < 2; tok = nextToken(tend), ++attrs) {
+			size_t*  count = nullptr;
+			const size_t  toklen = tend - tok;
+			if(toklen == sizeof clsmark - 1 && !strncasecmp(tok, clsmark, toklen))
+				count = &clsnum;
+			else if(toklen == sizeof ndsmark - 1 && !strncasecmp(tok, ndsmark, toklen))
+				count = &ndsnum;
+			else break;
+			header = true;
+			const string  attr(tok, toklen);
+			const char* const  vtok = nextToken(tend);
+			size_t  val = 0;
+			const char*  ic = vtok;
+			for(; ic && ic != tend && *ic >= '0' && *ic <= '9' && val <= numeric_limits<size_t>::max() / 10; ++ic)
+				val = val * 10 + (*ic - '0');
+			if(!vtok || ic != tend) {
+				issues.push_back({lnum, size_t((vtok ? vtok : lend) - lbeg) + 1
+					, "invalid header value of '" + attr + "': " + (vtok ? quote(vtok, tend) : "none")});
+				break;
+			}
+			*count = val;
+		}
+		return header ? lnum : 0;
+	}
+	return 0;
+}
+
+//! \brief Validate the line-aligned chunk of the CNL content
+//!
+//! \param beg const char*  - beginning of the chunk
+//! \param end const char*  - end of the chunk
+//! \param stat CnlStat&  - resulting statistics and issues
+//! \param nodes NodeBase&  - accumulated unique nodes
+//! \param issmax size_t  - max number of the captured issues
+//! \return void
+static void checkChunk(const char* beg, const char* end, CnlStat& stat, NodeBase& nodes
+, size_t issmax)
+{
+	constexpr Id  idmax = numeric_limits<Id>::max();
+	const char*  pos = beg;
+	const char*  lbeg = beg;  // Beginning of the current line
+	const char*  special = findSpecial(pos, end);  // The next special char
+	const char*  cid = nullptr;  // Cluster id of the line if any
+	const char*  cidend = nullptr;  // End of the cluster id
+	bool  first = true;  // The next token is the first one in the line
+	bool  lmbrs = false;  // The line has members
+	auto  report = [&stat, &lbeg, issmax](const char* at, string text) {
+		if(stat.issues++ < issmax)
+			stat.examples.push_back({stat.lines, size_t(at - lbeg) + 1, std::move(text)});
+	};
+	while(true) {
+		// Skip the delimiters and process the end of line
+		while(pos != end && (*pos == ' ' || *pos == '\t' || *pos == '\r'))
+			++pos;
+		if(pos == end || *pos == '\n') {
+			if(cid && !lmbrs)
+				report(cid, "empty cluster " + quote(cid, cidend));
+			stat.clusters += lmbrs;
+			if(pos == end)
+				break;
+			++stat.lines;
+			lbeg = ++pos;
+			cid = nullptr;
+			lmbrs = false;
+			first = true;
+			continue;
+		}
+		if(pos > special)
+			special = findSpecial(pos, end);
+		const char* const  tok = pos;
+		uint64_t  nid = 0;
+		for(; pos != end && *pos >= '0' && *pos <= '9'; ++pos)
+			if(nid <= idmax)
+				nid = nid * 10 + (*pos - '0');
+		bool  valid = pos != tok;  // The token is a valid node id
+		// Note: the token is followed by a delimiter unless it contains a special char
+		if(pos == special && !isTokenEnd(pos, end)) {
+			if(first && *pos == '#' && !valid) {
+				// Skip the comment
+				pos = static_cast<const char*>(memchr(pos, '\n', end - pos));
+				if(!pos)
+					pos = end;
+				continue;
+			}
+			if(first && *pos == '>' && valid && isTokenEnd(pos + 1, end)) {
+				// Cluster id
+				stat.numbered = true;
+				first = false;
+				cid = tok;
+				cidend = ++pos;
+				continue;
+			}
+			if(*pos == ':' && valid) {
+				// Share of the node, which is a non-negative real number
+				const char* const  shr = ++pos;
+				bool  digits = false;
+				for(; pos != end && ((*pos >= '0' && *pos <= '9') || *pos == '.' || *pos == 'e'
+				|| *pos == 'E' || *pos == '+' || *pos == '-'); ++pos)
+					digits = digits || (*pos >= '0' && *pos <= '9');
+				if(!digits || !isTokenEnd(pos, end)) {
+					while(!isTokenEnd(pos, end))
+						++pos;
+					report(shr, "invalid share of the node " + quote(tok, pos));
+					valid = false;
+				} else stat.shares = true;
+			} else {
+				const char* const  ic = pos;
+				while(!isTokenEnd(pos, end))
+					++pos;
+				string  text = (ic == tok && *ic == '#' ? "misplaced comment " : "invalid node id ")
+					+ quote(tok, pos);
+				// Specify the non-printable char
+				if(uint8_t(*ic) < 0x20 || uint8_t(*ic) >= 0x7F) {
+					char  code[16];
+					snprintf(code, sizeof code, " (char 0x%02X)", uint8_t(*ic));
+					text += code;
+				}
+				report(ic, std::move(text));
+				valid = false;
+			}
+		}
+		first = false;
+		if(!valid)
+			continue;
+		if(nid > idmax) {
+			report(tok, "node id overflow " + quote(tok, pos));
+			continue;
+		}
+		lmbrs = true;
+		++stat.members;
+		nodes.insert(nid);
+	}
+}
+
+//! \brief Scan the CNL content by the line-aligned chunks in parallel
+//!
+//! \param data const char*  - the content
+//! \param size size_t  - the number of bytes in the content
+//! \param wnodes vector<NodeBase>&  - nodes of each worker, the resulting unique
+//! 	nodes of the content are united into the front one
+//! \param issmax size_t  - max number of the captured issues
+//! \param issues vector<CnlIssue>&  - accumulated issues with the lines of the content
+//! \return CnlStat  - statistics of the content without the examples of the issues
+static CnlStat scanCnl(const char* data, size_t size, vector<NodeBase>& wnodes, size_t issmax
+, vector<CnlIssue>& issues)
+{
+	const size_t  chunksize = std::max<size_t>(size / (wnodes.size() * 4), 1 << 20);
+	const auto  spans = splitLines(data, size, chunksize);
+	vector<CnlStat>  stats(spans.size());
+	for(auto& nodes: wnodes)
+		nodes.clear();
+	parallelFor(spans.size(), wnodes.size(), [&](size_t ispan, unsigned iworker) {
+		TraceSpan  span("check", "chunk");
+		checkChunk(spans[ispan].first, spans[ispan].second, stats[ispan], wnodes[iworker], issmax);
+	});
+	// Unite the worker nodes
+	for(size_t i = 1; i < wnodes.size(); ++i)
+		wnodes.front() |= wnodes[i];
+
+	// Aggregate the statistics converting the issue lines to the content lines
+	CnlStat  res;
+	for(auto& stat: stats) {
+		for(auto& iss: stat.examples) {
+			iss.line += res.lines + 1;
+			issues.push_back(std::move(iss));
+		}
+		res.lines += stat.lines;
+		res.clusters += stat.clusters;
+		res.members += stat.members;
+		res.issues += stat.issues;
+		res.shares = res.shares || stat.shares;
+		res.numbered = res.numbered || stat.numbered;
+	}
+	return res;
+}
+
+//! \brief Summarize the clusters of the CNL content span by counting the tokens
+//! 	of the lines, which are processed by 16 bytes when possible
+//! \note The members are not parsed, so the invalid ones are also counted
+//!
+//! \param beg const char*  - beginning of the span
+//! \param end const char*  - end of the span
+//! \return CnlInfo  - summary of the span
+static CnlInfo inspectSpan(const char* beg, const char* end)
+{
+	CnlInfo  info;
+	const char*  lbeg = beg;  // Beginning of the line
+	size_t  toks = 0;  // The number of tokens in the line
+	bool  delim = true;  // The previous char is a delimiter
+	// Account the cluster of the line omitting comments and the cluster id
+	auto  endLine = [&info, &lbeg, &toks](const char* lend) noexcept {
+		if(toks) {
+			const char*  tok = lbeg;
+			while(*tok == ' ' || *tok == '\t' || *tok == '\r')
+				++tok;
+			if(*tok != '#') {
+				const char*  tend = tok;
+				while(tend != lend && !isTokenEnd(tend, lend))
+					++tend;
+				const size_t  size = toks - (tend[-1] == '>');
+				if(size)
+					info.add(size);
+			}
+		}
+		lbeg = lend + 1;
+		toks = 0;
+	};
+	const char*  pos = beg;
+#ifdef __SSE2__
+	const __m128i  space = _mm_set1_epi8(' ');
+	const __m128i  tab = _mm_set1_epi8('\t');
+	const __m128i  eol = _mm_set1_epi8('\n');
+	const __m128i  ret = _mm_set1_epi8('\r');
+	for(; end - pos >= 16; pos += 16) {
+		const __m128i  chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pos));
+		const unsigned  eols = _mm_movemask_epi8(_mm_cmpeq_epi8(chars, eol));
+		const unsigned  delims = eols | _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chars, space)
+			, _mm_or_si128(_mm_cmpeq_epi8(chars, tab), _mm_cmpeq_epi8(chars, ret))));
+		// Beginnings of the tokens, i.e. non-delimiters following the delimiters
+		unsigned  starts = ~delims & ((delims << 1) | delim) & 0xFFFF;
+		delim = delims >> 15;
+		for(unsigned nls = eols; nls; nls &= nls - 1) {
+			const unsigned  ieol = __builtin_ctz(nls);
+			const unsigned  lower = (1u << ieol) - 1;  // Chars of the block preceding the eol
+			toks += __builtin_popcount(starts & lower);
+			starts &= ~lower;
+			endLine(pos + ieol);
+		}
+		toks += __builtin_popcount(starts);
+	}
+#endif // __SSE2__
+	for(; pos != end; ++pos) {
+		const bool  dlm = isTokenEnd(pos, end);
+		toks += !dlm && delim;
+		delim = dlm;
+		if(*pos == '\n')
+			endLine(pos);
+	}
+	if(lbeg < end)
+		endLine(end);
+	return info;
+}
+
+// Checker functions definitions -----------------------------------------------
+bool checkCollections(NamedFileWrappers& files, unsigned threads, size_t issmax)
+{
+	const unsigned  workers = workersNum(threads);
+	vector<NodeBase>  wnodes(workers);  // Nodes of each worker
+	size_t  fnum = 0;  // The number of validated files
+	size_t  vfnum = 0;  // The number of valid files
+	const bool  processed = forEachInput(files, [&](NamedFileWrapper& file) -> bool {
+		// Note: the mapped content includes the header, which is skipped as a comment
+		const MappedFile  content(file);
+		vector<CnlIssue>  issues;  // Issues of the file
+		size_t  clsnum = 0;  // The number of clusters specified in the header
+		size_t  ndsnum = 0;  // The number of nodes specified in the header
+		const size_t  hdrline = checkHeader(content.data(), content.size(), clsnum, ndsnum, issues);
+		size_t  issnum = issues.size();  // The number of issues
+
+		const CnlStat  stat = scanCnl(content.data(), content.size(), wnodes, issmax, issues);
+		const NodeBase&  nodes = wnodes.front();  // Unique nodes
+		issnum += stat.issues;
+		// Verify the header counts
+		vector<CnlIssue>  hdrissues;  // Mismatches of the header counts
+		if(clsnum != COUNT_NONE && clsnum != stat.clusters)
+			hdrissues.push_back({hdrline, 1, "the header specifies " + to_string(clsnum)
+				+ " clusters but " + to_string(stat.clusters) + " non-empty clusters are present"});
+		if(ndsnum != COUNT_NONE && ndsnum != nodes.size())
+			hdrissues.push_back({hdrline, 1, "the header specifies " + to_string(ndsnum)
+				+ " nodes but " + to_string(nodes.size()) + " unique nodes are present"});
+		issnum += hdrissues.size();
+		issues.insert(issues.begin(), hdrissues.begin(), hdrissues.end());
+
+		if(issues.size() > issmax)
+			issues.resize(issmax);
+		for(const auto& iss: issues)
+			printf("%s:%lu:%lu: %s\n", file.name().c_str(), iss.line, iss.column, iss.text.c_str());
+		if(issnum > issues.size())
+			printf("%s: %lu more issues are omitted\n", file.name().c_str(), issnum - issues.size());
+		printf("%s: %s, %lu clusters, %lu nodes, %lu members, %lu issues\n", file.name().c_str()
+			, issnum ? "INVALID" : "valid", stat.clusters, nodes.size(), stat.members, issnum);
+		++fnum;
+		vfnum += !issnum;
+		return true;
+	});
+	printf("%lu of %lu CNL files are valid\n", vfnum, fnum);
+	return processed && vfnum == fnum;
+}
+
+bool annotateCollections(NamedFileWrappers& files, unsigned threads)
+{
+	const unsigned  workers = workersNum(threads);
+	vector<NodeBase>  wnodes(workers);  // Nodes of each worker
+	size_t  anum = 0;  // The number of annotated files
+	bool  success = true;
+	for(auto& file: files) {
+		if(TarReader::isArchive(file.name())) {
+			fprintf(stderr, "WARNING annotateCollections(), the archive can't be annotated"
+				" in place, skipped: %s\n", file.name().c_str());
+			continue;
+		}
+		const MappedFile  content(file);
+		vector<CnlIssue>  issues;  // Issues of the file, which are only counted
+		size_t  clsnum = 0;  // The number of clusters specified in the header
+		size_t  ndsnum = 0;  // The number of nodes specified in the header
+		const size_t  hdrline = checkHeader(content.data(), content.size(), clsnum, ndsnum, issues);
+		const CnlStat  stat = scanCnl(content.data(), content.size(), wnodes, 0, issues);
+		const size_t  nodesnum = wnodes.front().size();  // The number of unique nodes
+		if(stat.issues)
+			fprintf(stderr, "WARNING annotateCollections(), %lu issues are found in %s"
+				", only the valid clusters and members are counted (see --check)\n"
+				, stat.issues, file.name().c_str());
+		if(clsnum == stat.clusters && ndsnum == nodesnum) {
+			printf("%s: the header is valid, %lu clusters, %lu nodes\n", file.name().c_str()
+				, stat.clusters, nodesnum);
+			continue;
+		}
+
+		// Locate the replacing header line
+		const char*  hbeg = content.data();  // Beginning of the header line
+		const char*  hend = hbeg;  // End of the header line
+		const char* const  eof = content.data() + content.size();
+		if(hdrline) {
+			for(size_t i = 1; i < hdrline; ++i)
+				hbeg = static_cast<const char*>(memchr(hbeg, '\n', eof - hbeg)) + 1;
+			hend = static_cast<const char*>(memchr(hbeg, '\n', eof - hbeg));
+			hend = hend ? hend + 1 : eof;
+		}
+		const string  header = "# Clusters: " + to_string(stat.clusters) + ", Nodes: "
+			+ to_string(nodesnum) + ", Fuzzy: " + to_string(stat.shares) + ", Numbered: "
+			+ to_string(stat.numbered) + "\n";
+		// Write the annotated content to the temporary file and then replace the original one
+#ifdef __unix__
+		const string  tmpname = file.name() + ".tmp" + to_string(getpid());
+#else
+		const string  tmpname = file.name() + ".tmp";
+#endif // __unix__
+		bool  saved = false;
+		{
+			FileWrapper  ftmp(fopen(tmpname.c_str(), "wb"));
+			saved = ftmp && fwrite(content.data(), 1, hbeg - content.data(), ftmp) == size_t(hbeg - content.data())
+				&& fputs(header.c_str(), ftmp) != EOF
+				&& fwrite(hend, 1, eof - hend, ftmp) == size_t(eof - hend)
+				&& !fflush(ftmp);
+#ifdef __unix__
+			// Retain the permissions of the original file
+			struct stat  fst;
+			if(saved && !fstat(fileno(file), &fst))
+				fchmod(fileno(ftmp), fst.st_mode & 07777);
+#endif // __unix__
+		}
+		saved = saved && !rename(tmpname.c_str(), file.name().c_str());
+		if(!saved) {
+			perror(("ERROR annotateCollections(), the header can't be written to " + file.name()).c_str());
+			remove(tmpname.c_str());
+			success = false;
+			continue;
+		}
+		++anum;
+		printf("%s: annotated, %lu clusters, %lu nodes\n", file.name().c_str(), stat.clusters, nodesnum);
+	}
+	printf("%lu of %lu CNL files are annotated\n", anum, files.size());
+	return success;
+}
+
+bool inspectCollections(NamedFileWrappers& files, unsigned threads)
+{
+	const unsigned  workers = workersNum(threads);
+	constexpr size_t  batchmax = 256;  // Max number of the simultaneously mapped files
+	//! Inspected file
+	struct Inspected {
+		string  name;  //!< Name of the file
+		std::unique_ptr<MappedFile>  content;  //!< Content of the file
+		size_t  ndsnum;  //!< The number of nodes specified in the header
+		CnlInfo  info;  //!< Summary of the clusters
+	};
+	vector<Inspected>  batch;  // Inspecting files
+	vector<pair<CnlSpan, size_t>>  spans;  // Spans of the batch files with the file index
+	vector<CnlInfo>  infos;  // Summaries of the spans
+	CnlInfo  total;  // Summary of all files
+	size_t  fnum = 0;  // The number of inspected files
+	vector<CnlIssue>  issues;  // Header issues, which are omitted
+
+	printf("%12s %14s %10s %10s %12s  %s\n", "Clusters", "Members", "Size min", "Size max"
+		, "Nodes (hdr)", "File");
+	// Inspect the batch of files by the line-aligned spans in parallel
+	auto  inspectBatch = [&]() {
+		spans.clear();
+		for(size_t i = 0; i < batch.size(); ++i) {
+			const MappedFile&  content = *batch[i].content;
+			const size_t  spansize = std::max<size_t>(content.size() / (workers * 4), 1 << 20);
+			for(const auto& span: splitLines(content.data(), content.size(), spansize))
+				spans.emplace_back(span, i);
+		}
+		infos.assign(spans.size(), CnlInfo());
+		parallelFor(spans.size(), workers, [&](size_t ispan, unsigned) {
+			TraceSpan  span("inspect", "chunk");
+			infos[ispan] = inspectSpan(spans[ispan].first.first, spans[ispan].first.second);
+		});
+		for(size_t i = 0; i < spans.size(); ++i)
+			batch[spans[i].second].info += infos[i];
+		for(const auto& fl: batch) {
+			const CnlInfo&  info = fl.info;
+			printf("%12lu %14lu %10lu %10lu %12s  %s\n", info.clusters, info.members
+				, info.clusters ? info.smin : 0, info.smax
+				, fl.ndsnum != COUNT_NONE ? to_string(fl.ndsnum).c_str() : "-", fl.name.c_str());
+			total += info;
+		}
+		fnum += batch.size();
+		batch.clear();
+	};
+	const bool  processed = forEachInput(files, [&](NamedFileWrapper& file) -> bool {
+		batch.push_back({file.name(), std::unique_ptr<MappedFile>(new MappedFile(file)), 0, CnlInfo()});
+		size_t  clsnum = 0;
+		const MappedFile&  content = *batch.back().content;
+		checkHeader(content.data(), content.size(), clsnum, batch.back().ndsnum, issues);
+		// Note: the archive entries are not mapped but read, so they are inspected one by one
+		if(batch.size() >= batchmax || !content.mapped())
+			inspectBatch();
+		return true;
+	});
+	inspectBatch();
+	printf("%12lu %14lu %10lu %10lu %12s  TOTAL of %lu files\n", total.clusters, total.members
+		, total.clusters ? total.smin : 0, total.smax, "-", fnum);
+	return processed;
+}
@@ -0,0 +1,98 @@
+//! \brief Fingerprint index of the merged clusters for the fast lookup
+//!
+//! \license Apache License, Version 2.0: http://www.apache.org/licenses/LICENSE-2.0.html
+//! > 	Simple explanation: https://tldrlegal.com/license/apache-license-2.0-(apache-2.0)
+//!
+//! Copyright (c)
+//! \authr Artem Lutov
+//! \email luart@ya.ru
+//! \date 2026-10-18
+
+#include <cstring>  // memcmp
+#include <algorithm>  // sort, lower_bound
+
+#ifdef __unix__
+#include <sys/mman.h>  // madvise
+#endif // __unix__
+
+#include "fpindex.h"
+
+
+constexpr char  FingerprintIndex::signature[];
+constexpr uint32_t  FingerprintIndex::version;
+
+// Index Types definitions -----------------------------------------------------
+FingerprintIndex::FingerprintIndex(NamedFileWrapper& file)
+: m_file(file), m_entries(nullptr), m_size(0), m_key(0)
+{
+	Header  hdr;
+	if(m_file.size() < sizeof hdr) {
+		fprintf(stderr, "ERROR FingerprintIndex(), '%s' is not a fingerprint index\n"
+			, file.name().c_str());
+		return;
+	}
+	memcpy(&hdr, m_file.data(), sizeof hdr);
+	// Note: the version 1 differs only by the unkeyed fingerprints
+	if(memcmp(hdr.magic, signature, sizeof signature) || hdr.version > version
+	|| hdr.entrysize != sizeof(Entry)) {
+		fprintf(stderr, "ERROR FingerprintIndex(), '%s' is not a fingerprint index"
+			" of the version <= %u\n", file.name().c_str(), version);
+		return;
+	}
+	if(m_file.size() != sizeof hdr + hdr.size * sizeof(Entry)) {
+		fprintf(stderr, "ERROR FingerprintIndex(), '%s' is truncated or corrupted\n"
+			, file.name().c_str());
+		return;
+	}
+#ifdef __unix__
+	// Note: the entries are accessed by the binary search, so the read ahead is useless
+	if(m_file.mapped())
+		madvise(const_cast<char*>(m_file.data()), m_file.size(), MADV_RANDOM);
+#endif // __unix__
+	// Note: the header size is a multiple of the entries alignment and the content
+	// is either page aligned when mapped or aligned by the allocator
+	m_entries = reinterpret_cast<const Entry*>(m_file.data() + sizeof hdr);
+	m_size = hdr.size;
+	m_key = hdr.version >= 2 ? hdr.key : 0;
+}
+
+auto FingerprintIndex::find(const Fingerprint& fp) const noexcept -> const Entry*
+{
+	const Entry* const  end = m_entries + m_size;
+	const Entry*  ient = std::lower_bound(m_entries, end, fp
+		, [](const Entry& ent, const Fingerprint& fp) noexcept { return ent.fp < fp; });
+	return ient != end && ient->fp == fp ? ient : nullptr;
+}
+
+bool FingerprintIndex::save(const string& name, Entries& entries, daoc::OutputGroup* group)
+{
+	TraceSpan  span("output", "flush", name);
+	std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) noexcept {
+		return a.fp < b.fp;
+	});
+
+	Header  hdr;
+	memset(&hdr, 0, sizeof hdr);
+	memcpy(hdr.magic, signature, sizeof signature);
+	hdr.version = version;
+	hdr.entrysize = sizeof(Entry);
+	hdr.size = entries.size();
+	hdr.key = Fingerprint::key();
+	const string  tmpname = daoc::OutputGroup::tmpName(name);
+	bool  saved = false;
+	{
+		FileWrapper  fidx(fopen(tmpname.c_str(), "wb"));
+		saved = fidx && fwrite(&hdr, sizeof hdr, 1, fidx) == 1
+			&& fwrite(entries.data(), sizeof(Entry), entries.size(), fidx) == entries.size()
+			&& !fflush(fidx);
+	}
+	// Note: the grouped index is renamed on the commit of the group
+	if(saved && group)
+		group->add(tmpname, name);
+	else saved = saved && !rename(tmpname.c_str(), name.c_str());
+	if(!saved) {
+		perror(("ERROR FingerprintIndex::save(), the index can't be saved to " + name).c_str());
+		remove(tmpname.c_str());
+	}
+	return saved;
+}
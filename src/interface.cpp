@@ -8,25 +8,337 @@
 //! \email luart@ya.ru
 //! \date 2017-02-13
 
-#include <cstring>  // strlen
+#include <cstring>  // strlen, memmove
 #include <unordered_map> // strlen
 #include <cmath>  // sqrt
 #include <cassert>
 #include <stdexcept>
 #include <limits>
 #include <algorithm>
+#include <atomic>
+#include <iterator>  // end
+#include <random>  // random_device
+#include <memory>  // unique_ptr
+
 #include "interface.h"
+#include "fpindex.h"
+#include "postings.h"
+#include "arrowio.hpp"
 
 
 using std::unordered_map;
 using std::invalid_argument;
 using std::numeric_limits;
 using std::find;
+using std::atomic;
 using fs::exists;
 using fs::is_directory;
 using fs::directory_iterator;
 
 
+// Internal functions ----------------------------------------------------------
+//! \brief Process each query cluster of the input files
+//!
+//! \tparam Process  - cluster processing function:
+//! 	bool (const string& qname, const vector<Id>& nodes)
+//!
+//! \param files NamedFileWrappers&  - input files including the archives
+//! \param process Process  - query cluster processing returning false on the fatal error,
+//! 	where qname is <file>:<line> of the cluster and nodes are its members
+//! \return bool  - all clusters are processed without the fatal errors
+template <typename Process>
+bool forEachQuery(NamedFileWrappers& files, Process process)
+{
+	StringBuffer  line;  // Reading line of the header
+	vector<Id>  nodes;  // Nodes of the query cluster
+	string  qname;  // Name of the query cluster
+	return forEachInput(files, [&](NamedFileWrapper& file) -> bool {
+		size_t  clsnum = 0;  // The number of clusters
+		size_t  ndsnum = 0;  // The number of nodes
+		const size_t  lnum = parseCnlHeader(file, line, clsnum, ndsnum);  // The number of header lines
+
+		MemberReader  mbrs(file, lnum);  // Members of the clusters
+		while(mbrs.nextLine()) {
+			size_t  toklen = 0;  // Length of the token
+			char *tok = mbrs.next(&toklen);
+			// Skip comments
+			if(!tok || tok[0] == '#')
+				continue;
+			// Skip the cluster id if present
+			if(tok[toklen - 1] == '>') {
+				const string  cidstr = tok;
+				tok = mbrs.next(&toklen);
+				if(!tok) {
+					Diagnostics::global().report(Issue::EMPTY_CLUSTER, file.name(), mbrs.line(), cidstr.c_str());
+					continue;
+				}
+			}
+			nodes.clear();
+			do {
+				// Note: only node id is parsed, share part is skipped if exists
+				Id  nid = strtoul(tok, nullptr, 10);
+#if VALIDATE >= 2
+				if(!nid && tok[0] != '0') {
+					Diagnostics::global().report(Issue::INVALID_ID, file.name(), mbrs.line(), tok);
+					continue;
+				}
+#endif // VALIDATE
+				nodes.push_back(nid);
+			} while((tok = mbrs.next(&toklen)));
+
+			qname = file.name();
+			qname.append(":").append(std::to_string(mbrs.line()));
+			if(!process(qname, nodes))
+				return false;
+		}
+		return true;
+	});
+}
+
+//! \brief Chunk of the CNL content for the parallel parsing
+struct CnlChunk {
+	const char*  beg;  //!< Beginning of the chunk
+	const char*  end;  //!< End of the chunk
+	bool  comment;  //!< The chunk starts inside a comment line
+	bool  first;  //!< The first token of the chunk is the first token of the line
+	bool  tail;  //!< The chunk ends inside a line, which is continued by the next chunk
+	size_t  line;  //!< Number of the line containing the beginning of the chunk, starting from 1
+};
+
+//! \brief Whether the char is a delimiter of the members
+//!
+//! \param c char  - the char to be checked
+//! \return bool  - the char is a delimiter
+inline bool isMbrDelim(char c) noexcept  { return c == ' ' || c == '\t' || c == '\n'; }
+
+//! \brief Split the CNL content into the chunks of about the specified size
+//! 	aligned to the lines, or to the members for the giant lines if allowed
+//!
+//! \param data const char*  - the content
+//! \param size size_t  - the number of bytes in the content
+//! \param chunksize size_t  - the target size of the chunk
+//! \param lines bool  - the chunks should be aligned to the lines
+//! \return vector<CnlChunk>  - resulting chunks
+static vector<CnlChunk> splitCnl(const char* data, size_t size, size_t chunksize, bool lines)
+{
+	vector<CnlChunk>  chunks;
+	const char* const  eof = data + size;
+	CnlChunk  chunk = {data, eof, false, true, false, 1};  // The forming chunk
+	while(chunk.beg < eof) {
+		const char*  target = chunk.beg + std::min<size_t>(chunksize, eof - chunk.beg);
+		// Align the chunk to the line if the line ends not too far
+		const char*  eol = static_cast<const char*>(memchr(target, '\n'
+			, lines ? eof - target : std::min<size_t>(chunksize, eof - target)));
+		if(eol || target == eof) {
+			chunk.end = eol ? eol + 1 : eof;
+			chunk.tail = false;
+			chunks.push_back(chunk);
+			chunk = {chunk.end, eof, false, true, false, 1};
+			continue;
+		}
+		// Split the giant line by the members
+		while(target != eof && !isMbrDelim(*target))
+			++target;
+		chunk.end = target;
+		chunk.tail = target != eof;
+		chunks.push_back(chunk);
+		// Identify the state of the line on the chunk boundary
+		const char*  lbeg = static_cast<const char*>(memrchr(chunk.beg, '\n', target - chunk.beg));
+		if(lbeg) {
+			// Note: the chunk starts the line, which is commented if the first non-space char is '#'
+			chunk.comment = false;
+			chunk.first = true;
+			++lbeg;
+		} else lbeg = chunk.beg;
+		while(lbeg != target && (*lbeg == ' ' || *lbeg == '\t'))
+			++lbeg;
+		if(lbeg != target) {
+			if(chunk.first)
+				chunk.comment = *lbeg == '#';
+			chunk.first = false;
+		}
+		chunk.beg = target;
+	}
+	return chunks;
+}
+
+//! \brief Number the lines of the chunks counting them in parallel
+//!
+//! \param chunks vector<CnlChunk>&  - the consecutive chunks of the content
+//! \param workers unsigned  - the number of worker threads
+//! \return void
+static void numberLines(vector<CnlChunk>& chunks, unsigned workers)
+{
+	vector<size_t>  lines(chunks.size());  // The number of the line ends in each chunk
+	parallelFor(chunks.size(), workers, [&chunks, &lines](size_t ichunk, unsigned) {
+		lines[ichunk] = std::count(chunks[ichunk].beg, chunks[ichunk].end, '\n');
+	});
+	size_t  line = 1;  // Number of the line starting the chunk
+	for(size_t i = 0; i < chunks.size(); ++i) {
+		chunks[i].line = line;
+		line += lines[i];
+	}
+}
+
+//! \brief Load nodes of the clusters from the CNL chunk
+//!
+//! \param chunk const CnlChunk&  - the chunk to be parsed
+//! \param nodes NodeBase&  - accumulated nodes
+//! \param cnds vector<Id>&  - buffer for the cluster nodes to filter the cluster by size
+//! \param cmin Id  - min allowed cluster size
+//! \param cmax Id  - max allowed cluster size, 0 means any size
+//! \param fname const string&  - name of the file for the diagnostics
+//! \param labels Labels*  - interning table of the string labels, nullptr for the numeric ids
+//! \return size_t  - the number of loaded members
+static size_t loadChunkNodes(const CnlChunk& chunk, NodeBase& nodes, vector<Id>& cnds
+, Id cmin, Id cmax, const string& fname, Labels* labels)
+{
+	const bool  sizefilt = cmin > 1 || cmax;  // Filter the clusters by size
+	const char*  pos = chunk.beg;
+	const char* const  end = chunk.end;
+	bool  first = chunk.first;  // The next token is the first one in the line
+	bool  skip = chunk.comment;  // Skip the remained line
+	const char*  cid = nullptr;  // Cluster id of the line if any
+	const char*  cidend = nullptr;  // End of the cluster id
+	bool  lmbrs = false;  // The line has members
+	size_t  line = chunk.line;  // The number of the current line
+	size_t  mbsnum = 0;  // The number of loaded members
+	cnds.clear();
+	while(true) {
+		// Skip the delimiters and process the end of line
+		while(pos != end && (*pos == ' ' || *pos == '\t'))
+			++pos;
+		if(pos == end || *pos == '\n') {
+			// Note: the members of the line are buffered only if the chunk is aligned to the lines
+			if(sizefilt && !skip && cnds.size() >= cmin)
+				nodes.insert(cnds.begin(), cnds.end());
+			// Skip empty clusters, which actually should not exist
+			if(cid && !lmbrs && (pos != end || !chunk.tail))
+				Diagnostics::global().report(Issue::EMPTY_CLUSTER, fname, line, cid, cidend - cid);
+			if(pos == end)
+				break;
+			++pos;
+			++line;
+			cnds.clear();
+			cid = nullptr;
+			lmbrs = false;
+			first = true;
+			skip = false;
+			continue;
+		}
+		const char*  tok = pos;
+		while(pos != end && !isMbrDelim(*pos))
+			++pos;
+		if(skip)
+			continue;
+		if(first) {
+			first = false;
+			// Skip comments and the cluster id if present
+			if(*tok == '#') {
+				skip = true;
+				continue;
+			}
+			if(pos[-1] == '>') {
+				cid = tok;
+				cidend = pos;
+				continue;
+			}
+		}
+		lmbrs = true;
+		// Note: only node id is parsed, share part is skipped if exists,
+		// the string label is interned as a whole
+		Id  nid = 0;
+		if(labels)
+			nid = labels->intern(tok, pos - tok);
+		else if(*tok >= '0' && *tok <= '9') {
+			for(; tok != pos && *tok >= '0' && *tok <= '9'; ++tok)
+				nid = nid * 10 + (*tok - '0');
+		}
+#if VALIDATE >= 2
+		else {
+			Diagnostics::global().report(Issue::INVALID_ID, fname, line, tok, pos - tok);
+			continue;
+		}
+#endif // VALIDATE
+		++mbsnum;
+		if(!sizefilt)
+			nodes.insert(nid);
+		else if(!cmax || cnds.size() < cmax)
+			cnds.push_back(nid);
+		else {
+			// The cluster exceeds cmax and is skipped
+			cnds.clear();
+			skip = true;
+		}
+	}
+	return mbsnum;
+}
+
+//! \brief Load nodes of the clusters streaming the CNL file by the members
+//! 	to bound the memory consumption of the non-mappable inputs
+//!
+//! \param file NamedFileWrapper&  - the file positioned to the first line following the header
+//! \param lnum size_t  - the number of the header lines
+//! \param nodes NodeBase&  - accumulated nodes
+//! \param cnds vector<Id>&  - buffer for the cluster nodes to filter the cluster by size
+//! \param cmin Id  - min allowed cluster size
+//! \param cmax Id  - max allowed cluster size, 0 means any size
+//! \param labels Labels*  - interning table of the string labels, nullptr for the numeric ids
+//! \return size_t  - the number of loaded members
+static size_t loadStreamNodes(NamedFileWrapper& file, size_t lnum, NodeBase& nodes, vector<Id>& cnds
+, Id cmin, Id cmax, Labels* labels)
+{
+	const bool  sizefilt = cmin > 1 || cmax;  // Filter the clusters by size
+	size_t  mbsnum = 0;  // The number of loaded members
+	MemberReader  mbrs(file, lnum);  // Members of the clusters
+	while(mbrs.nextLine()) {
+		size_t  toklen = 0;  // Length of the token
+		char *tok = mbrs.next(&toklen);
+
+		// Skip comments
+		if(!tok || tok[0] == '#')
+			continue;
+		// Skip the cluster id if present
+		if(tok[toklen - 1] == '>') {
+			const string  cidstr = tok;
+			tok = mbrs.next(&toklen);
+			// Skip empty clusters, which actually should not exist
+			if(!tok) {
+				Diagnostics::global().report(Issue::EMPTY_CLUSTER, file.name(), mbrs.line(), cidstr.c_str());
+				continue;
+			}
+		}
+		cnds.clear();
+		do {
+			// Note: only node id is parsed, share part is skipped if exists,
+			// the string label is interned as a whole
+			Id  nid = labels ? labels->intern(tok, toklen) : strtoul(tok, nullptr, 10);
+#if VALIDATE >= 2
+			if(!labels && !nid && tok[0] != '0') {
+				Diagnostics::global().report(Issue::INVALID_ID, file.name(), mbrs.line(), tok);
+				continue;
+			}
+#endif // VALIDATE
+			++mbsnum;
+			if(!sizefilt)
+				nodes.insert(nid);
+			else if(!cmax || cnds.size() < cmax)
+				cnds.push_back(nid);
+			else {
+				// The cluster exceeds cmax and is skipped
+				cnds.clear();
+				break;
+			}
+		} while((tok = mbrs.next(&toklen)));
+
+		// Filter read cluster by size
+		if(sizefilt && cnds.size() >= cmin)
+			nodes.insert(cnds.begin(), cnds.end());
+	}
+	cnds.clear();
+	return mbsnum;
+}
+
 // Interface functions definitions ---------------------------------------------
 NamedFileWrapper createFile(const string& outpname, bool rewrite)
 {
@@ -37,6 +349,9 @@ NamedFileWrapper createFile(const string& outpname, bool rewrite)
 			, outpname.c_str(), toYesNo(rewrite));
 		if(!rewrite)
 			return fout;
+		// Note: the existing file is removed rather than truncated, because
+		// it might be hardlinked (e.g. to the cached results)
+		remove(outpname.c_str());
 	} else {
 		// Ensure that target directory exists
 		auto  idir = outpname.rfind(PATHSEP);
@@ -61,6 +376,7 @@ NamedFileWrapper createFile(const string& outpname, bool rewrite)
 NamedFileWrappers openFiles(const FileNames& names)
 {
 	NamedFileWrappers files;  // NRVO (Return Value Optimization) is used
+	TraceSpan  span("input", "open");
 
 	assert(!names.empty() && "openFiles(), entry names are expected");
 	FileNames  unexisting;  // Unexisting entries
@@ -114,8 +430,12 @@ NamedFileWrappers openFiles(const FileNames& names)
 }
 
 bool mergeCollections(NamedFileWrapper& fout, NamedFileWrappers& files
-, NamedFileWrapper& fbase, Id cmin, Id cmax, float membership)
+, NamedFileWrapper& fbase, const MergeOptions& opts)
 {
+	const Id  cmin = opts.cmin;
+	const Id  cmax = opts.cmax;
+	const float  membership = opts.membership;
+
 	if(!fout) {
 		fputs("ERROR extractBase(), the output file is undefined\n", stderr);
 		return false;
@@ -128,34 +448,124 @@ bool mergeCollections(NamedFileWrapper& fout, NamedFileWrappers& files
 			return false;
 		}
 	}
+	// Form the outputs in the temporary files to commit them together on completion
+	// Note: the output is staged first to not leave its stub on the failure
+	OutputGroup  outputs;  // Outputs of the merging
+	if(!outputs.stage(fout))
+		return false;
 
 	// Load the node base, otherwise declare unique member node ids of the merged clusters
 	// Note: the node base clusters are not filtered by size, because they might be loaded
 	// either from the ground-truth collection or from the dedicated node base. The filtering
 	// is performed only on the node base extraction
-	auto  nodebase = loadNodes<Id, AccId>(fbase, membership);
+	// Note: the string labels are interned starting from the node base, so its
+	// nodes have the lowest ids
+	std::unique_ptr<Labels>  labels(opts.labels ? new Labels() : nullptr);  // Interned labels if required
+	NodeBase  nodebase = opts.netbase ? loadNetNodes<Id, NodeBase>(fbase, opts.threads, true, labels.get())
+		: loadNodes<Id, AccId, NodeBase>(fbase, membership, nullptr, 0, 0, true, labels.get());
 	const bool nosync = nodebase.empty();  // Do not sync the node base
+	const bool  intact = !nosync && opts.intact;  // Retain non-base members of the clusters
+	NodeBase  extnodes;  // Non-base nodes of the clusters retained intact
 
 	// Write a stub header the actual values of clusters and nodes will be later,
 	// so now just use stubs (' ' of the sufficient length) for them.
-	string  idvalStub = string(ceil(numeric_limits<Id>::digits10), ' ');
+	const string  idvalStub = OutputGroup::stub();
+	uint64_t  outofs = 0;  // Offset of the next output cluster
+	FingerprintIndex::Entries  fpentries;  // Fingerprints of the output clusters if required
+	PostingIndex::Clusters  pclusters;  // Output clusters to be indexed by the nodes if required
+	std::unique_ptr<daoc::ArrowWriter>  arrow;  // Arrow IPC output of the merged clusters if required
+	if(!opts.arrow.empty()) {
+		arrow.reset(new daoc::ArrowWriter(opts.arrow, opts.arrowmeta));
+		if(!*arrow)
+			return false;
+	}
 	const string  hdrprefix = "# Clusters: ";
 	const string  ndsprefix = " Nodes: ";
 	{
-		// Set first digit to zero to have a valid header in case the stub header will not be replaced
-		constexpr char zval[] = "0,";
-		idvalStub.replace(0, sizeof zval - 1, zval);  // Note: -1 to not include the null terminator
 		string  header(hdrprefix + idvalStub + ndsprefix + idvalStub  // Note: ',' can be putted later on the place of ' ' after the actual value
 			+ " Fuzzy: 0, Numbered: 0\n");
 		fputs(header.c_str(), fout);
+		outofs = header.size();
+	}
+	// Hierarchical delta of the levels if required, having the stub header similar to the output
+	const string  lvsprefix = "# Delta Levels: ";
+	const string  dclsprefix = " Clusters: ";
+	NamedFileWrapper  fdelta;  // Output file of the hierarchical delta
+	if(!opts.delta.empty()) {
+		// Note: the rewriting of the existing output is validated by the caller
+		try {
+			fdelta = createFile(opts.delta, true);
+		} catch(std::exception& err) {
+			fprintf(stderr, "%s\n", err.what());
+		}
+		if(!fdelta || !outputs.stage(fdelta)) {
+			fputs(("ERROR mergeCollections(), the delta output can't be created: " + opts.delta + '\n').c_str()
+				, stderr);
+			return false;
+		}
+		fputs((lvsprefix + idvalStub + dclsprefix + idvalStub + '\n').c_str(), fdelta);
 	}
+	vector<uint64_t, CountingAllocator<uint64_t, MemUse::INDICES>>  dltofs;  // Output offsets of the unique clusters to resolve their ordinals in the delta
+	BufferString  dltrefs;  // References of the level to the earlier occurred clusters in the delta
+	size_t  dltrefsnum = 0;  // The number of references in the delta
+	// Note: only the clusters recurring in at least opts.support inputs are output
+	// in the support mode, so the unique clusters are staged in the temporary file
+	// and then the supported ones are copied to the output
+	const bool  supmode = opts.support > 1;  // Support mode
+	const uint64_t  hdrsize = outofs;  // Size of the output header
+	NamedFileWrapper  fstage;  // Staging file of the unique clusters in the support mode
+	if(supmode) {
+		// Note: the name differs from the temporary name of the output
+		const string  stname = OutputGroup::tmpName(fout.name() + ".stage");
+		if(!fstage.reset(stname.c_str(), "w+")) {
+			perror(("ERROR mergeCollections(), the staging file can't be created: " + stname).c_str());
+			return false;
+		}
+		outofs = 0;
+	}
+	NamedFileWrapper&  fcls = supmode ? fstage : fout;  // Output file of the unique clusters
+	//! Support of the unique cluster by the inputs
+	struct ClusterSupport {
+		uint64_t  offset;  //!< Offset of the cluster line in the staging file
+		Id  support;  //!< The number of inputs containing the cluster
+		Id  input;  //!< Index of the last input containing the cluster
+		Id  source;  //!< Index of the first input containing the cluster
+	};
+	vector<ClusterSupport, CountingAllocator<ClusterSupport, MemUse::INDICES>>  csupports;  // Supports of the unique clusters in the order of their offsets
+	vector<string>  inputs;  // Names of the inputs in the support mode
+	Id  inpnum = 0;  // The number of processed inputs
 
 	// Hashes of the clusters
 	//using ClusterHashes = unordered_set<size_t>;
-	using ClusterHash = daoc::AggHash<>;
-	using ClusterHashes = vector<ClusterHash>;  // The same size_t (ClusterHash::hash) can be yielded for distinct ClusterHash
-	using ClustersHashes = unordered_map<ClusterHash::IdT, ClusterHashes>;
+	using ClusterHash = Fingerprint;
+	//! Hashed cluster
+	struct HashedCluster {
+		ClusterHash  fp;  //!< Fingerprint of the cluster
+		uint64_t  offset;  //!< Offset of the cluster line in the output (staging) file
+	};
+	// The same size_t (ClusterHash::hash) can be yielded for distinct ClusterHash
+	using ClusterHashes = vector<HashedCluster, CountingAllocator<HashedCluster, MemUse::HASH_CHAINS>>;
+	//! Chain of the hashed clusters having the same hash
+	struct HashesChain {
+		ClusterHashes  clusters;  //!< Hashed clusters
+		uint32_t  hits;  //!< The number of the matched fingerprints
+		bool  exact;  //!< Verify the matching fingerprints by the exact members
+
+		HashesChain(): clusters(), hits(0), exact(false)  {}
+	};
+	using ClustersHashes = unordered_map<size_t, HashesChain, std::hash<size_t>, std::equal_to<size_t>
+		, CountingAllocator<std::pair<const size_t, HashesChain>, MemUse::DEDUP_TABLE>>;
 	ClustersHashes  chashes;  // Hashes of the processed clusters
+	size_t  uclsnum = 0;  // The number of unique (output) clusters
+	// Key the fingerprints per run to make their collisions unpredictable, so
+	// crafted or pathological inputs can't yield long chains of the hashes
+	{
+		std::random_device  rdev;
+		AccId  key = 0;
+		while(!key)
+			key = AccId(rdev()) << 32 | rdev();
+		ClusterHash::key(key);
+	}
 	// Note: it is not mandatory to evaluate and write the number of unique nodes
 	// in the merged clusters, but it is much cheaper to do it on clusters merging
 	// than on reading the formed files. It will reduce the number of allocations on reading.
@@ -164,180 +574,842 @@ bool mergeCollections(NamedFileWrapper& fout, NamedFileWrappers& files
 	AccId  totmbs = 0;  // Total number of members (nodes with repetitions) read from all files
 	AccId  hashedmbs = 0;  // Total number of members (nodes with repetitions) in the hashed clusters from all files
 #endif // TRACE
-	// ATTENTION: without '\n' delimiter the terminating '\n' is read as an item
-	constexpr char  mbdelim[] = " \t\n";  // Delimiter for the members
 	// Note: strings defined out of the cycle to avoid reallocations
-	StringBuffer  line;  // Reading line
-	string  clstr;  // Writing cluster string
+	StringBuffer  line;  // Reading line of the header
+	BufferString  clstr;  // Writing cluster string
 	vector<Id>  cnds;  // Cluster nodes. Note: a dedicated container is required to filter clusters by size
 	Id  cfltnum = 0;  // The number of filtered out clusters
-	for(auto& file: files) {
-		// Note: CNL [CSN] format only is supported
-		size_t  clsnum = 0;  // The number of clusters
-		size_t  ndsnum = 0;  // The number of nodes
-
-		// Parse header and read the number of clusters if specified
-		parseCnlHeader(file, line, clsnum, ndsnum);
-
-		// Estimate the number of nodes and clusters in the file if not specified
-		uint8_t  estimnds = 0;  // Estimation flag
-		if(!ndsnum) {
-			size_t  cmsbytes = -1;
-			cmsbytes = file.size();
-			if(cmsbytes != size_t(-1)) {  // File length fetching failed
-				ndsnum = estimateCnlNodes(cmsbytes, membership);
-				estimnds = 1;
-			} else if(clsnum) {
-				ndsnum = 2 * clsnum; // / membership;  // Note: use optimistic estimate instead of pessimistic (square / membership) to not overuse the memory
-				estimnds = 2;
-			}
-		}
-		if(!clsnum && ndsnum) {
-			clsnum = estimateClusters(ndsnum, membership);
+	Id  dupclsnum = 0;  // The number of clusters having the repeated members
 #if TRACE >= 2
-			fprintf(stderr, "mergeCollections(), %lu nodes (estimated: %u)"
-				", %lu estimated clusters\n", ndsnum, estimnds, clsnum);
+	Id  cvfltnum = 0;  // The number of clusters filtered out by the node base coverage
 #endif // TRACE
+	// Chains of the hashes are monitored and on exceeding the expected length or
+	// the number of the matched fingerprints, the matching fingerprints of the chain
+	// are verified by the exact members of the output clusters
+	size_t  exactnum = 0;  // The number of the exactly verified chains
+	NamedFileWrapper  fvrf;  // Output file opened for reading to verify the clusters
+	StringBuffer  vline;  // Verifying line of the output file
+	vector<Id>  scnds;  // Sorted nodes of the current cluster
+	vector<Id>  vnds;  // Sorted nodes of the verifying cluster
+	// Whether the output cluster at the specified offset has the same members as the current one (cnds)
+	auto  sameMembers = [&](uint64_t offset) -> bool {
+		if(!fvrf && !fvrf.reset(fcls.name().c_str(), "r")) {
+			perror("WARNING mergeCollections(), the output can't be opened for the verification");
+			return true;  // Note: the plain fingerprints comparison is applied
+		}
+		if(scnds.empty()) {
+			scnds = cnds;
+			sort(scnds.begin(), scnds.end());
+		}
+		fflush(fcls);
+		vnds.clear();
+		if(fseek(fvrf, offset, SEEK_SET) || !vline.readline(fvrf))
+			return true;
+		char*  pos = nullptr;  // Tokenizing position
+		for(char* tok = strtok_r(vline, " \t\n", &pos); tok; tok = strtok_r(nullptr, " \t\n", &pos))
+			vnds.push_back(labels ? labels->intern(tok, strlen(tok)) : strtoul(tok, nullptr, 10));
+		sort(vnds.begin(), vnds.end());
+		return vnds == scnds;
+	};
+	// Members are filtered by the node base in blocks by the branch-free selection,
+	// which does not suffer from the mispredictions on the partial coverage
+	constexpr size_t  blockmbs = 256;  // The number of members in the filtering block
+	//! Block of the members to be filtered by the node base
+	struct MembersBlock {
+		vector<Id>  ids;  //!< Member ids
+		vector<size_t>  ends;  //!< End offsets of the members in the writing string
+		vector<uint32_t>  sel;  //!< Indices of the members present in the node base
+		size_t  begin;  //!< Offset of the block members in the writing string
+
+		MembersBlock(): ids(), ends(), sel(blockmbs), begin(0)
+		{
+			ids.reserve(blockmbs);
+			ends.reserve(blockmbs);
+		}
+	};
+	// Filter the block of members by the node base retaining all members if intact
+	// and compacting the writing string otherwise
+	// Returns the number of members present in the node base
+	auto filterMembers = [&nodebase, intact](MembersBlock& blk, BufferString& clstr, vector<Id>& cnds
+	, daoc::AggHash<Id, AccId>& agghash) noexcept -> size_t {
+		const size_t  selnum = nodebase.select(blk.ids.data(), blk.ids.size(), blk.sel.data());
+		if(intact) {
+			cnds.insert(cnds.end(), blk.ids.begin(), blk.ids.end());
+			for(auto nid: blk.ids)
+				agghash.add(nid);
 		} else {
+			size_t  pos = blk.begin;  // Position of the next retained member
+			for(size_t i = 0; i < selnum; ++i) {
+				const auto  j = blk.sel[i];
+				const Id  nid = blk.ids[j];
+				cnds.push_back(nid);
+				agghash.add(nid);
+				const size_t  mbeg = j ? blk.ends[j - 1] : blk.begin;  // Begin of the member
+				if(pos != mbeg)
+					memmove(&clstr[pos], &clstr[mbeg], blk.ends[j] - mbeg);
+				pos += blk.ends[j] - mbeg;
+			}
+			clstr.resize(pos);
+		}
+		blk.ids.clear();
+		blk.ends.clear();
+		blk.begin = clstr.size();
+		return selnum;
+	};
+	MembersBlock  mblock;  // Members block of the cluster
+	// The repeated members of the cluster are removed retaining their first occurrences
+	DupFilter<Id, CountingAllocator<uint32_t, MemUse::MEMBER_STAMPS>>  dupfilter;  // Filter of the repeated members
+	vector<uint32_t>  dupsel;  // Indices of the first occurrences of the members
+	BufferString  dupstr;  // Writing members without the repetitions
+	// Remove the repeated members from cnds and clstr, which hold the members
+	// in the same order, rehashing the cluster and updating the numbers of its members
+	auto  dedupMembers = [&](daoc::AggHash<Id, AccId>& agghash, size_t& clsmbs, size_t& basembs) {
+		dupsel.resize(cnds.size());
+		const size_t  num = dupfilter.firsts(cnds.data(), cnds.size(), dupsel.data());
+		agghash.clear();
+		dupstr.clear();
+		size_t  pos = 0;  // Begin of the member in the writing string
+		for(size_t i = 0, isel = 0; i < cnds.size(); ++i) {
+			const size_t  end = clstr.find(' ', pos) + 1;  // End of the member including the delimiter
+			const Id  nid = cnds[i];
+			if(isel < num && dupsel[isel] == i) {
+				dupstr.append(clstr, pos, end - pos);
+				agghash.add(nid);
+				cnds[isel++] = nid;
+			} else {
+				--clsmbs;
+				// Note: only the intact clusters have the non-base members
+				basembs -= nosync || !intact || nodebase.count(nid);
+			}
+			pos = end;
+		}
+		cnds.resize(num);
+		clstr.swap(dupstr);
+	};
+
+	// Members of the giant clusters are processed by the parts in parallel
+	//! Partial results of the members processing of a giant cluster
+	struct ClusterPart {
+		BufferString  mbrs;  //!< Raw members to be processed
+		BufferString  clstr;  //!< Writing members
+		vector<Id>  cnds;  //!< Member nodes
+		daoc::AggHash<Id, AccId>  agghash;  //!< Aggregation hash of the member nodes
+		MembersBlock  mblock;  //!< Members block to be filtered by the node base
+		size_t  clsmbs;  //!< The number of valid members
+		size_t  basembs;  //!< The number of members present in the node base
+
+		ClusterPart(): mbrs(), clstr(), cnds(), agghash(), mblock(), clsmbs(0), basembs(0)  {}
+	};
+	const unsigned  workers = workersNum(opts.threads);
+	// Note: the labels are interned sequentially, so the giant clusters are not split
+	const bool  parallel = workers > 1 && !labels;  // Process the giant clusters in parallel
+	constexpr size_t  giantmbs = 1 << 16;  // Min number of members to process the cluster in parallel
+	constexpr size_t  partsize = 1 << 22;  // Size of the raw members part in bytes
+	vector<ClusterPart>  parts(parallel ? workers : 0);
+	// Start the level (input) in the delta
+	auto  beginLevel = [&](Id input, const string& fname) {
+		if(fdelta)
+			fprintf(fdelta, "# Level %u: %s\n", input, fname.c_str());
+	};
+	// Complete the level in the delta outputting its references to the earlier occurred clusters
+	auto  endLevel = [&]() -> bool {
+		if(!dltrefs.empty()) {
+			if(fprintf(fdelta, "#@%s\n", dltrefs.c_str()) < 0) {
+				perror("ERROR mergeCollections(), the delta output failed");
+				return false;
+			}
+			dltrefs.clear();
+		}
+		return true;
+	};
+	// Merge the read cluster (cnds, clstr) outputting it if unique, the containers
+	// and the aggregation hash are cleared afterwards
+	auto  mergeCluster = [&](daoc::AggHash<Id, AccId>& agghash, size_t clsmbs, size_t basembs
+	, Id input, const string& fname) -> bool {
 #if TRACE >= 2
-			fprintf(stderr, "mergeCollections(), specified %lu clusters, %lu nodes\n"
-				, clsnum, ndsnum);
+		++totcls;  // The number of valid read lines, i.e. clusters
 #endif // TRACE
+		// Remove the repeated members before the filtering by size and hashing
+		if(opts.dedupmbs && dupfilter.duplicated(cnds.data(), cnds.size())) {
+			dedupMembers(agghash, clsmbs, basembs);
+			++dupclsnum;
 		}
 
-		// Preallocate space for the clusters hashes
-		if(chashes.bucket_count() * chashes.max_load_factor() < clsnum)
-			chashes.reserve(clsnum);
-		// Preallocate space for nodes
-		if(nosync && nodebase.bucket_count() * nodebase.max_load_factor() < ndsnum)
-			nodebase.reserve(ndsnum);
-		// Note: typically the cluster size does not increase the square root of the number of nodes
-		cnds.reserve(sqrt(ndsnum));
-
-		// Load clusters
+		// Filter read cluster by size
+		if(cnds.empty()) {
+			++cfltnum;
+			// Note: the containers are not empty for the skipped cluster exceeding cmax
+			agghash.clear();
+			clstr.clear();
+			return true;
+		}
+		// Filter by the node base coverage
+		const bool  covered = basembs && basembs >= opts.coverage * clsmbs;
 #if TRACE >= 2
-		size_t  fclsnum = 0;  // The number of read clusters from the file
+		cvfltnum += !covered;
 #endif // TRACE
-		daoc::AggHash<Id, AccId>  agghash;  // Aggregation hash for the cluster nodes (ids)
-		do {
-			char *tok = strtok(line, mbdelim);  // const_cast<char*>(line.data())
+		if(covered && cnds.size() >= cmin && (!cmax || cnds.size() <= cmax)) {
+			// Form the node base if it was not specified explicitly
+			// Note: the intact clusters contain non-base nodes, which should
+			// not extend the node base
+			if(!nosync && !intact)
+				nodebase.insert(cnds.begin(), cnds.end());
+			// Save clstr to the output file if such hash has not been processed yet
+			auto&  chain = chashes[agghash.hash()];
+			// Note: the distinct clusters having the same fingerprint are not distinguished
+			// without the exact verification, so the unverified matches are limited
+			if(!chain.exact && (chain.clusters.size() > opts.chainmax || chain.hits >= opts.chainmax)) {
+				chain.exact = true;
+				++exactnum;
+			}
+			scnds.clear();
+			const auto  icl = std::find_if(chain.clusters.begin(), chain.clusters.end()
+				, [&](const HashedCluster& hcl) {
+					return hcl.fp == agghash && (!chain.exact || sameMembers(hcl.offset));
+				});
+			chain.hits += !chain.exact && icl != chain.clusters.end();
+			if(icl == chain.clusters.end()) {
+				chain.clusters.push_back({agghash, outofs});
+				++uclsnum;
+				if(intact)
+					for(auto nid: cnds)
+						if(!nodebase.count(nid))
+							extnodes.insert(nid);
+#if TRACE >= 2
+				hashedmbs += agghash.size();
+#endif // TRACE
+				clstr.pop_back();  // Remove the ending ' '
+				// Consider the case when ' ' was added after '\n'
+	                    if(clstr.back() != '\n')
+					clstr.push_back('\n');
+				if(fputs(clstr.c_str(), fcls) == EOF) {
+					perror("ERROR mergeCollections(), merged clusters output failed");
+					return false;
+				}
+				if(fdelta) {
+					if(fputs(clstr.c_str(), fdelta) == EOF) {
+						perror("ERROR mergeCollections(), the delta output failed");
+						return false;
+					}
+					dltofs.push_back(outofs);
+				}
+				// Note: the indices are formed from the supported clusters in the support mode
+				if(supmode)
+					csupports.push_back({outofs, 1, input, input});
+				else {
+					if(!opts.index.empty())
+						fpentries.push_back({agghash, outofs, fpentries.size()});
+					if(!opts.postings.empty())
+						pclusters.add(cnds, outofs);
+					if(arrow && !arrow->add(cnds, fname))
+						return false;
+				}
+				outofs += clstr.size();
+			} else {
+				// Account the support of the cluster by the distinct inputs
+				if(supmode) {
+					auto&  csup = *std::lower_bound(csupports.begin(), csupports.end(), icl->offset
+						, [](const ClusterSupport& cs, uint64_t offset) noexcept { return cs.offset < offset; });
+					if(csup.input != input) {
+						++csup.support;
+						csup.input = input;
+					}
+				}
+				// Reference the earlier occurred cluster by its ordinal in the delta
+				if(fdelta) {
+					char  ordstr[24];  // Ordinal of the cluster
+					dltrefs.append(ordstr, sprintf(ordstr, " %lu", size_t(std::lower_bound(
+						dltofs.begin(), dltofs.end(), icl->offset) - dltofs.begin())));
+					++dltrefsnum;
+				}
+				++cfltnum;
+			}
+		} else ++cfltnum;
+		// Prepare outer vars for the next cluster
+		cnds.clear();
+		agghash.clear();  // Clear the hash
+		clstr.clear();  // Clear (but not reallocate) outputting cluster string
+		return true;
+	};
+	// The mapped inputs are parsed by the chunks in parallel, which are scheduled
+	// largest-first with the work stealing across the inputs of the batch and then
+	// merged in the original order
+	//! Cluster (line) of the parsed chunk, which might be continued in the next chunk
+	struct ChunkCluster {
+		size_t  textend;  //!< End of the writing members in the chunk text
+		size_t  idsend;  //!< End of the member nodes in the chunk ids
+		daoc::AggHash<Id, AccId>  agghash;  //!< Aggregation hash of the member nodes
+		size_t  clsmbs;  //!< The number of valid members
+		size_t  basembs;  //!< The number of members present in the node base
+		const char*  cid;  //!< Cluster id if present
+		const char*  cidend;  //!< End of the cluster id
+		size_t  line;  //!< Number of the line of the cluster
+		bool  members;  //!< The cluster has members
+		bool  overflow;  //!< The members exceed cmax, so they are omitted
+	};
+	//! Parsed clusters of the CNL chunk
+	struct ChunkClusters {
+		BufferString  text;  //!< Writing members of the clusters, each is followed by ' '
+		vector<Id>  ids;  //!< Member nodes of the clusters
+		vector<ChunkCluster>  clusters;  //!< Clusters in the order of their lines
+		bool  head;  //!< The first cluster continues the last one of the preceding chunk
+		bool  open;  //!< The last cluster is continued by the next chunk
 
-			// Skip comments
-			if(!tok || tok[0] == '#')
+		ChunkClusters(): text(), ids(), clusters(), head(false), open(false)  {}
+	};
+	//! Chunk of the input to be merged
+	struct InputChunk {
+		CnlChunk  chunk;  //!< Content of the chunk
+		const string*  name;  //!< Name of the input
+		Id  input;  //!< Index of the input
+		bool  first;  //!< The first chunk of the input
+		bool  last;  //!< The last chunk of the input
+		ChunkClusters  res;  //!< Parsed clusters
+	};
+	constexpr size_t  chunkmin = 1 << 20;  // Min size of the chunk to be split in bytes
+	constexpr size_t  chunkmax = 1 << 22;  // Max size of the chunk in bytes
+	constexpr size_t  batchmax = 256;  // Max number of the simultaneously mapped inputs
+	const size_t  batchbytes = workers * 4 * chunkmax;  // Target size of the batch in bytes
+	vector<InputChunk>  bchunks;  // Chunks of the batch
+	vector<std::unique_ptr<MappedFile>>  bcontents;  // Contents of the batch inputs
+	size_t  bbytes = 0;  // Size of the batch in bytes
+	vector<MembersBlock>  wblocks(parallel ? workers : 0);  // Members blocks of the workers
+	// Parse the clusters of the chunk, where the members exceeding cmax are omitted
+	// Note: the node base is not modified until the batch is parsed
+	auto  parseChunk = [&](const CnlChunk& chunk, ChunkClusters& res, MembersBlock& blk, const string& fname) {
+		res.head = !chunk.first && !chunk.comment;
+		res.open = false;
+		const char*  pos = chunk.beg;
+		const char* const  end = chunk.end;
+		bool  first = chunk.first;  // The next token is the first one in the line
+		bool  skip = chunk.comment;  // Skip the remained line
+		bool  lcl = res.head;  // The line has a cluster
+		size_t  line = chunk.line;  // The number of the current line
+		size_t  textbeg = 0;  // Beginning of the cluster in the text
+		size_t  idsbeg = 0;  // Beginning of the cluster in the ids
+		if(lcl)
+			res.clusters.push_back({0, 0, {}, 0, 0, nullptr, nullptr, line, false, false});
+		blk.begin = 0;
+		// Omit the members of the cluster exceeding cmax skipping the remained line
+		auto  omit = [&](ChunkCluster& cl) {
+			res.text.resize(textbeg);
+			res.ids.resize(idsbeg);
+			cl.overflow = true;
+			skip = true;
+		};
+		while(true) {
+			// Skip the delimiters and process the end of line
+			while(pos != end && (*pos == ' ' || *pos == '\t'))
+				++pos;
+			if(pos == end || *pos == '\n') {
+				if(lcl) {
+					auto&  cl = res.clusters.back();
+					if(!blk.ids.empty()) {
+						cl.basembs += filterMembers(blk, res.text, res.ids, cl.agghash);
+						if(cmax && res.ids.size() - idsbeg > cmax)
+							omit(cl);
+					}
+					cl.textend = res.text.size();
+					cl.idsend = res.ids.size();
+					res.open = pos == end && chunk.tail;
+				}
+				if(pos == end)
+					break;
+				++pos;
+				++line;
+				lcl = false;
+				first = true;
+				skip = false;
 				continue;
-			// Skip the cluster id if present
-			if(tok[strlen(tok) - 1] == '>') {
-				const char* cidstr = tok;
-				tok = strtok(nullptr, mbdelim);
-				// Skip empty clusters, which actually should not exist
-				if(!tok) {
-					fprintf(stderr, "WARNING mergeCollections(), empty cluster"
-						" exists: '%s', skipped\n", cidstr);
+			}
+			const char*  tok = pos;
+			while(pos != end && !isMbrDelim(*pos))
+				++pos;
+			if(skip)
+				continue;
+			if(first) {
+				first = false;
+				// Skip comments
+				if(*tok == '#') {
+					skip = true;
+					continue;
+				}
+				lcl = true;
+				textbeg = res.text.size();
+				idsbeg = res.ids.size();
+				blk.begin = textbeg;
+				res.clusters.push_back({textbeg, idsbeg, {}, 0, 0, nullptr, nullptr, line, false, false});
+				// Skip the cluster id if present
+				if(pos[-1] == '>') {
+					res.clusters.back().cid = tok;
+					res.clusters.back().cidend = pos;
 					continue;
 				}
 			}
-			do {
-				// Note: only node id is parsed, share part is skipped if exists,
-				// but potentially can be considered in NMI and F1 evaluation.
-				// In the latter case abs diff of shares instead of co occurrence
-				// counting should be performed.
-				Id  nid = strtoul(tok, nullptr, 10);
+			auto&  cl = res.clusters.back();
+			cl.members = true;
+			// Note: the node id is parsed the same way as by strtoul(), the share
+			// part is skipped if exists
+			const char*  dpos = tok;  // Position of the digits
+			const bool  neg = *dpos == '-';
+			dpos += neg || *dpos == '+';
+			constexpr unsigned long  vmax = numeric_limits<unsigned long>::max();
+			unsigned long  val = 0;
+			bool  digits = false;  // The number has digits
+			for(; dpos != pos && *dpos >= '0' && *dpos <= '9'; ++dpos) {
+				digits = true;
+				const unsigned  dig = *dpos - '0';
+				val = val <= (vmax - dig) / 10 ? val * 10 + dig : vmax;
+			}
+			const Id  nid = digits ? (neg && val != vmax ? -val : val) : 0;
 #if VALIDATE >= 2
-				if(!nid && tok[0] != '0') {
-					fprintf(stderr, "WARNING mergeCollections(), conversion error of '%s' into 0: %s\n"
-						, tok, strerror(errno));
+			if(!nid && *tok != '0') {
+				Diagnostics::global().report(Issue::INVALID_ID, fname, line, tok, pos - tok);
+				continue;
+			}
+#endif // VALIDATE
+			++cl.clsmbs;
+			res.text.append(tok, pos - tok) += ' ';
+			if(nosync) {
+				++cl.basembs;
+				if(cmax && res.ids.size() - idsbeg >= cmax) {
+					omit(cl);
 					continue;
 				}
-#endif // VALIDATE
+				res.ids.push_back(nid);
+				cl.agghash.add(nid);
+			} else {
+				// Filter by the node base in blocks
+				blk.ids.push_back(nid);
+				blk.ends.push_back(res.text.size());
+				if(blk.ids.size() == blockmbs) {
+					cl.basembs += filterMembers(blk, res.text, res.ids, cl.agghash);
+					if(cmax && res.ids.size() - idsbeg > cmax)
+						omit(cl);
+				}
+			}
+		}
+	};
+	//! Merging cluster, which might be continued across the chunks and batches
+	struct MergingCluster {
+		daoc::AggHash<Id, AccId>  agghash;  //!< Aggregation hash of the member nodes
+		size_t  clsmbs;  //!< The number of valid members
+		size_t  basembs;  //!< The number of members present in the node base
+		const char*  cid;  //!< Cluster id if present
+		const char*  cidend;  //!< End of the cluster id
+		size_t  line;  //!< Number of the line of the cluster
+		bool  members;  //!< The cluster has members
+		bool  overflow;  //!< The members exceed cmax
+	} mcl = {{}, 0, 0, nullptr, nullptr, 0, false, false};
+	// Parse the batch in parallel and merge its clusters in the original order
+	auto  runBatch = [&]() -> bool {
+		if(bchunks.empty())
+			return true;
+		vector<size_t>  weights;  // Sizes of the chunks
+		weights.reserve(bchunks.size());
+		for(const auto& ich: bchunks)
+			weights.push_back(ich.chunk.end - ich.chunk.beg);
+		stealingFor(weights, workers, [&](size_t ichunk, unsigned iworker) {
+			auto&  ich = bchunks[ichunk];
+			TraceSpan  span("parse", "chunk", *ich.name);
+			parseChunk(ich.chunk, ich.res, wblocks[iworker], *ich.name);
+		});
 #if TRACE >= 2
-				++totmbs;  // Update the total number of read members
+		fprintf(stderr, "mergeCollections(), the batch of %lu bytes is parsed by %lu chunks\n"
+			, bbytes, bchunks.size());
 #endif // TRACE
-				// Filter by the node base if required
-				if(nosync || nodebase.count(nid)) {
-					cnds.push_back(nid);
-					agghash.add(nid);
-					clstr.append(tok) += ' ';
+		// Merge the clusters continuing them across the chunks
+		for(auto& ich: bchunks) {
+			if(ich.first)
+				beginLevel(ich.input, *ich.name);
+			const ChunkClusters&  res = ich.res;
+			for(size_t i = 0; i < res.clusters.size(); ++i) {
+				const ChunkCluster&  cl = res.clusters[i];
+				const size_t  textbeg = i ? res.clusters[i - 1].textend : 0;
+				const size_t  idsbeg = i ? res.clusters[i - 1].idsend : 0;
+				if(i || !res.head)
+					mcl = {{}, 0, 0, cl.cid, cl.cidend, cl.line, false, false};
+				cnds.insert(cnds.end(), res.ids.begin() + idsbeg, res.ids.begin() + cl.idsend);
+				clstr.append(res.text, textbeg, cl.textend - textbeg);
+				mcl.agghash += cl.agghash;
+				mcl.clsmbs += cl.clsmbs;
+				mcl.basembs += cl.basembs;
+				mcl.members = mcl.members || cl.members;
+				mcl.overflow = mcl.overflow || cl.overflow;
+				if(i + 1 == res.clusters.size() && res.open)
+					continue;
+#if TRACE >= 2
+				totmbs += mcl.clsmbs;
+#endif // TRACE
+				// Skip empty clusters, which actually should not exist
+				if(!mcl.members) {
+					if(mcl.cid)
+						Diagnostics::global().report(Issue::EMPTY_CLUSTER, *ich.name, mcl.line, mcl.cid
+							, mcl.cidend - mcl.cid);
+					cnds.clear();
+					clstr.clear();
+					continue;
+				}
+				// Skip the cluster exceeding cmax
+				if(mcl.overflow || (cmax && cnds.size() > cmax))
+					cnds.clear();
+				if(!mergeCluster(mcl.agghash, mcl.clsmbs, mcl.basembs, ich.input, *ich.name))
+					return false;
+			}
+			// Release the parsed clusters
+			ich.res = ChunkClusters();
+			if(ich.last && !endLevel())
+				return false;
+		}
+		bchunks.clear();
+		bcontents.clear();
+		bbytes = 0;
+		return true;
+	};
+	const bool  processed = forEachInput(files, [&](NamedFileWrapper& file) -> bool {
+			// Note: CNL [CSN] format only is supported
+			size_t  clsnum = 0;  // The number of clusters
+			size_t  ndsnum = 0;  // The number of nodes
+			const Id  input = inpnum++;  // Index of the input
+			if(supmode)
+				inputs.push_back(file.name());
+
+			// Parse header and read the number of clusters if specified
+			const size_t  lnum = parseCnlHeader(file, line, clsnum, ndsnum);  // The number of header lines
+
+			// Estimate the number of nodes and clusters in the file if not specified
+			uint8_t  estimnds = 0;  // Estimation flag
+			if(!ndsnum) {
+				size_t  cmsbytes = -1;
+				cmsbytes = file.size();
+				if(cmsbytes != size_t(-1)) {  // File length fetching failed
+					ndsnum = estimateCnlNodes(cmsbytes, membership);
+					estimnds = 1;
+				} else if(clsnum) {
+					ndsnum = 2 * clsnum; // / membership;  // Note: use optimistic estimate instead of pessimistic (square / membership) to not overuse the memory
+					estimnds = 2;
 				}
-				// Note: the number of nodes can't be evaluated here simply incrementing the value,
-				// because clusters might have overlaps, i.e. the nodes might have multiple membership
-				//
-				// Note: besides the overlaps the collection might represent the
-				// flattened hierarchy, where each nodes has multiple membership
-				// (to each former level) without the actual node sharing, or
-				// this sharing should consider distinct belonging ratio
-				// ~ inversely proportional to the  number of nodes in the cluster
-			} while((tok = strtok(nullptr, mbdelim)));
+			}
+			if(!clsnum && ndsnum) {
+				clsnum = estimateClusters(ndsnum, membership);
 #if TRACE >= 2
-			++fclsnum;  // The number of valid read lines, i.e. clusters
+				fprintf(stderr, "mergeCollections(), %lu nodes (estimated: %u)"
+					", %lu estimated clusters\n", ndsnum, estimnds, clsnum);
 #endif // TRACE
+			} else {
+#if TRACE >= 2
+				fprintf(stderr, "mergeCollections(), specified %lu clusters, %lu nodes\n"
+					, clsnum, ndsnum);
+#endif // TRACE
+			}
+
+			// Preallocate space for the clusters hashes
+			if(chashes.bucket_count() * chashes.max_load_factor() < clsnum)
+				chashes.reserve(clsnum);
+			// Preallocate space for nodes
+			if(nosync)
+				nodebase.reserve(ndsnum);
+			// Note: typically the cluster size does not increase the square root of the number of nodes
+			cnds.reserve(sqrt(ndsnum));
 
-			// Filter read cluster by size
-			if(cnds.empty()) {
+			// Parse the mapped input by the chunks in parallel
+			// Note: the regular files are not released until the processing completion,
+			// so their names are retained
+			if(parallel && MappedFile::mappable(file)) {
+				std::unique_ptr<MappedFile>  content(new MappedFile(file));
+				const size_t  chunksize = std::min(std::max<size_t>(content->size() / (workers * 4)
+					, chunkmin), chunkmax);
+				auto  chunks = splitCnl(content->data(), content->size(), chunksize, false);
+				numberLines(chunks, workers);
+				// Note: the empty input is still a level
+				if(chunks.empty())
+					chunks.push_back({content->data(), content->data(), false, true, false, 1});
+				for(size_t i = 0; i < chunks.size(); ++i) {
+					bchunks.push_back({chunks[i], &file.name(), input, !i, i + 1 == chunks.size()
+						, ChunkClusters()});
+					bbytes += chunks[i].end - chunks[i].beg;
+					if(bbytes >= batchbytes && !runBatch())
+						return false;
+				}
+				if(!bchunks.empty())
+					bcontents.push_back(std::move(content));
+				return bcontents.size() < batchmax || runBatch();
+			}
+			// Merge the preceding inputs to retain their order
+			if(!runBatch())
+				return false;
+			beginLevel(input, file.name());
+
+			// Load clusters
+			daoc::AggHash<Id, AccId>  agghash;  // Aggregation hash for the cluster nodes (ids)
+			MemberReader  mbrs(file, lnum);  // Members of the clusters
+			while(mbrs.nextLine()) {
+				size_t  toklen = 0;  // Length of the token
+				char *tok = mbrs.next(&toklen);
+
+				// Skip comments
+				if(!tok || tok[0] == '#')
+					continue;
+				// Skip the cluster id if present
+				if(tok[toklen - 1] == '>') {
+					const string  cidstr = tok;
+					tok = mbrs.next(&toklen);
+					// Skip empty clusters, which actually should not exist
+					if(!tok) {
+						Diagnostics::global().report(Issue::EMPTY_CLUSTER, file.name(), mbrs.line(), cidstr.c_str());
+						continue;
+					}
+				}
+				size_t  clsmbs = 0;  // The number of valid members in the cluster
+				size_t  basembs = 0;  // The number of cluster members present in the node base
+				bool  giant = false;  // The cluster is giant, so the remained members are processed in parallel
+				mblock.begin = clstr.size();
+				do {
+					// Note: only node id is parsed, share part is skipped if exists,
+					// but potentially can be considered in NMI and F1 evaluation.
+					// In the latter case abs diff of shares instead of co occurrence
+					// counting should be performed.
+					// The string label is interned as a whole.
+					Id  nid = labels ? labels->intern(tok, toklen) : strtoul(tok, nullptr, 10);
 #if VALIDATE >= 2
-				assert(!agghash.size() && clstr.empty()
-					&& "mergeCollections(), asynchronous internal containers");
+					if(!labels && !nid && tok[0] != '0') {
+						Diagnostics::global().report(Issue::INVALID_ID, file.name(), mbrs.line(), tok);
+						continue;
+					}
 #endif // VALIDATE
-				++cfltnum;
-				continue;
-			}
-			if(cnds.size() >= cmin && (!cmax || cnds.size() <= cmax)) {
-				// Form the node base if it was not specified explicitly
-				if(!nosync)
-					nodebase.insert(cnds.begin(), cnds.end());
-				// Save clstr to the output file if such hash has not been processed yet
-				const auto ch = agghash.hash();
-				const auto ich = chashes.find(ch);
-				if(ich == chashes.end()
-				|| std::find(ich->second.begin(), ich->second.end(), agghash) == ich->second.end()) {
-					chashes[ch].push_back(agghash);
 #if TRACE >= 2
-					hashedmbs += agghash.size();
+					++totmbs;  // Update the total number of read members
 #endif // TRACE
-					clstr.pop_back();  // Remove the ending ' '
-					// Consider the case when ' ' was added after '\n'
-                    if(clstr.back() != '\n')
-						clstr.push_back('\n');
-					if(fputs(clstr.c_str(), fout) == EOF) {
-						perror("ERROR mergeCollections(), merged clusters output failed");
-						return false;
+					++clsmbs;
+					if(nosync) {
+						++basembs;
+						// Skip the remained members of the cluster exceeding cmax,
+						// which bounds the memory consumption
+						if(cmax && cnds.size() >= cmax) {
+							cnds.clear();
+							break;
+						}
+						cnds.push_back(nid);
+						agghash.add(nid);
+						clstr.append(tok, toklen) += ' ';
+					} else {
+						// Filter by the node base in blocks
+						clstr.append(tok, toklen) += ' ';
+						mblock.ids.push_back(nid);
+						mblock.ends.push_back(clstr.size());
+						if(mblock.ids.size() == blockmbs) {
+							basembs += filterMembers(mblock, clstr, cnds, agghash);
+							if(cmax && cnds.size() > cmax) {
+								cnds.clear();
+								break;
+							}
+						}
 					}
-				} else ++cfltnum;
-			} else ++cfltnum;
-			// Prepare outer vars for the next iteration
-			cnds.clear();
-			agghash.clear();  // Clear the hash
-			clstr.clear();  // Clear (but not reallocate) outputting cluster string
-		} while(line.readline(file));
+					// Note: the number of nodes can't be evaluated here simply incrementing the value,
+					// because clusters might have overlaps, i.e. the nodes might have multiple membership
+					//
+					// Note: besides the overlaps the collection might represent the
+					// flattened hierarchy, where each nodes has multiple membership
+					// (to each former level) without the actual node sharing, or
+					// this sharing should consider distinct belonging ratio
+					// ~ inversely proportional to the  number of nodes in the cluster
+				} while(!(giant = parallel && clsmbs >= giantmbs) && (tok = mbrs.next(&toklen)));
+				// Filter the remained members of the block
+				if(!mblock.ids.empty()) {
+					basembs += filterMembers(mblock, clstr, cnds, agghash);
+					if(cmax && cnds.size() > cmax) {
+						cnds.clear();
+						giant = false;
+					}
+				}
+				// Process the remained members of the giant cluster by the parts in parallel
+				// Note: the node base is not modified until the cluster is processed
+				for(bool more = giant; more;) {
+					unsigned  nparts = 0;  // The number of fetched parts
+					while(nparts < parts.size() && (more = mbrs.nextMembers(parts[nparts].mbrs, partsize)))
+						++nparts;
+					parallelFor(nparts, workers, [&](size_t ipart, unsigned) {
+						TraceSpan  span("parse", "chunk", file.name());
+						auto&  part = parts[ipart];
+						part.clstr.clear();
+						part.cnds.clear();
+						part.agghash.clear();
+						part.clsmbs = part.basembs = 0;
+						part.mblock.begin = 0;
+						char*  pos = nullptr;  // Tokenizing position
+						for(char* mtok = strtok_r(&part.mbrs[0], " \t", &pos); mtok; mtok = strtok_r(nullptr, " \t", &pos)) {
+							Id  nid = strtoul(mtok, nullptr, 10);
+#if VALIDATE >= 2
+							if(!nid && mtok[0] != '0') {
+								Diagnostics::global().report(Issue::INVALID_ID, file.name(), mbrs.line(), mtok);
+								continue;
+							}
+#endif // VALIDATE
+							++part.clsmbs;
+							if(nosync) {
+								++part.basembs;
+								part.cnds.push_back(nid);
+								part.agghash.add(nid);
+								part.clstr.append(mtok) += ' ';
+							} else {
+								part.clstr.append(mtok) += ' ';
+								part.mblock.ids.push_back(nid);
+								part.mblock.ends.push_back(part.clstr.size());
+								if(part.mblock.ids.size() == blockmbs)
+									part.basembs += filterMembers(part.mblock, part.clstr, part.cnds, part.agghash);
+							}
+						}
+						if(!part.mblock.ids.empty())
+							part.basembs += filterMembers(part.mblock, part.clstr, part.cnds, part.agghash);
+					});
+					// Combine the parts in the original order
+					for(unsigned i = 0; i < nparts; ++i) {
+						const auto&  part = parts[i];
+						cnds.insert(cnds.end(), part.cnds.begin(), part.cnds.end());
+						agghash += part.agghash;
+						clstr += part.clstr;
+						clsmbs += part.clsmbs;
+						basembs += part.basembs;
 #if TRACE >= 2
-		totcls += fclsnum;
+						totmbs += part.clsmbs;
 #endif // TRACE
+					}
+					// Skip the remained members of the cluster exceeding cmax
+					if(cmax && cnds.size() > cmax) {
+						cnds.clear();
+						break;
+					}
+				}
+				if(!mergeCluster(agghash, clsmbs, basembs, input, file.name()))
+					return false;
+			}
+		return endLevel();
+	}) && runBatch();
+	if(!processed) {
+		if(supmode)
+			remove(fstage.name().c_str());
+		return false;
 	}
 
-	// Update the header with the actual number of clusters
-	if(fout.reopen("r+")) {
-		fseek(fout, hdrprefix.size(), SEEK_SET);
-		// Write the actual number of stored clusters
-		if(fprintf(fout, "%lu,", chashes.size()) < 0)
-			perror("WARNING mergeCollections(), failed to update the file header with the number of clusters");
-		// Write the number of unique nodes in the stored clusters
-		fseek(fout, hdrprefix.size() + idvalStub.size() + ndsprefix.size(), SEEK_SET);
-		if(fprintf(fout, "%lu,", nodebase.size()) < 0)
-			perror("WARNING mergeCollections(), failed to update the file header with the number of nodes");
-	} else perror(("WARNING mergeCollections(), can't reopen '" + fout.name()
-		+ "', the stub header has not been replaced").c_str());
+	// Output the clusters supported by the required number of inputs copying
+	// only their lines from the staging file
+	NodeBase  supnodes;  // Unique nodes of the supported clusters on the node base synchronization
+	if(supmode) {
+		TraceSpan  span("output", "emit", fout.name());
+		const uint64_t  stsize = outofs;  // Size of the staging content
+		outofs = hdrsize;
+		size_t  supnum = 0;  // The number of supported clusters
+		string  sline;  // Line of the supported cluster
+		bool  success = !fflush(fstage);
+		for(size_t i = 0; success && i < csupports.size(); ++i) {
+			const auto&  csup = csupports[i];
+			if(csup.support < opts.support)
+				continue;
+			sline.resize((i + 1 < csupports.size() ? csupports[i + 1].offset : stsize) - csup.offset);
+			success = !fseek(fstage, csup.offset, SEEK_SET)
+				&& fread(&sline[0], 1, sline.size(), fstage) == sline.size()
+				&& fwrite(sline.data(), 1, sline.size(), fout) == sline.size();
+			if(!success)
+				break;
+			// Fetch the members for the nodes accounting and indexing
+			// Note: the line is tokenized in place after its output
+			cnds.clear();
+			Fingerprint  fp;  // Fingerprint of the cluster
+			char*  pos = nullptr;  // Tokenizing position
+			for(char* tok = strtok_r(&sline[0], " \t\n", &pos); tok; tok = strtok_r(nullptr, " \t\n", &pos)) {
+				const Id  nid = labels ? labels->intern(tok, strlen(tok)) : strtoul(tok, nullptr, 10);
+				cnds.push_back(nid);
+				fp.add(nid);
+			}
+			if(!nosync)
+				supnodes.insert(cnds.begin(), cnds.end());
+			if(!opts.index.empty())
+				fpentries.push_back({fp, outofs, fpentries.size()});
+			if(!opts.postings.empty())
+				pclusters.add(cnds, outofs);
+			if(arrow && !arrow->add(cnds, inputs[csup.source]))
+				success = false;
+			outofs += sline.size();
+			++supnum;
+		}
+		remove(fstage.name().c_str());
+		if(!success) {
+			perror("ERROR mergeCollections(), the supported clusters output failed");
+			return false;
+		}
+#if TRACE >= 1
+		printf("mergeCollections(), %lu of %lu unique clusters are supported by at least %u inputs\n"
+			, supnum, uclsnum, opts.support);
+#endif // TRACE
+		cfltnum += uclsnum - supnum;
+		uclsnum = supnum;
+	}
+
+#if TRACE >= 1
+	if(exactnum)
+		printf("mergeCollections(), %lu hashes chains exceeding %lu clusters or matches"
+			" are verified by the exact members\n", exactnum, opts.chainmax);
+#endif // TRACE
+
+	// Set the header values to the actual numbers of the stored clusters and their unique nodes
+	outputs.patch(fout, hdrprefix.size(), uclsnum);
+	outputs.patch(fout, hdrprefix.size() + idvalStub.size() + ndsprefix.size()
+		, supmode && !nosync ? supnodes.size() : nodebase.size() + extnodes.size());
+	// Set the delta header values to the actual numbers of levels and stored clusters
+	if(fdelta) {
+		outputs.patch(fdelta, lvsprefix.size(), inpnum);
+		outputs.patch(fdelta, lvsprefix.size() + idvalStub.size() + dclsprefix.size(), uclsnum);
+#if TRACE >= 1
+		printf("mergeCollections(), %u levels are output to %s as %lu new clusters and %lu references\n"
+			, inpnum, opts.delta.c_str(), uclsnum, dltrefsnum);
+#endif // TRACE
+	}
+	// Save the fingerprint index of the merged clusters
+	if(!opts.index.empty()) {
+		if(!FingerprintIndex::save(opts.index, fpentries, &outputs))
+			return false;
+#if TRACE >= 1
+		printf("mergeCollections(), %lu clusters are indexed in %s\n"
+			, fpentries.size(), opts.index.c_str());
+#endif // TRACE
+	}
+	// Finalize the Arrow IPC output of the merged clusters
+	if(arrow) {
+		if(!arrow->close(&outputs))
+			return false;
+#if TRACE >= 1
+		printf("mergeCollections(), %lu clusters are output to %s\n", uclsnum, opts.arrow.c_str());
+#endif // TRACE
+	}
+	// Save the posting index of the merged clusters
+	if(!opts.postings.empty()) {
+		if(!PostingIndex::save(opts.postings, pclusters, &outputs))
+			return false;
+#if TRACE >= 1
+		printf("mergeCollections(), %lu clusters having %lu unique members are indexed"
+			" by the nodes in %s\n", pclusters.offsets.size(), pclusters.members.size()
+			, opts.postings.c_str());
+#endif // TRACE
+	}
+	// Commit all outputs patching their headers
+	if(!outputs.commit(workers))
+		return false;
 #if TRACE >= 2
 	fprintf(stderr, "mergeCollections(),  merged %lu clusters, %lu members into"
-		" %lu clusters, %lu members, %u clusters filtered out. Resulting rations: %G clusters, %G members\n"
-		, totcls, totmbs, chashes.size(), hashedmbs, cfltnum
-		, float(chashes.size()) / totcls, float(hashedmbs) / totmbs);
+		" %lu clusters, %lu members, %u clusters filtered out (%u by the node base coverage)."
+		" Resulting rations: %G clusters, %G members\n"
+		, totcls, totmbs, uclsnum, hashedmbs, cfltnum, cvfltnum
+		, float(uclsnum) / totcls, float(hashedmbs) / totmbs);
 #endif // TRACE
-	printf("%u clusters filtered, remained: %lu\n", cfltnum, chashes.size());
+	if(dupclsnum)
+		printf("%u clusters had the repeated members removed\n", dupclsnum);
+	printf("%u clusters filtered, remained: %lu\n", cfltnum, uclsnum);
 
 	return true;
 }
 
 bool extractBase(NamedFileWrapper& fout, NamedFileWrappers& files, Id cmin, Id cmax
-, float membership)
+, float membership, unsigned threads, bool labels)
 {
 	if(!fout) {
 		fputs("ERROR extractBase(), the output file is undefined\n", stderr);
@@ -354,137 +1426,216 @@ bool extractBase(NamedFileWrapper& fout, NamedFileWrappers& files, Id cmin, Id c
 
 	// Write a stub header the actual values of clusters and nodes will be later,
 	// so now just use stubs (' ' of the sufficient length) for them.
-	string  idvalStub = string(ceil(numeric_limits<Id>::digits10), ' ');
+	const string  idvalStub = OutputGroup::stub();
 	const string  hdrprefix = "# Clusters: 1, Nodes: ";  // Store node base as a single cluster
 	{
-		// Set first digit to zero to have a valid header in case the stub header will not be replaced
-		constexpr char zval[] = "0,";
-		idvalStub.replace(0, sizeof zval - 1, zval);  // Note: -1 to not include the null terminator
 		string  header(hdrprefix + idvalStub  // Note: ',' can be putted later on the place of ' ' after the actual value
 			+ " Fuzzy: 0, Numbered: 0\n");
 		fputs(header.c_str(), fout);
 	}
+	// Form the output in the temporary file to commit it on completion
+	OutputGroup  outputs;  // Outputs of the extraction
+	if(!outputs.stage(fout))
+		return false;
 
-	UniqIds  nodebase;  // Unique node ids
+	// Note: the files are parsed by the chunks in parallel, where each worker
+	// accumulates the nodes in its own set, which are reduced afterwards.
+	// The worker sets are not preallocated, since they grow adaptively to the
+	// density of the ids, so the workers do not multiply the memory of the sparse ids.
+	// The labels are interned by a single worker, which processes the chunks in order.
+	std::unique_ptr<Labels>  lbltab(labels ? new Labels() : nullptr);  // Interned labels if required
+	const unsigned  workers = labels ? 1 : workersNum(threads);
+	vector<NodeBase>  wnodes(workers);  // Nodes of each worker
+	vector<vector<Id>>  wcnds(workers);  // Cluster nodes buffer of each worker
 #if TRACE >= 2
-	AccId  totcls = 0;  // Total number of clusters read from all files
-	AccId  totmbs = 0;  // Total number of members (nodes with repetitions) read from all files
+	atomic<AccId>  totmbs(0);  // Total number of members (nodes with repetitions) read from all files
 #endif // TRACE
-	// ATTENTION: without '\n' delimiter the terminating '\n' is read as an item
-	constexpr char  mbdelim[] = " \t\n";  // Delimiter for the members
-	// Note: strings defined out of the cycle to avoid reallocations
-	StringBuffer  line;  // Reading line
-	vector<Id>  cnds;  // Cluster nodes. Note: a dedicated container is required to filter clusters by size
-	for(auto& file: files) {
-		// Note: CNL [CSN] format only is supported
-		size_t  clsnum = 0;  // The number of clusters
-		size_t  ndsnum = 0;  // The number of nodes
+	StringBuffer  line;  // Reading line of the header
+	const bool  sizefilt = cmin > 1 || cmax;  // Filter the clusters by size
+	size_t  ndsmax = 0;  // Max number of nodes in the file
+	const bool  processed = forEachInput(files, [&](NamedFileWrapper& file) -> bool {
+			// Note: CNL [CSN] format only is supported
+			size_t  clsnum = 0;  // The number of clusters
+			size_t  ndsnum = 0;  // The number of nodes
 
-		// Parse header and read the number of clusters if specified
-		parseCnlHeader(file, line, clsnum, ndsnum);
+			// Parse header and read the number of clusters if specified
+			const size_t  lnum = parseCnlHeader(file, line, clsnum, ndsnum);  // The number of header lines
 
-		// Estimate the number of nodes in the file if not specified
-		if(!ndsnum) {
-			size_t  cmsbytes = file.size();
-			if(cmsbytes != size_t(-1))  // File length fetching failed
-				ndsnum = estimateCnlNodes(cmsbytes, membership);
-			else if(clsnum)
-				ndsnum = 2 * clsnum; // / membership;  // Note: use optimistic estimate instead of pessimistic (square / membership) to not overuse the memory
+			// Estimate the number of nodes in the file if not specified
+			if(!ndsnum) {
+				size_t  cmsbytes = file.size();
+				if(cmsbytes != size_t(-1))  // File length fetching failed
+					ndsnum = estimateCnlNodes(cmsbytes, membership);
+				else if(clsnum)
+					ndsnum = 2 * clsnum; // / membership;  // Note: use optimistic estimate instead of pessimistic (square / membership) to not overuse the memory
 #if TRACE >= 2
-			fprintf(stderr, "extractBase(), estimated %lu nodes\n", ndsnum);
+				fprintf(stderr, "extractBase(), estimated %lu nodes\n", ndsnum);
 #endif // TRACE
-		}
+			}
 #if TRACE >= 2
-		else fprintf(stderr, "extractBase(), specified %lu nodes\n", ndsnum);
+			else fprintf(stderr, "extractBase(), specified %lu nodes\n", ndsnum);
 #endif // TRACE
 
-		// Preallocate space for the nodes, but do it seldom and only if not filtered,
-		// because the filtering might cause much smaller node base than it can be estimated
-		if(nodebase.bucket_count() * nodebase.max_load_factor() < ndsnum / 25)
-			nodebase.reserve(ndsnum);
-		// Note: typically the cluster size does not increase the square root of the number of nodes
-		cnds.reserve(sqrt(ndsnum));
+			if(ndsmax < ndsnum)
+				ndsmax = ndsnum;
 
-		// Load clusters
+			// Stream the non-mappable file (e.g. a pipe or an archive entry) by the first
+			// worker instead of reading it whole into the memory
+			if(!MappedFile::mappable(file)) {
+				TraceSpan  span("parse", "stream", file.name());
 #if TRACE >= 2
-		size_t  fclsnum = 0;  // The number of read clusters from the file
+				totmbs +=
 #endif // TRACE
-		do {
-			char *tok = strtok(line, mbdelim);  // const_cast<char*>(line.data())
-
-			// Skip comments
-			if(!tok || tok[0] == '#')
-				continue;
-			// Skip the cluster id if present
-			if(tok[strlen(tok) - 1] == '>') {
-				const char* cidstr = tok;
-				tok = strtok(nullptr, mbdelim);
-				// Skip empty clusters, which actually should not exist
-				if(!tok) {
-					fprintf(stderr, "WARNING extractBase(), empty cluster"
-						" exists: '%s', skipped\n", cidstr);
-					continue;
-				}
+				loadStreamNodes(file, lnum, wnodes.front(), wcnds.front(), cmin, cmax, lbltab.get());
+				return true;
 			}
-			do {
-				// Note: only node id is parsed, share part is skipped if exists,
-				// but potentially can be considered in NMI and F1 evaluation.
-				// In the latter case abs diff of shares instead of co occurrence
-				// counting should be performed.
-				Id  nid = strtoul(tok, nullptr, 10);
-#if VALIDATE >= 2
-				if(!nid && tok[0] != '0') {
-					fprintf(stderr, "WARNING extractBase(), conversion error of '%s' into 0: %s\n"
-						, tok, strerror(errno));
-					continue;
-				}
-#endif // VALIDATE
+
+			// Note: the mapped content includes the header, which is skipped as a comment
+			const MappedFile  content(file);
+			const size_t  chunksize = std::max<size_t>(content.size() / (workers * 4), 1 << 20);
+			auto  chunks = splitCnl(content.data(), content.size(), chunksize, sizefilt);
+			numberLines(chunks, workers);
+			parallelFor(chunks.size(), workers, [&](size_t ichunk, unsigned iworker) {
+				TraceSpan  span("parse", "chunk", file.name());
 #if TRACE >= 2
-				++totmbs;  // Update the total number of read members
+				totmbs +=
 #endif // TRACE
-				// Filter by the node base if required
-				cnds.push_back(nid);
-			} while((tok = strtok(nullptr, mbdelim)));
+				loadChunkNodes(chunks[ichunk], wnodes[iworker], wcnds[iworker], cmin, cmax, file.name()
+					, lbltab.get());
+			});
 #if TRACE >= 2
-			++fclsnum;  // The number of valid read lines, i.e. clusters
+			fprintf(stderr, "extractBase(), '%s' is parsed by %lu chunks\n", file.name().c_str(), chunks.size());
 #endif // TRACE
+		return true;
+	});
+	if(!processed)
+		return false;
 
-			// Filter read cluster by size and form the nodebase
-			if(cnds.size() >= cmin && (!cmax || cnds.size() <= cmax))
-				nodebase.insert(cnds.begin(), cnds.end());
-			// Prepare outer vars for the next iteration
-			cnds.clear();
-		} while(line.readline(file));
-#if TRACE >= 2
-		totcls += fclsnum;
-#endif // TRACE
+	// Unite the worker nodes preallocating the reduced set only
+	NodeBase  nodebase = std::move(wnodes.front());  // Unique node ids
+	if(wnodes.size() >= 2)
+		nodebase.reserve(ndsmax);
+	for(size_t i = 1; i < wnodes.size(); ++i) {
+		nodebase |= wnodes[i];
+		wnodes[i] = NodeBase();  // Release the memory
 	}
 
-	// Update the header with the actual number of clusters
-	if(fout.reopen("r+")) {
-		fseek(fout, hdrprefix.size(), SEEK_SET);
-		// Write the actual number of stored nodes as a single cluster
-		if(fprintf(fout, "%lu,", nodebase.size()) < 0)
-			perror("WARNING extractBase(), failed to update the file header with the number of nodes");
-	} else perror(("WARNING extractBase(), can't reopen '" + fout.name()
-		+ "', the stub header has not been replaced").c_str());
+	// Set the header value to the actual number of stored nodes as a single cluster
+	outputs.patch(fout, hdrprefix.size(), nodebase.size());
 #if TRACE >= 2
-	fprintf(stderr, "extractBase(),  merged %lu clusters, %lu members into"
+	fprintf(stderr, "extractBase(),  merged %lu members into"
 		" the base of %lu nodes. Members ratio to the nodebase: %G\n"
-		, totcls, totmbs, nodebase.size(), totmbs / float(nodebase.size()));
+		, totmbs.load(), nodebase.size(), totmbs / float(nodebase.size()));
 #endif // TRACE
 
-	// Output the nodebase
+	// Output the nodebase in the ascending order of ids, i.e. in the order of
+	// the first occurrence for the labels
 	errno = 0;
-	if(!fseek(fout, 0, SEEK_END)) {
-		for(auto nid: nodebase)
-			fprintf(fout, "%u ", nid);
-		fputs("\n", fout);
+	{
+		// Note: the ids are formatted manually since fprintf() per id is much slower
+		constexpr size_t  bufsize = 1 << 16;  // Size of the output buffer
+		string  buf;
+		buf.reserve(bufsize + numeric_limits<Id>::digits10 + 2);
+		char  digits[numeric_limits<Id>::digits10 + 1];
+		for(auto nid: nodebase) {
+			if(lbltab)
+				buf.append(lbltab->label(nid), lbltab->labelSize(nid)) += ' ';
+			else {
+				char*  pos = std::end(digits);
+				do *--pos = '0' + nid % 10;
+				while(nid /= 10);
+				buf.append(pos, std::end(digits)) += ' ';
+			}
+			if(buf.size() >= bufsize) {
+				fwrite(buf.data(), 1, buf.size(), fout);
+				buf.clear();
+			}
+		}
+		buf += '\n';
+		fwrite(buf.data(), 1, buf.size(), fout);
 	}
 	if(errno) {
 		perror("ERROR, node base output failed");
 		return false;
 	}
 
-	return true;
+	return outputs.commit(workers);
+}
+
+bool lookupClusters(NamedFileWrapper& fout, NamedFileWrappers& files
+, const FingerprintIndex& index)
+{
+	if(!fout) {
+		fputs("ERROR lookupClusters(), the output file is undefined\n", stderr);
+		return false;
+	}
+
+	string  res;  // Lookup result of the cluster
+	size_t  qnum = 0;  // The number of query clusters
+	size_t  fnum = 0;  // The number of found clusters
+	// Note: the query fingerprints should be formed with the key of the index
+	Fingerprint::key(index.key());
+	const bool  processed = forEachQuery(files, [&](const string& qname, const vector<Id>& nodes) -> bool {
+		Fingerprint  fp;  // Fingerprint of the query cluster
+		for(auto nid: nodes)
+			fp.add(nid);
+		++qnum;
+		res = qname;
+		res += '\t';
+		const auto  ient = index.find(fp);
+		if(ient) {
+			++fnum;
+			res.append(std::to_string(ient->pos)).append("\t")
+				.append(std::to_string(ient->offset)) += '\n';
+		} else res.append("-\n");
+		if(fputs(res.c_str(), fout) == EOF) {
+			perror("ERROR lookupClusters(), the lookup results output failed");
+			return false;
+		}
+		return true;
+	});
+#if TRACE >= 1
+	printf("lookupClusters(), %lu of %lu query clusters are found among %lu indexed clusters\n"
+		, fnum, qnum, index.size());
+#endif // TRACE
+	return processed;
+}
+
+bool matchClusters(NamedFileWrapper& fout, NamedFileWrappers& files
+, const PostingIndex& index, unsigned topk, bool f1)
+{
+	if(!fout) {
+		fputs("ERROR matchClusters(), the output file is undefined\n", stderr);
+		return false;
+	}
+
+	ClusterMatcher  matcher(index, f1);
+	vector<Id>  qnodes;  // Nodes of the query cluster
+	string  res;  // Matches of the query cluster
+	char  score[16];  // Formatted score
+	size_t  qnum = 0;  // The number of query clusters
+	size_t  mnum = 0;  // The number of query clusters having matches
+	const bool  processed = forEachQuery(files, [&](const string& qname, const vector<Id>& nodes) -> bool {
+		qnodes = nodes;
+		const auto  matches = matcher.match(qnodes, topk);
+		++qnum;
+		mnum += !matches.empty();
+		res = qname;
+		for(const auto& mt: matches) {
+			snprintf(score, sizeof score, "%.6g", mt.score);
+			res.append("\t").append(std::to_string(mt.pos)).append(" ")
+				.append(std::to_string(index.offset(mt.pos))).append(" ").append(score);
+		}
+		res += '\n';
+		if(fputs(res.c_str(), fout) == EOF) {
+			perror("ERROR matchClusters(), the matching results output failed");
+			return false;
+		}
+		return true;
+	});
+#if TRACE >= 1
+	printf("matchClusters(), %lu of %lu query clusters are matched with %lu indexed clusters\n"
+		, mnum, qnum, index.clusters());
+#endif // TRACE
+	return processed;
 }
@@ -9,12 +9,27 @@
 //! \date 2017-02-01
 
 #include <cassert>
+#include <cstdlib>  // atexit, getenv
+#include <csignal>  // SIGUSR1
+#include <cstring>  // strncmp
+#include <algorithm>  // none_of
+#include <iterator>  // begin, end
+#include <stdexcept>  // runtime_error
 #include "cmdline.h"  // Arguments parsing
 #include "macrodef.h"
 #include "interface.h"
+#include "tario.hpp"
+#include "cache.h"
+#include "fpindex.h"
+#include "postings.h"
+#include "checker.h"
+#include "shape.h"
+#include "memstat.hpp"
+#include "tracing.hpp"
 
 
 using fs::is_directory;
+using fs::exists;
 
 //! \brief Arguments parser
 struct ArgParser: gengetopt_args_info {
@@ -29,17 +44,100 @@ struct ArgParser: gengetopt_args_info {
 	}
 };
 
+//! \brief Whether the output file can be created, i.e. it does not exist or
+//! 	is rewritten
+//!
+//! \param name const char*  - name of the output file
+//! \param rewrite bool  - whether to rewrite the existing file
+//! \return bool  - the output can be created
+bool outputAllowed(const char* name, bool rewrite)
+{
+	if(rewrite || !exists(name))
+		return true;
+	fprintf(stderr, "ERROR, the output file '%s' already exists, use --rewrite to rewrite it\n"
+		, name);
+	return false;
+}
+
+//! \brief Options affecting the processing results, which are used as a cache key
+//!
+//! \param args_info gengetopt_args_info&  - parsed arguments
+//! \return string  - options affecting the results, one per line
+string resultOptions(gengetopt_args_info& args_info)
+{
+	string  opts = "version=" CMDLINE_PARSER_VERSION "\n";
+	FileWrapper  fopts(tmpfile());
+	if(!fopts || cmdline_parser_dump(fopts, &args_info))
+		throw std::runtime_error("resultOptions(), the options can't be dumped");
+	rewind(fopts);
+	// Note: the output, node base, cache and threads options are omitted since do not
+	// affect the results, the node base is considered by the content
+	constexpr const char*  omitted[] = {"output", "rewrite", "sync-base", "cache", "mem-stats"
+		, "trace-out", "threads"};
+	StringBuffer  line;
+	while(line.readline(fopts)) {
+		const char*  opt = line;
+		if(std::none_of(std::begin(omitted), std::end(omitted), [opt](const char* pref) noexcept {
+			return !strncmp(opt, pref, strlen(pref));
+		}))
+			opts += opt;
+	}
+	return opts;
+}
+
 
 int main(int argc, char **argv)
 {
 	ArgParser  args_info(argc, argv);
 
+	// Report the memory consumption per subsystem on request and on completion if required
+#ifdef __unix__
+	MemStats::reportOn(SIGUSR1);
+#endif // __unix__
+	if(args_info.mem_stats_flag)
+		atexit([] { MemStats::global().report(); });
+	// Record the timeline of the processing stages to be saved on completion
+	if(args_info.trace_out_given) {
+		Tracer::global().start(args_info.trace_out_arg);
+		atexit([] { Tracer::global().save(); });
+	}
+
 	if(!args_info.inputs_num) {
 		fputs("ERROR, input clusterings are required\n", stderr);
 		cmdline_parser_print_help();
 		return 1;
 	}
 
+	// The labels are interned only by the merging and node base extraction
+	if(args_info.labels_flag && (args_info.check_flag || args_info.annotate_flag
+	|| args_info.info_flag || args_info.lookup_given || args_info.match_given
+	|| args_info.profile_shape_flag || args_info.generate_flag || args_info.index_given
+	|| args_info.postings_given || args_info.arrow_given)) {
+		fputs("ERROR, the string labels are supported only by the merging and node base"
+			" extraction without the indices and the Arrow output\n", stderr);
+		return 1;
+	}
+
+	// Validate, annotate or inspect the input clusterings without the merging
+	if(args_info.check_flag || args_info.annotate_flag || args_info.info_flag) {
+		if(args_info.threads_arg < 0) {
+			fputs("ERROR, the number of threads should be non-negative\n", stderr);
+			return 1;
+		}
+		FileNames  names(args_info.inputs, args_info.inputs + args_info.inputs_num);
+		auto files = openFiles(names);
+		if(files.empty())
+			return 1;
+		return args_info.check_flag ? !checkCollections(files, args_info.threads_arg)
+			: args_info.annotate_flag ? !annotateCollections(files, args_info.threads_arg)
+			: !inspectCollections(files, args_info.threads_arg);
+	}
+
+	// Query the indexed collection instead of the merging
+	const bool  query = args_info.lookup_given || args_info.match_given;
+	// Profile the inputs or generate the clusterings by the profile
+	const bool  shape = args_info.profile_shape_flag || args_info.generate_flag;
+
 	// Get output file name
 	string  outpname = args_info.output_arg;  // Default output name
 	{
@@ -47,23 +145,94 @@ int main(int argc, char **argv)
 		// Remove trailing '/', '\\'
 		while(name.size() && name.back() == PATHSEP)
 			name.pop_back();
-		// Update default output filename in case single dir is specified
+		// Output extension of the default file name
+		const char*  outext = args_info.extract_base_flag ? "_base.cnl"
+			: args_info.lookup_given ? ".lkp" : args_info.match_given ? ".mch"
+			: args_info.profile_shape_flag ? ".shp" : args_info.generate_flag ? "" : ".cnl";
+		// Update default output filename in case single dir or archive is specified
 		if(!args_info.output_given && args_info.inputs_num == 1) {
+			const size_t  arext = TarReader::archiveExt(name);  // Archive extension
 			if(is_directory(name)
 			// Note: "../." like templates are not verified and result in the output to the ..cnl file
 			&& name != "." && name != "..")
-				outpname = name + (args_info.extract_base_flag ? "_base.cnl" : ".cnl");
+				outpname = name + outext;
+			else if(arext)
+				outpname = name.substr(0, name.size() - arext) + outext;
 			else if(args_info.extract_base_flag) {
 				auto isep = name.find_last_of("./\\");
 				if(isep != string::npos && name[isep] == '.')
 					name.insert(isep, "_base");
 				else name += "_base.cnl";
 				outpname = name;
+			} else if(query || shape) {
+				auto isep = name.find_last_of("./\\");
+				if(isep != string::npos && name[isep] == '.')
+					name.erase(isep);
+				outpname = name + outext;
 			}
+		} else if(!args_info.output_given && (query || shape))
+			outpname = string(args_info.lookup_given ? "lookup" : args_info.match_given ? "match"
+				: args_info.profile_shape_flag ? "shape" : "synthetic") + outext;
+	}
+	printf("Arguments parsed:\n\tmode: %s\n\toutput: %s\n", args_info.extract_base_flag ? "extract"
+		: args_info.lookup_given ? "lookup" : args_info.match_given ? "match"
+		: args_info.profile_shape_flag ? "profile" : args_info.generate_flag ? "generate"
+		: "merge [& sync]" , outpname.c_str());
+
+	// Generate the synthetic clusterings into the output directory by the shape profile
+	if(args_info.generate_flag) {
+		if(args_info.inputs_num != 1) {
+			fputs("ERROR, a single shape profile is expected\n", stderr);
+			return 1;
 		}
+		NamedFileWrapper  fprofile(args_info.inputs[0], "r");
+		if(!fprofile) {
+			perror((string("ERROR, the shape profile can't be opened: ") + args_info.inputs[0]).c_str());
+			return 1;
+		}
+		const bool  success = generateCorpus(fprofile, outpname, args_info.seed_arg
+			, args_info.rewrite_flag);
+		if(success)
+			printf("The synthetic clusterings are generated into %s\n", outpname.c_str());
+		else fputs("WARNING, the generation failed\n", stderr);
+		return !success;
+	}
+
+	// Validate the arguments before the output file is created, since the
+	// existing output is truncated on the creation
+	if(args_info.min_base_coverage_arg < 0 || args_info.min_base_coverage_arg > 1) {
+		fputs("ERROR, the min node base coverage should be in the range [0, 1]\n", stderr);
+		return 1;
+	}
+	if(args_info.threads_arg < 0) {
+		fputs("ERROR, the number of threads should be non-negative\n", stderr);
+		return 1;
+	}
+	if(args_info.min_support_arg < 1) {
+		fputs("ERROR, the min support should be positive\n", stderr);
+		return 1;
+	}
+	if(args_info.match_given && args_info.top_matches_arg < 1) {
+		fputs("ERROR, the number of top matches should be positive\n", stderr);
+		return 1;
 	}
-	printf("Arguments parsed:\n\tmode: %s\n\toutput: %s\n"
-		, args_info.extract_base_flag ? "extract" : "merge [& sync]" , outpname.c_str());
+	if(args_info.cache_limit_arg < 0) {
+		fputs("ERROR, the cache limit should be non-negative\n", stderr);
+		return 1;
+	}
+	if(args_info.delta_given && args_info.min_support_arg > 1) {
+		fputs("ERROR, the delta output is not applicable with the min support > 1\n", stderr);
+		return 1;
+	}
+	// Note: the additional outputs are created later, so their rewriting is validated here
+	if(args_info.delta_given && !outputAllowed(args_info.delta_arg, args_info.rewrite_flag))
+		return 1;
+	if(args_info.index_given && !outputAllowed(args_info.index_arg, args_info.rewrite_flag))
+		return 1;
+	if(args_info.postings_given && !outputAllowed(args_info.postings_arg, args_info.rewrite_flag))
+		return 1;
+	if(args_info.arrow_given && !outputAllowed(args_info.arrow_arg, args_info.rewrite_flag))
+		return 1;
 
 	// Create the output file checking it's existence
 	NamedFileWrapper fout = createFile(outpname, args_info.rewrite_flag);
@@ -94,15 +263,103 @@ int main(int argc, char **argv)
 	if(files.empty())
 		return 1;
 
+	// Lookup the query clusters in the indexed collection
+	if(args_info.lookup_given) {
+		NamedFileWrapper  findex(args_info.lookup_arg, "rb");
+		if(!findex) {
+			perror((string("ERROR, the fingerprint index can't be opened: ") + args_info.lookup_arg).c_str());
+			return 1;
+		}
+		const FingerprintIndex  index(findex);
+		if(!index)
+			return 1;
+		const bool  success = lookupClusters(fout, files, index);
+		Diagnostics::global().summary();
+		if(success)
+			printf("%lu query CNL files are looked up into %s\n", files.size(), outpname.c_str());
+		else fputs("WARNING, the lookup failed\n", stderr);
+		return !success;
+	}
+	// Match the query clusters with the indexed collection
+	if(args_info.match_given) {
+		NamedFileWrapper  findex(args_info.match_arg, "rb");
+		if(!findex) {
+			perror((string("ERROR, the posting index can't be opened: ") + args_info.match_arg).c_str());
+			return 1;
+		}
+		const PostingIndex  index(findex);
+		if(!index)
+			return 1;
+		const bool  success = matchClusters(fout, files, index, args_info.top_matches_arg
+			, args_info.f1_flag);
+		Diagnostics::global().summary();
+		if(success)
+			printf("%lu query CNL files are matched into %s\n", files.size(), outpname.c_str());
+		else fputs("WARNING, the matching failed\n", stderr);
+		return !success;
+	}
+
+	// Profile the shape of the input clusterings
+	if(args_info.profile_shape_flag) {
+		const bool  success = profileShape(fout, files);
+		Diagnostics::global().summary();
+		if(success)
+			printf("%lu CNL files are profiled into %s\n", files.size(), outpname.c_str());
+		else fputs("WARNING, the profiling failed\n", stderr);
+		return !success;
+	}
+
+	// Fetch the results from the cache if possible
+	// Note: only the resulting collection is cached, so the caching is omitted
+	// if the indices, the Arrow or the delta output are required
+	ResultCache  cache(args_info.cache_given && !args_info.index_given && !args_info.postings_given
+		&& !args_info.arrow_given && !args_info.delta_given ? args_info.cache_arg : nullptr
+		, size_t(args_info.cache_limit_arg) << 20, args_info.cache_content_flag);
+	if(cache) {
+		cache.bind(resultOptions(args_info), files, fbase);
+		if(cache.fetch(fout)) {
+			printf("The results are fetched from the cache into %s\n", outpname.c_str());
+			return 0;
+		}
+	}
+
 	bool success = false;
-	if(!args_info.extract_base_flag)
-		success = mergeCollections(fout, files, fbase, args_info.btm_size_arg
-			, args_info.top_size_arg, args_info.membership_arg);
-	else success = extractBase(fout, files, args_info.btm_size_arg
-			, args_info.top_size_arg, args_info.membership_arg);
-	if(success)
+	if(!args_info.extract_base_flag) {
+		MergeOptions  opts;
+		opts.cmin = args_info.btm_size_arg;
+		opts.cmax = args_info.top_size_arg;
+		opts.membership = args_info.membership_arg;
+		opts.netbase = args_info.net_base_flag || (fbase && isNetworkFile(fbase.name()));
+		opts.threads = args_info.threads_arg;
+		opts.coverage = args_info.min_base_coverage_arg;
+		opts.intact = args_info.intact_flag;
+		opts.support = args_info.min_support_arg;
+		opts.labels = args_info.labels_flag;
+		opts.dedupmbs = args_info.dedup_members_flag;
+		if(args_info.index_given)
+			opts.index = args_info.index_arg;
+		if(args_info.postings_given)
+			opts.postings = args_info.postings_arg;
+		if(args_info.arrow_given) {
+			opts.arrow = args_info.arrow_arg;
+			opts.arrowmeta = args_info.arrow_meta_flag;
+		}
+		if(args_info.delta_given)
+			opts.delta = args_info.delta_arg;
+		// Note: the hashes chain limit is lowered only to test the exact verification
+		if(const char* chainmax = getenv("RESMERGE_CHAINMAX"))
+			opts.chainmax = strtoul(chainmax, nullptr, 10);
+		success = mergeCollections(fout, files, fbase, opts);
+	} else success = extractBase(fout, files, args_info.btm_size_arg
+			, args_info.top_size_arg, args_info.membership_arg, args_info.threads_arg
+			, args_info.labels_flag);
+	// Report the input data issues encountered during the processing
+	Diagnostics::global().summary();
+	if(success) {
 		printf("%lu CNL files processed into %s\n", files.size(), outpname.c_str());
-	else fputs("WARNING, CNL files processing failed\n", stderr);
+		if(cache)
+			cache.store(fout);
+	} else fputs("WARNING, CNL files processing failed\n", stderr);
 
     return !success;  // Return 0 on success
 }
@@ -0,0 +1,209 @@
+//! \brief Posting lists (node -> clusters) index of the merged clusters
+//! 	for the best matches search
+//!
+//! \license Apache License, Version 2.0: http://www.apache.org/licenses/LICENSE-2.0.html
+//! > 	Simple explanation: https://tldrlegal.com/license/apache-license-2.0-(apache-2.0)
+//!
+//! Copyright (c)
+//! \authr Artem Lutov
+//! \email luart@ya.ru
+//! \date 2026-10-18
+
+#include <cstring>  // memcmp
+#include <algorithm>  // sort, unique, nth_element, binary_search
+#include <numeric>  // partial_sum
+#include <functional>  // greater
+
+#ifdef __unix__
+#include <sys/mman.h>  // madvise
+#endif // __unix__
+
+#include "postings.h"
+
+
+using std::sort;
+
+constexpr char  PostingIndex::signature[];
+constexpr uint32_t  PostingIndex::version;
+
+// Index Types definitions -----------------------------------------------------
+void PostingIndex::Clusters::add(const vector<Id>& nodes, uint64_t offset)
+{
+	const size_t  ibeg = members.size();
+	members.insert(members.end(), nodes.begin(), nodes.end());
+	sort(members.begin() + ibeg, members.end());
+	members.erase(std::unique(members.begin() + ibeg, members.end()), members.end());
+	bounds.push_back(members.size());
+	offsets.push_back(offset);
+}
+
+PostingIndex::PostingIndex(NamedFileWrapper& file)
+: m_file(file), m_clsofs(nullptr), m_bounds(nullptr), m_clsizes(nullptr), m_posts(nullptr)
+, m_nodesnum(0), m_clsnum(0)
+{
+	Header  hdr;
+	if(m_file.size() < sizeof hdr) {
+		fprintf(stderr, "ERROR PostingIndex(), '%s' is not a posting index\n"
+			, file.name().c_str());
+		return;
+	}
+	memcpy(&hdr, m_file.data(), sizeof hdr);
+	if(memcmp(hdr.magic, signature, sizeof signature) || hdr.version != version
+	|| hdr.idsize != sizeof(Id)) {
+		fprintf(stderr, "ERROR PostingIndex(), '%s' is not a posting index"
+			" of the version %u\n", file.name().c_str(), version);
+		return;
+	}
+	if(m_file.size() != sizeof hdr + (hdr.clsnum + hdr.nodesnum + 1) * sizeof(uint64_t)
+	+ (hdr.clsnum + hdr.postsnum) * sizeof(Id)) {
+		fprintf(stderr, "ERROR PostingIndex(), '%s' is truncated or corrupted\n"
+			, file.name().c_str());
+		return;
+	}
+#ifdef __unix__
+	// Note: only the postings of the query nodes are accessed
+	if(m_file.mapped())
+		madvise(const_cast<char*>(m_file.data()), m_file.size(), MADV_RANDOM);
+#endif // __unix__
+	// Note: the header size is a multiple of the arrays alignment and the content
+	// is either page aligned when mapped or aligned by the allocator
+	m_clsofs = reinterpret_cast<const uint64_t*>(m_file.data() + sizeof hdr);
+	m_bounds = m_clsofs + hdr.clsnum;
+	m_clsizes = reinterpret_cast<const Id*>(m_bounds + hdr.nodesnum + 1);
+	m_posts = m_clsizes + hdr.clsnum;
+	m_nodesnum = hdr.nodesnum;
+	m_clsnum = hdr.clsnum;
+}
+
+bool PostingIndex::save(const string& name, const Clusters& clusters, daoc::OutputGroup* group)
+{
+	TraceSpan  span("output", "flush", name);
+	const size_t  clsnum = clusters.offsets.size();
+	if(clsnum > numeric_limits<Id>::max()) {
+		fprintf(stderr, "ERROR PostingIndex::save(), the number of clusters %lu exceeds"
+			" the range of ids\n", clsnum);
+		return false;
+	}
+	const auto&  members = clusters.members;
+	const size_t  nodesnum = members.empty() ? 0
+		: size_t(*std::max_element(members.begin(), members.end())) + 1;
+
+	// Form the postings of the nodes in the ascending order of the clusters
+	vector<uint64_t>  bounds(nodesnum + 1, 0);
+	for(auto nid: members)
+		++bounds[nid + 1];
+	std::partial_sum(bounds.begin(), bounds.end(), bounds.begin());
+	vector<Id>  posts(members.size());
+	{
+		vector<uint64_t>  ipost(bounds.begin(), bounds.end() - 1);  // Index of the next posting of each node
+		for(size_t i = 0; i < clsnum; ++i)
+			for(size_t j = clusters.bounds[i]; j < clusters.bounds[i + 1]; ++j)
+				posts[ipost[members[j]]++] = i;
+	}
+	vector<Id>  clsizes(clsnum);
+	for(size_t i = 0; i < clsnum; ++i)
+		clsizes[i] = clusters.bounds[i + 1] - clusters.bounds[i];
+
+	Header  hdr;
+	memset(&hdr, 0, sizeof hdr);
+	memcpy(hdr.magic, signature, sizeof signature);
+	hdr.version = version;
+	hdr.idsize = sizeof(Id);
+	hdr.nodesnum = nodesnum;
+	hdr.clsnum = clsnum;
+	hdr.postsnum = posts.size();
+	const string  tmpname = daoc::OutputGroup::tmpName(name);
+	bool  saved = false;
+	{
+		FileWrapper  fidx(fopen(tmpname.c_str(), "wb"));
+		saved = fidx && fwrite(&hdr, sizeof hdr, 1, fidx) == 1
+			&& fwrite(clusters.offsets.data(), sizeof(uint64_t), clsnum, fidx) == clsnum
+			&& fwrite(bounds.data(), sizeof(uint64_t), bounds.size(), fidx) == bounds.size()
+			&& fwrite(clsizes.data(), sizeof(Id), clsnum, fidx) == clsnum
+			&& fwrite(posts.data(), sizeof(Id), posts.size(), fidx) == posts.size()
+			&& !fflush(fidx);
+	}
+	// Note: the grouped index is renamed on the commit of the group
+	if(saved && group)
+		group->add(tmpname, name);
+	else saved = saved && !rename(tmpname.c_str(), name.c_str());
+	if(!saved) {
+		perror(("ERROR PostingIndex::save(), the index can't be saved to " + name).c_str());
+		remove(tmpname.c_str());
+	}
+	return saved;
+}
+
+ClusterMatcher::ClusterMatcher(const PostingIndex& index, bool f1)
+: m_index(index), m_f1(f1), m_inters(index.clusters(), 0), m_cands(), m_scores()
+{}
+
+auto ClusterMatcher::match(vector<Id>& nodes, unsigned topk) -> Matches
+{
+	Matches  matches;
+	sort(nodes.begin(), nodes.end());
+	nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+	const size_t  qsize = nodes.size();
+	if(!qsize || !topk)
+		return matches;
+	// Process the shortest postings first to fix the top candidates early
+	sort(nodes.begin(), nodes.end(), [this](Id a, Id b) noexcept {
+		return m_index.end(a) - m_index.begin(a) < m_index.end(b) - m_index.begin(b);
+	});
+
+	bool  admit = true;  // Admit new candidates
+	for(size_t i = 0; i < qsize; ++i) {
+		const Id* const  pbeg = m_index.begin(nodes[i]);
+		const Id* const  pend = m_index.end(nodes[i]);
+		const size_t  plen = pend - pbeg;
+		const Id  rem = qsize - i;  // The number of remained query nodes including the current one
+		// Refine the threshold only before the postings longer than the candidates list,
+		// which bounds the overhead by the postings
+		if(m_cands.size() >= topk && plen > m_cands.size()) {
+			// Note: the current scores are the lower bounds of the final scores
+			m_scores.clear();
+			for(auto cpos: m_cands)
+				m_scores.push_back(score(m_inters[cpos], qsize, m_index.size(cpos)));
+			std::nth_element(m_scores.begin(), m_scores.begin() + topk - 1, m_scores.end()
+				, std::greater<float>());
+			const float  theta = m_scores[topk - 1];  // Min score of the top candidates
+			// The unseen clusters have at most rem shared nodes
+			if(score(rem, qsize, rem) < theta)
+				admit = false;
+			if(!admit) {
+				// Discard the candidates, which can't reach the top
+				size_t  icand = 0;
+				for(auto cpos: m_cands) {
+					const Id  csize = m_index.size(cpos);
+					if(score(std::min<Id>(m_inters[cpos] + rem, csize), qsize, csize) < theta)
+						m_inters[cpos] = 0;
+					else m_cands[icand++] = cpos;
+				}
+				m_cands.resize(icand);
+			}
+		}
+		if(admit) {
+			for(auto ip = pbeg; ip != pend; ++ip)
+				if(!m_inters[*ip]++)
+					m_cands.push_back(*ip);
+		} else if(plen <= m_cands.size()) {
+			for(auto ip = pbeg; ip != pend; ++ip)
+				if(m_inters[*ip])
+					++m_inters[*ip];
+		} else for(auto cpos: m_cands)
+			m_inters[cpos] += std::binary_search(pbeg, pend, cpos);
+	}
+
+	matches.reserve(m_cands.size());
+	for(auto cpos: m_cands) {
+		matches.push_back({cpos, m_inters[cpos], score(m_inters[cpos], qsize, m_index.size(cpos))});
+		m_inters[cpos] = 0;
+	}
+	m_cands.clear();
+	const auto  imend = matches.begin() + std::min<size_t>(topk, matches.size());
+	std::partial_sort(matches.begin(), imend, matches.end(), [](const Match& a, const Match& b) noexcept {
+		return a.score > b.score || (!(a.score < b.score) && a.pos < b.pos);
+	});
+	matches.erase(imend, matches.end());
+	return matches;
+}
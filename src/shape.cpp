@@ -0,0 +1,468 @@
+//! \brief Workload shape profiling of the CNL files and generation of the
+//! 	look-alike synthetic clusterings by the profile
+//!
+//! \license Apache License, Version 2.0: http://www.apache.org/licenses/LICENSE-2.0.html
+//! > 	Simple explanation: https://tldrlegal.com/license/apache-license-2.0-(apache-2.0)
+//!
+//! Copyright (c)
+//! \authr Artem Lutov
+//! \email luart@ya.ru
+//! \date 2026-10-18
+
+#include <cstring>  // memchr, strncasecmp
+#include <algorithm>  // min, max, sort, shuffle
+#include <limits>
+#include <random>  // mt19937_64, uniform_int_distribution
+#include <unordered_set>
+
+#include "shape.h"
+#include "fpindex.h"
+
+
+using std::numeric_limits;
+using std::to_string;
+using std::unordered_set;
+
+// Internal types --------------------------------------------------------------
+//! \brief Cluster sizes of the log2 bin, i.e. sizes in [2^bin, 2^(bin+1))
+struct SizeBin {
+	size_t  clusters;  //!< The number of clusters
+	size_t  members;  //!< The number of members of the clusters
+};
+
+//! \brief Shape of the level (input clustering)
+struct LevelShape {
+	size_t  clusters;  //!< The number of non-empty clusters
+	size_t  members;  //!< The number of members
+	size_t  nodes;  //!< The number of unique nodes
+	Id  idmin;  //!< Min node id
+	Id  idmax;  //!< Max node id
+	size_t  dups;  //!< The number of clusters present in the preceding levels
+	// Line format
+	bool  header;  //!< The header with the numbers of clusters and nodes is present
+	bool  tabs;  //!< The members are delimited by the tabs rather than spaces
+	bool  crlf;  //!< The lines are ended by "\r\n"
+	bool  numbered;  //!< The clusters have ids
+	bool  shares;  //!< The members have shares
+	bool  sorted;  //!< The members are ordered by the ids
+	vector<SizeBin>  bins;  //!< Cluster sizes by log2 bins
+
+	LevelShape() noexcept: clusters(0), members(0), nodes(0), idmin(numeric_limits<Id>::max())
+	, idmax(0), dups(0), header(false), tabs(false), crlf(false), numbered(false), shares(false)
+	, sorted(false), bins()  {}
+};
+
+//! \brief Shape of the corpus (collection of clusterings)
+struct CorpusShape {
+	Id  idmin;  //!< Min node id
+	Id  idmax;  //!< Max node id
+	size_t  nodes;  //!< The number of unique nodes
+	vector<LevelShape>  levels;  //!< Shapes of the levels
+
+	CorpusShape() noexcept: idmin(numeric_limits<Id>::max()), idmax(0), nodes(0), levels()  {}
+};
+
+// Internal functions ----------------------------------------------------------
+//! \brief Profile the CNL content as a level of the corpus
+//!
+//! \param name const string&  - name of the file for the diagnostics
+//! \param data const char*  - the content
+//! \param size size_t  - the number of bytes in the content
+//! \param level LevelShape&  - resulting shape of the level
+//! \param lnodes NodeBase&  - nodes of the level, which should be empty
+//! \param seen const unordered_set<size_t>&  - fingerprints of the clusters
+//! 	of the preceding levels
+//! \param fps vector<size_t>&  - fingerprints of the level clusters
+//! \return void
+static void profileLevel(const string& name, const char* data, size_t size
+	, LevelShape& level, NodeBase& lnodes, const unordered_set<size_t>& seen
+	, vector<size_t>& fps)
+{
+	constexpr char  clsmark[] = "clusters";
+	constexpr size_t  clsmarklen = sizeof clsmark - 1;
+	size_t  lines = 0;  // The number of lines
+	size_t  crlfs = 0;  // The number of lines ended by "\r\n"
+	size_t  tabs = 0;  // The number of tab delimiters of the members
+	size_t  spaces = 0;  // The number of space delimiters of the members
+	size_t  numbered = 0;  // The number of numbered clusters
+	size_t  shares = 0;  // The number of members having shares
+	size_t  sorted = 0;  // The number of clusters having ordered members
+	const char* const  eof = data + size;
+	for(const char* lbeg = data; lbeg < eof; ) {
+		const char*  lend = static_cast<const char*>(memchr(lbeg, '\n', eof - lbeg));
+		if(!lend)
+			lend = eof;
+		const char* const  next = lend != eof ? lend + 1 : eof;
+		++lines;
+		if(lend != lbeg && lend[-1] == '\r') {
+			--lend;
+			++crlfs;
+		}
+		const char*  pos = lbeg;
+		while(pos != lend && (*pos == ' ' || *pos == '\t'))
+			++pos;
+		lbeg = next;
+		if(pos == lend)
+			continue;
+		// The header is a comment preceding the clusters and specifying their number
+		if(*pos == '#') {
+			if(!level.clusters && !level.header)
+				for(const char* tok = pos; size_t(lend - tok) >= clsmarklen; ++tok)
+					if(!strncasecmp(tok, clsmark, clsmarklen)) {
+						level.header = true;
+						break;
+					}
+			continue;
+		}
+
+		Fingerprint  fp;  // Fingerprint of the cluster
+		size_t  csize = 0;  // Size of the cluster
+		bool  ordered = true;  // The members are ordered
+		Id  prev = 0;  // Previous member
+		for(bool first = true; pos != lend; first = false) {
+			const char*  tend = pos;
+			while(tend != lend && *tend != ' ' && *tend != '\t')
+				++tend;
+			// Skip the cluster id
+			if(first && tend[-1] == '>')
+				++numbered;
+			else {
+				// Note: the share part is skipped if exists
+				Id  nid = 0;
+				const char*  dig = pos;
+				for(; dig != tend && *dig >= '0' && *dig <= '9'; ++dig)
+					nid = nid * 10 + (*dig - '0');
+				if(dig == pos || (dig != tend && *dig != ':'))
+					Diagnostics::global().report(Issue::INVALID_ID, name, lines, pos, tend - pos);
+				else {
+					shares += dig != tend;
+					ordered = ordered && prev <= nid;
+					prev = nid;
+					fp.add(nid);
+					++csize;
+					lnodes.insert(nid);
+					level.idmin = std::min(level.idmin, nid);
+					level.idmax = std::max(level.idmax, nid);
+				}
+			}
+			pos = tend;
+			for(; pos != lend && (*pos == ' ' || *pos == '\t'); ++pos)
+				++(*pos == '\t' ? tabs : spaces);
+		}
+		if(!csize)
+			continue;
+		++level.clusters;
+		level.members += csize;
+		sorted += ordered;
+		const unsigned  ibin = 63 - __builtin_clzll(csize);
+		if(level.bins.size() <= ibin)
+			level.bins.resize(ibin + 1, {0, 0});
+		++level.bins[ibin].clusters;
+		level.bins[ibin].members += csize;
+		fps.push_back(fp.hash());
+		level.dups += seen.count(fps.back());
+	}
+	level.nodes = lnodes.size();
+	// The format is defined by the majority
+	level.tabs = tabs > spaces;
+	level.crlf = crlfs * 2 > lines;
+	level.numbered = numbered * 2 > level.clusters;
+	level.shares = shares * 2 > level.members;
+	level.sorted = sorted * 2 > level.clusters;
+}
+
+//! \brief Save the corpus shape
+//!
+//! \param fout FILE*  - output file
+//! \param shape const CorpusShape&  - the shape to be saved
+//! \return bool  - the shape is saved successfully
+static bool saveShape(FILE* fout, const CorpusShape& shape)
+{
+	fputs("# Shape profile of the clusterings (anonymized), the cluster sizes of the log2 bin b"
+		" are in [2^b, 2^(b+1)), members are the total size of the bin clusters\n"
+		"# Corpus: levels <num>, ids <min>..<max>, nodes <unique>\n"
+		"# Level <i>: clusters <num>, members <num>, nodes <unique>, ids <min>..<max>"
+		", duplicates <clusters of the preceding levels>\n"
+		"# Format <i>: header <0|1>, tabs <0|1>, crlf <0|1>, numbered <0|1>, shares <0|1>"
+		", sorted <0|1>\n"
+		"# Sizes <i>: [<bin>:<clusters>:<members>]...\n", fout);
+	fprintf(fout, "Corpus: levels %lu, ids %u..%u, nodes %lu\n", shape.levels.size()
+		, shape.nodes ? shape.idmin : 0, shape.idmax, shape.nodes);
+	for(size_t i = 0; i < shape.levels.size(); ++i) {
+		const LevelShape&  level = shape.levels[i];
+		fprintf(fout, "Level %lu: clusters %lu, members %lu, nodes %lu, ids %u..%u, duplicates %lu\n"
+			, i, level.clusters, level.members, level.nodes, level.nodes ? level.idmin : 0
+			, level.idmax, level.dups);
+		fprintf(fout, "Format %lu: header %d, tabs %d, crlf %d, numbered %d, shares %d, sorted %d\n"
+			, i, level.header, level.tabs, level.crlf, level.numbered, level.shares, level.sorted);
+		fprintf(fout, "Sizes %lu:", i);
+		for(size_t ib = 0; ib < level.bins.size(); ++ib)
+			if(level.bins[ib].clusters)
+				fprintf(fout, " %lu:%lu:%lu", ib, level.bins[ib].clusters, level.bins[ib].members);
+		fputc('\n', fout);
+	}
+	return !fflush(fout) && !ferror(fout);
+}
+
+//! \brief Load the corpus shape
+//!
+//! \param fin NamedFileWrapper&  - input file of the shape profile
+//! \param shape CorpusShape&  - the loaded shape
+//! \return bool  - the shape is loaded and valid
+static bool loadShape(NamedFileWrapper& fin, CorpusShape& shape)
+{
+	StringBuffer  line;
+	size_t  levnum = 0;  // The number of levels
+	size_t  ilev = 0;  // Index of the loaded level
+	size_t  lnum = 0;  // The number of lines
+	auto  invalid = [&fin, &lnum](const char* issue) -> bool {
+		fprintf(stderr, "ERROR loadShape(), %s at %s:%lu\n", issue, fin.name().c_str(), lnum);
+		return false;
+	};
+	while(line.readline(fin)) {
+		++lnum;
+		if(line.empty() || line[0] == '#')
+			continue;
+		char*  text = line;
+		int  header = 0, tabs = 0, crlf = 0, numbered = 0, shares = 0, sorted = 0;
+		if(!strncmp(text, "Corpus:", 7)) {
+			if(sscanf(text, "Corpus: levels %lu, ids %u..%u, nodes %lu", &levnum, &shape.idmin
+			, &shape.idmax, &shape.nodes) != 4)
+				return invalid("invalid corpus");
+			shape.levels.resize(levnum);
+		} else if(!strncmp(text, "Level ", 6)) {
+			LevelShape*  level = ilev < levnum ? &shape.levels[ilev] : nullptr;
+			if(!level || sscanf(text, "Level %lu: clusters %lu, members %lu, nodes %lu, ids %u..%u"
+			", duplicates %lu", &ilev, &level->clusters, &level->members, &level->nodes
+			, &level->idmin, &level->idmax, &level->dups) != 7 || &shape.levels[ilev] != level)
+				return invalid("invalid or unordered level");
+		} else if(!strncmp(text, "Format ", 7)) {
+			if(ilev >= levnum || sscanf(text, "Format %*u: header %d, tabs %d, crlf %d, numbered %d"
+			", shares %d, sorted %d", &header, &tabs, &crlf, &numbered, &shares, &sorted) != 6)
+				return invalid("invalid format");
+			LevelShape&  level = shape.levels[ilev];
+			level.header = header;
+			level.tabs = tabs;
+			level.crlf = crlf;
+			level.numbered = numbered;
+			level.shares = shares;
+			level.sorted = sorted;
+		} else if(!strncmp(text, "Sizes ", 6)) {
+			if(ilev >= levnum || !(text = strchr(text, ':')))
+				return invalid("invalid sizes");
+			LevelShape&  level = shape.levels[ilev];
+			size_t  clsnum = 0;  // The number of clusters in the bins
+			size_t  mbsnum = 0;  // The number of members in the bins
+			for(char* tok = strtok(text + 1, " \t\r\n"); tok; tok = strtok(nullptr, " \t\r\n")) {
+				unsigned  ib = 0;
+				SizeBin  bin = {0, 0};
+				if(sscanf(tok, "%u:%lu:%lu", &ib, &bin.clusters, &bin.members) != 3 || ib >= 32
+				|| bin.members < bin.clusters << ib || bin.members > ((bin.clusters << ib) << 1) - bin.clusters)
+					return invalid("invalid size bin");
+				if(level.bins.size() <= ib)
+					level.bins.resize(ib + 1, {0, 0});
+				level.bins[ib] = bin;
+				clsnum += bin.clusters;
+				mbsnum += bin.members;
+			}
+			if(clsnum != level.clusters || mbsnum != level.members)
+				return invalid("the sizes mismatch the level");
+			++ilev;
+		} else return invalid("unknown record");
+	}
+	if(!levnum || ilev != levnum)
+		return invalid("incomplete levels");
+	if(shape.idmin > shape.idmax || shape.nodes > size_t(shape.idmax) - shape.idmin + 1)
+		return invalid("the nodes exceed the id range");
+	for(const auto& level: shape.levels)
+		if(level.nodes > shape.nodes || level.nodes > level.members || (level.members && !level.nodes))
+			return invalid("the level nodes mismatch the corpus nodes or members");
+	return true;
+}
+
+// Shape functions definitions -------------------------------------------------
+bool profileShape(NamedFileWrapper& fout, NamedFileWrappers& files)
+{
+	CorpusShape  shape;
+	NodeBase  nodes;  // Nodes of the corpus
+	NodeBase  lnodes;  // Nodes of the level
+	unordered_set<size_t>  seen;  // Fingerprints of the clusters of the preceding levels
+	vector<size_t>  fps;  // Fingerprints of the level clusters
+	const bool  processed = forEachInput(files, [&](NamedFileWrapper& file) -> bool {
+		// Note: the mapped content includes the header, which is identified as a comment
+		const MappedFile  content(file);
+		shape.levels.emplace_back();
+		LevelShape&  level = shape.levels.back();
+		lnodes.clear();
+		fps.clear();
+		profileLevel(file.name(), content.data(), content.size(), level, lnodes, seen, fps);
+		seen.insert(fps.begin(), fps.end());
+		nodes |= lnodes;
+		if(level.nodes) {
+			shape.idmin = std::min(shape.idmin, level.idmin);
+			shape.idmax = std::max(shape.idmax, level.idmax);
+		}
+		printf("%s: level %lu, %lu clusters, %lu members, %lu nodes, %lu duplicates\n"
+			, file.name().c_str(), shape.levels.size() - 1, level.clusters, level.members
+			, level.nodes, level.dups);
+		return true;
+	});
+	shape.nodes = nodes.size();
+	if(!processed || !saveShape(fout, shape)) {
+		perror(("ERROR profileShape(), the profile can't be saved to " + fout.name()).c_str());
+		return false;
+	}
+	return true;
+}
+
+bool generateCorpus(NamedFileWrapper& fprofile, const string& outdir, uint64_t seed
+	, bool rewrite)
+{
+	CorpusShape  shape;
+	if(!loadShape(fprofile, shape))
+		return false;
+	std::mt19937_64  rnd(seed);
+	using Uniform = std::uniform_int_distribution<size_t>;
+
+	// Spread the node ids uniformly over the range, a random id per stride
+	vector<Id>  pool;  // Node ids of the corpus in the ascending order
+	pool.reserve(shape.nodes);
+	{
+		const double  stride = (double(shape.idmax) - shape.idmin + 1) / std::max<size_t>(shape.nodes, 1);
+		std::uniform_real_distribution<double>  offset(0, stride);
+		for(size_t i = 0; i < shape.nodes; ++i) {
+			AccId  nid = shape.idmin + AccId(i * stride + offset(rnd));
+			// Retain the ids unique and leave the room for the remained ones
+			if(!pool.empty())
+				nid = std::max<AccId>(nid, pool.back() + 1);
+			pool.push_back(std::min<AccId>(nid, AccId(shape.idmax) - (shape.nodes - 1 - i)));
+		}
+	}
+
+	const unsigned  width = to_string(shape.levels.size() - 1).size();  // Width of the level index
+	vector<Id>  lnodes;  // Nodes of the level in a random order
+	vector<Id>  mbs;  // Members of the level clusters
+	vector<size_t>  cbegs;  // Beginnings of the level clusters in mbs, followed by the end
+	vector<Id>  pmbs;  // Members of the preceding level clusters
+	vector<size_t>  pcbegs;  // Beginnings of the preceding level clusters
+	vector<Id>  sizes;  // Cluster sizes of the level
+	vector<vector<size_t>>  pbins;  // Indices of the preceding level clusters by the size bins
+	NodeBase  nodes;  // Unique nodes of the level
+	string  ln;  // Output line
+	for(size_t il = 0; il < shape.levels.size(); ++il) {
+		TraceSpan  span("generate", "level");
+		const LevelShape&  level = shape.levels[il];
+		// Draw the nodes of the level from its id range
+		lnodes.assign(std::lower_bound(pool.begin(), pool.end(), level.idmin)
+			, std::upper_bound(pool.begin(), pool.end(), level.idmax));
+		if(lnodes.empty())
+			lnodes = pool;
+		const size_t  ndsnum = std::min(level.nodes, lnodes.size());  // The number of level nodes
+		for(size_t i = 0; i < ndsnum; ++i)
+			std::swap(lnodes[i], lnodes[Uniform(i, lnodes.size() - 1)(rnd)]);
+		lnodes.resize(ndsnum);
+		// Draw the cluster sizes around the mean size of each bin adjusting them
+		// to the number of members of the bin
+		sizes.clear();
+		for(size_t ib = 0; ib < level.bins.size(); ++ib) {
+			const SizeBin&  bin = level.bins[ib];
+			if(!bin.clusters)
+				continue;
+			const size_t  lo = size_t(1) << ib;
+			const size_t  hi = (lo << 1) - 1;
+			const size_t  mean = bin.members / bin.clusters;
+			Uniform  size(std::max(lo, 2 * mean > hi ? 2 * mean - hi : lo), std::min(hi, 2 * mean - lo));
+			const size_t  ibeg = sizes.size();  // Index of the first cluster of the bin
+			size_t  mbsnum = 0;  // The number of members of the bin clusters
+			for(size_t i = 0; i < bin.clusters; ++i) {
+				sizes.push_back(size(rnd));
+				mbsnum += sizes.back();
+			}
+			Uniform  icl(ibeg, sizes.size() - 1);
+			while(mbsnum != bin.members) {
+				Id&  sz = sizes[icl(rnd)];
+				if(mbsnum < bin.members && sz < hi) {
+					++sz;
+					++mbsnum;
+				} else if(mbsnum > bin.members && sz > lo) {
+					--sz;
+					--mbsnum;
+				}
+			}
+		}
+		// Note: the members of a cluster are unique, so its size is bounded by the level nodes
+		for(auto& sz: sizes)
+			sz = std::min<size_t>(sz, ndsnum);
+		std::shuffle(sizes.begin(), sizes.end(), rnd);
+		// Form the clusters taking the members from the nodes cyclically,
+		// where the duplicates are selected from the preceding level clusters
+		// of the same size bin
+		pbins.clear();
+		for(size_t ip = 0; ip + 1 < pcbegs.size(); ++ip) {
+			const unsigned  ib = 63 - __builtin_clzll(pcbegs[ip + 1] - pcbegs[ip]);
+			if(pbins.size() <= ib)
+				pbins.resize(ib + 1);
+			pbins[ib].push_back(ip);
+		}
+		mbs.clear();
+		cbegs.clear();
+		size_t  dups = level.dups;  // The number of remained duplicates
+		size_t  inode = 0;  // Index of the next node
+		for(size_t ic = 0; ic < sizes.size(); ++ic) {
+			cbegs.push_back(mbs.size());
+			const unsigned  ib = 63 - __builtin_clzll(sizes[ic]);
+			if(dups && ib < pbins.size() && !pbins[ib].empty()
+			&& Uniform(0, sizes.size() - ic - 1)(rnd) < dups) {
+				const size_t  ip = pbins[ib][Uniform(0, pbins[ib].size() - 1)(rnd)];
+				mbs.insert(mbs.end(), pmbs.begin() + pcbegs[ip], pmbs.begin() + pcbegs[ip + 1]);
+				--dups;
+				continue;
+			}
+			for(Id i = 0; i < sizes[ic]; ++i) {
+				mbs.push_back(lnodes[inode]);
+				if(++inode == lnodes.size())
+					inode = 0;
+			}
+			if(level.sorted)
+				std::sort(mbs.begin() + cbegs.back(), mbs.end());
+		}
+		cbegs.push_back(mbs.size());
+		nodes.clear();
+		nodes.insert(mbs.begin(), mbs.end());
+
+		// Output the clusters in the profiled format
+		string  name = to_string(il);
+		name = outdir + PATHSEP + "level" + string(width - name.size(), '0') + name + ".cnl";
+		NamedFileWrapper  fout = createFile(name, rewrite);
+		if(!fout)
+			return false;
+		const char* const  eol = level.crlf ? "\r\n" : "\n";
+		const char  delim = level.tabs ? '\t' : ' ';
+		char  share[16] = "";  // Share of the members
+		if(level.shares)
+			snprintf(share, sizeof share, ":%.4g", double(level.nodes) / std::max<size_t>(level.members, 1));
+		if(level.header)
+			fprintf(fout, "# Clusters: %lu, Nodes: %lu%s", cbegs.size() - 1, nodes.size(), eol);
+		for(size_t ic = 0; ic + 1 < cbegs.size(); ++ic) {
+			ln.clear();
+			if(level.numbered)
+				ln.append(to_string(ic)).append(">").push_back(delim);
+			for(size_t i = cbegs[ic]; i < cbegs[ic + 1]; ++i) {
+				if(i != cbegs[ic])
+					ln.push_back(delim);
+				ln.append(to_string(mbs[i])).append(share);
+			}
+			ln.append(eol);
+			fputs(ln.c_str(), fout);
+		}
+		if(fflush(fout) || ferror(fout)) {
+			perror(("ERROR generateCorpus(), the clusters can't be written to " + name).c_str());
+			return false;
+		}
+		printf("%s: %lu clusters, %lu members, %lu nodes\n", name.c_str(), cbegs.size() - 1
+			, mbs.size(), nodes.size());
+		pmbs.swap(mbs);
+		pcbegs.swap(cbegs);
+	}
+	return true;
+}
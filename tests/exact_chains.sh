@@ -0,0 +1,61 @@
+#!/bin/sh
+# Test the exact verification of the clusters in the hashes chains, which is
+# forced for all chains by lowering the chain limit to 0 via RESMERGE_CHAINMAX.
+#
+# Usage: tests/exact_chains.sh [<resmerge>]
+
+APP=${1:-bin/Release/resmerge}
+TMP=`mktemp -d`
+trap 'rm -rf "$TMP"' EXIT
+FAILS=0
+
+# Report the test failure
+# $1  - the test name
+# $2  - the failure description
+fail() {
+	echo  "FAILED $1: $2"
+	FAILS=$((FAILS + 1))
+}
+
+# Merge the inputs validating the resulting clusters and the exact verification
+# $1  - the test name
+# $2  - the expected clusters
+# $3  - whether the exact verification is expected (1) or not (0)
+# $4..  - the options and inputs
+merge() {
+	NAME=$1
+	EXP=$2
+	VERIF=$3
+	shift 3
+	if ! "$APP" -o "$TMP/$NAME.cnl" "$@" > "$TMP/$NAME.log" 2>&1; then
+		fail $NAME "the run is failed"
+		return
+	fi
+	[ "`tail -n +2 "$TMP/$NAME.cnl"`" = "$EXP" ] || fail $NAME "the clusters differ from the expected ones"
+	VERIFIED=`grep -c 'verified by the exact members' "$TMP/$NAME.log"`
+	[ $VERIFIED -eq $VERIF ] || fail $NAME "the exact verification is `[ $VERIF -eq 1 ] || printf 'not '`expected"
+}
+
+# The distinct clusters 1 5 6 and 2 3 7 have the same size, sum and sum of squares,
+# the cluster 1 2 is repeated with the permuted members
+printf "1 2\n1 5 6\n4 8\n" > "$TMP/l0.cnl"
+printf "2 1\n2 3 7\n4 8 9\n" > "$TMP/l1.cnl"
+printf "1 2\n7 3 2\n" > "$TMP/l2.cnl"
+EXP=`printf "1 2\n1 5 6\n4 8\n2 3 7\n4 8 9"`
+merge plain "$EXP" 0 "$TMP/l0.cnl" "$TMP/l1.cnl" "$TMP/l2.cnl"
+RESMERGE_CHAINMAX=0 merge forced "$EXP" 1 "$TMP/l0.cnl" "$TMP/l1.cnl" "$TMP/l2.cnl"
+RESMERGE_CHAINMAX=0 merge labels "$EXP" 1 -L "$TMP/l0.cnl" "$TMP/l1.cnl" "$TMP/l2.cnl"
+RESMERGE_CHAINMAX=0 merge support "`printf "1 2\n2 3 7"`" 1 -u 2 "$TMP/l0.cnl" "$TMP/l1.cnl" "$TMP/l2.cnl"
+
+# The cluster repeated in more inputs than the default chain limit
+for i in 0 1 2 3 4 5 6 7 8 9; do
+	printf "3 1 2\n" > "$TMP/r$i.cnl"
+done
+merge repeated "3 1 2" 1 "$TMP"/r*.cnl
+
+if [ $FAILS -eq 0 ]; then
+	echo  "The exact chains tests are passed"
+else
+	echo  "The exact chains tests are FAILED: $FAILS"
+	exit 1
+fi
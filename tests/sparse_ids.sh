@@ -0,0 +1,59 @@
+#!/bin/sh
+# Test the processing of the sparse node ids (max id >> the number of nodes),
+# which should not allocate the memory proportional to the max id.
+#
+# Usage: tests/sparse_ids.sh [<resmerge>]
+
+APP=${1:-bin/Release/resmerge}
+NBMAX=67108864  # Max peak bytes of the node base, 64 MB
+TMP=`mktemp -d`
+trap 'rm -rf "$TMP"' EXIT
+FAILS=0
+
+# Report the test failure
+# $1  - the test name
+# $2  - the failure description
+fail() {
+	echo  "FAILED $1: $2"
+	FAILS=$((FAILS + 1))
+}
+
+# Peak bytes of the node base from the memory stats
+# $1  - the log of the run
+nbpeak() {
+	awk '$1 == "node" && $2 == "base" { print $4 }' "$1"
+}
+
+# Form the collections of the sparse ids: a single cluster of the max id,
+# and 100K clusters of 5 pseudo-random ids up to 2^32 - 1
+echo "4294967295 4000000000" > "$TMP/s0.cnl"
+# Note: the multiplier is small enough to evaluate the ids exactly by awk
+awk 'BEGIN { x = 1; for(i = 0; i < 100000; ++i) {
+	for(j = 0; j < 5; ++j) { x = (x * 69069 + 1) % 4294967296; printf(j ? " %.0f" : "%.0f", x) }
+	print "" } }' > "$TMP/s1.cnl"
+# The expected node base
+tr ' ' '\n' < "$TMP/s1.cnl" | cat - "$TMP/s0.cnl" | tr ' ' '\n' | sort -n -u > "$TMP/nodes.exp"
+
+# Extraction of the node base by the parallel workers
+if ! "$APP" -g -j 8 -e -o "$TMP/base.cnl" "$TMP/s0.cnl" "$TMP/s1.cnl" > "$TMP/extract.log" 2>&1; then
+	fail extract "the run is failed"
+else
+	tail -n +2 "$TMP/base.cnl" | tr ' ' '\n' | sed '/^$/d' > "$TMP/nodes.res"
+	cmp -s "$TMP/nodes.exp" "$TMP/nodes.res" || fail extract "the node base differs from the expected one"
+	[ `nbpeak "$TMP/extract.log"` -le $NBMAX ] || fail extract "the node base takes `nbpeak "$TMP/extract.log"` bytes"
+fi
+
+# Synchronization with the sparse node base
+if ! "$APP" -g -s "$TMP/s0.cnl" -o "$TMP/sync.cnl" "$TMP/s1.cnl" "$TMP/s0.cnl" > "$TMP/sync.log" 2>&1; then
+	fail sync "the run is failed"
+else
+	[ "`tail -n +2 "$TMP/sync.cnl"`" = "4294967295 4000000000" ] || fail sync "the clusters differ from the expected ones"
+	[ `nbpeak "$TMP/sync.log"` -le $NBMAX ] || fail sync "the node base takes `nbpeak "$TMP/sync.log"` bytes"
+fi
+
+if [ $FAILS -eq 0 ]; then
+	echo  "The sparse ids tests are passed"
+else
+	echo  "The sparse ids tests are FAILED: $FAILS"
+	exit 1
+fi